@@ -2,9 +2,11 @@
 #define AIRPORTSECTOR_H
 
 #include "Graph.h"
-#include "HashTable.h"
+#include "ShortestPathTreeCache.h"
+#include "HashMap.h"
+#include "SectorRegistry.h"
 #include "LinkedList.h"
-#include "Queue.h"
+#include "RingBuffer.h"
 #include "Utils.h"
 #include <iostream>
 using namespace std;
@@ -17,13 +19,13 @@ extern PopulationSystem* populationSystem;
 struct Airport {
     char code[10];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     int terminals;
     
     Airport() {
         code[0] = '\0';
         name[0] = '\0';
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
         terminals = 1;
     }
 };
@@ -53,8 +55,9 @@ struct Flight {
 class AirportSystem {
 private:
     Graph* airportGraph;
-    HashTable* airportTable;
-    HashTable* flightTable;
+    ShortestPathTreeCache* routeCache;      // recent route sources, dropped on any network change
+    HashMap<StringView, Airport>* airportTable;
+    HashMap<StringView, Flight>* flightTable;
     
     int airportCount;
     int flightCount;
@@ -63,8 +66,9 @@ private:
 public:
     AirportSystem() {
         airportGraph = new Graph(50);
-        airportTable = new HashTable(30);
-        flightTable = new HashTable(100);
+        routeCache = new ShortestPathTreeCache(airportGraph);
+        airportTable = new HashMap<StringView, Airport>(30);
+        flightTable = new HashMap<StringView, Flight>(100);
         airportCount = 0;
         flightCount = 0;
         routeEdgeCount = 0;
@@ -72,13 +76,13 @@ public:
     
     // 1. Register airport
     void registerAirport(const char* code, const char* name, const char* sector, int terminals) {
-        Airport* airport = new Airport();
-        stringCopyN(airport->code, code, 10);
-        stringCopyN(airport->name, name, 100);
-        stringCopyN(airport->sector, sector, 50);
-        airport->terminals = terminals;
+        Airport airport;
+        stringCopyN(airport.code, code, 10);
+        stringCopyN(airport.name, name, 100);
+        airport.sectorId = internSector(sector);
+        airport.terminals = terminals;
         
-        airportTable->insert(code, airport);
+        airportTable->insert(code, std::move(airport));
         airportGraph->addVertex(code, 0, 0);
         airportCount++;
         
@@ -113,40 +117,34 @@ public:
     void displayAllAirports() {
         cout << "\n========== ALL AIRPORTS ==========" << endl;
         
-        char** keys = new char*[100];
-        int count;
-        airportTable->getAllKeys(keys, &count);
+        int count = airportTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No airports registered yet." << endl;
-            delete[] keys;
             return;
         }
         
-        for (int i = 0; i < count; i++) {
-            Airport* airport = (Airport*)airportTable->search(keys[i]);
-            if (airport != nullptr) {
-                cout << airport->code << " - " << airport->name << " [" << airport->sector << "]" << endl;
-            }
+        for (auto& entry : *airportTable) {
+            Airport* airport = &entry.value;
+            cout << airport->code << " - " << airport->name << " [" << sectorName(airport->sectorId) << "]" << endl;
         }
         
-        delete[] keys;
         cout << "===================================" << endl;
     }
     
     // 3. Add flight
     void addFlight(const char* flightNo, const char* airline, const char* departure, 
                    const char* arrival, const char* depTime, const char* arrTime) {
-        Flight* flight = new Flight();
-        stringCopyN(flight->flightNo, flightNo, 20);
-        stringCopyN(flight->airline, airline, 100);
-        stringCopyN(flight->departureAirport, departure, 10);
-        stringCopyN(flight->arrivalAirport, arrival, 10);
-        stringCopyN(flight->currentLocation, departure, 10);
-        stringCopyN(flight->departureTime, depTime, 20);
-        stringCopyN(flight->arrivalTime, arrTime, 20);
-        
-        flightTable->insert(flightNo, flight);
+        Flight flight;
+        stringCopyN(flight.flightNo, flightNo, 20);
+        stringCopyN(flight.airline, airline, 100);
+        stringCopyN(flight.departureAirport, departure, 10);
+        stringCopyN(flight.arrivalAirport, arrival, 10);
+        stringCopyN(flight.currentLocation, departure, 10);
+        stringCopyN(flight.departureTime, depTime, 20);
+        stringCopyN(flight.arrivalTime, arrTime, 20);
+        
+        flightTable->insert(flightNo, std::move(flight));
         flightCount++;
         
         cout << "Added flight: " << flightNo << " (" << airline << ")" << endl;
@@ -195,27 +193,21 @@ public:
     void displayAllFlights() {
         cout << "\n========== ALL FLIGHTS ==========" << endl;
         
-        char** keys = new char*[200];
-        int count;
-        flightTable->getAllKeys(keys, &count);
+        int count = flightTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No flights registered yet." << endl;
-            delete[] keys;
             return;
         }
         
         cout << "Total Flights: " << count << endl << endl;
-        for (int i = 0; i < count; i++) {
-            Flight* flight = (Flight*)flightTable->search(keys[i]);
-            if (flight != nullptr) {
-                cout << flight->flightNo << " - " << flight->airline << endl;
-                cout << "  " << flight->departureAirport << " → " << flight->arrivalAirport;
-                cout << " (" << flight->departureTime << " - " << flight->arrivalTime << ")" << endl;
-            }
+        for (auto& entry : *flightTable) {
+            Flight* flight = &entry.value;
+            cout << flight->flightNo << " - " << flight->airline << endl;
+            cout << "  " << flight->departureAirport << " → " << flight->arrivalAirport;
+            cout << " (" << flight->departureTime << " - " << flight->arrivalTime << ")" << endl;
         }
         
-        delete[] keys;
         cout << "=================================" << endl;
     }
     
@@ -227,7 +219,7 @@ public:
         cin >> flightNo;
         normalizeInput(flightNo);
         
-        Flight* flight = (Flight*)flightTable->search(flightNo);
+        Flight* flight = flightTable->search(flightNo);
         if (flight == nullptr) {
             cout << "\n[ERROR] Flight " << flightNo << " not found!" << endl;
             return;
@@ -249,7 +241,7 @@ public:
         cin >> flightNo;
         normalizeInput(flightNo);
         
-        Flight* flight = (Flight*)flightTable->search(flightNo);
+        Flight* flight = flightTable->search(flightNo);
         if (flight == nullptr) {
             cout << "\n[ERROR] Flight not found!" << endl;
             return;
@@ -278,7 +270,7 @@ public:
         cin >> flightNo;
         normalizeInput(flightNo);
         
-        Flight* flight = (Flight*)flightTable->search(flightNo);
+        Flight* flight = flightTable->search(flightNo);
         if (flight == nullptr) {
             cout << "\n[ERROR] Flight not found!" << endl;
             return;
@@ -298,30 +290,19 @@ public:
         cout << "Enter your sector: ";
         cin >> userSector;
         normalizeInput(userSector);
-        
-        char** keys = new char*[100];
-        int count;
-        airportTable->getAllKeys(keys, &count);
+        SectorId userSectorId = findSector(userSector);   // resolved once, loop compares ints
         
         bool found = false;
         cout << "\n--- Airports in Your Sector ---" << endl;
         
-        for (int i = 0; i < count; i++) {
-            Airport* airport = (Airport*)airportTable->search(keys[i]);
-            if (airport != nullptr) {
-                char airportSector[50];
-                stringCopy(airportSector, airport->sector);
-                normalizeInput(airportSector);
-                
-                if (stringCompare(airportSector, userSector) == 0) {
-                    cout << "  - " << airport->name << " (" << airport->code << ")" << endl;
-                    found = true;
-                }
+        for (auto& entry : *airportTable) {
+            Airport* airport = &entry.value;
+            if (userSectorId != NO_SECTOR && airport->sectorId == userSectorId) {
+                cout << "  - " << airport->name << " (" << airport->code << ")" << endl;
+                found = true;
             }
         }
         
-        delete[] keys;
-        
         if (!found) {
             cout << "[INFO] No airports found in your sector." << endl;
         }
@@ -372,59 +353,23 @@ public:
             return;
         }
         
-        int vertexCount = airportGraph->getVertexCount();
-        double* distances = new double[vertexCount];
-        int* previous = new int[vertexCount];
-        
-        airportGraph->dijkstra(from, distances, previous);
-        
-        int destIndex = -1;
-        for (int i = 0; i < vertexCount; i++) {
-            char vertexName[50];
-            stringCopy(vertexName, airportGraph->getVertexName(i));
-            toUpperCase(vertexName);
-            
-            char toUpper[50];
-            stringCopy(toUpper, to);
-            toUpperCase(toUpper);
-            
-            if (stringCompare(vertexName, toUpper) == 0) {
-                destIndex = i;
-                break;
-            }
-        }
+        const int* path = nullptr;
+        int pathLength = 0;
+        double distance = routeCache->route(airportGraph->indexOf(from), airportGraph->indexOf(to), path, pathLength);
         
-        if (destIndex == -1 || distances[destIndex] >= GRAPH_MAX_DISTANCE) {
+        if (distance >= GRAPH_MAX_DISTANCE) {
             cout << "\n[ERROR] No path exists between these airports!" << endl;
-            delete[] distances;
-            delete[] previous;
             return;
         }
         
-        cout << "\nShortest distance: " << distances[destIndex] << " km" << endl;
+        cout << "\nShortest distance: " << distance << " km" << endl;
         cout << "Path: ";
         
-        int pathSize = 0;
-        char** path = new char*[vertexCount];
-        int current = destIndex;
-        
-        while (current != -1) {
-            path[pathSize] = new char[50];
-            stringCopy(path[pathSize], airportGraph->getVertexName(current));
-            pathSize++;
-            current = previous[current];
-        }
-        
-        for (int i = pathSize - 1; i >= 0; i--) {
-            cout << path[i];
-            if (i > 0) cout << " → ";
-            delete[] path[i];
+        for (int i = 0; i < pathLength; i++) {
+            cout << airportGraph->getVertexName(path[i]);
+            if (i < pathLength - 1) cout << " → ";
         }
         cout << endl;
-        
-        delete[] path;
-        delete[] distances;
-        delete[] previous;
     }
     
     // 11. Display route network summary
@@ -432,7 +377,9 @@ public:
         cout << "\n========== AIRPORT NETWORK SUMMARY ==========" << endl;
         cout << "Total Airports: " << airportCount << endl;
         cout << "Total Connections: " << routeEdgeCount << endl;
-        cout << "Total Flights: " << flightCount << endl << endl;
+        cout << "Total Flights: " << flightCount << endl;
+        airportGraph->displayComponents();
+        cout << endl;
         
         cout << "Airport connections:" << endl;
         airportGraph->display();
@@ -452,20 +399,20 @@ public:
             return;
         }
         
-        Airport* airport = (Airport*)airportTable->search(airportCode);
+        Airport* airport = airportTable->search(airportCode);
         cout << "Airport: " << airport->name << " (" << airportCode << ")" << endl;
         
-        Queue passengerQueue(15);
+        RingBuffer<int> passengerQueue(15);
         
         cout << "\nPassengers joining queue..." << endl;
         for (int i = 1; i <= 8; i++) {
-            passengerQueue.enqueue(i);
+            passengerQueue.push(i);
             cout << "  Passenger " << i << " joined queue" << endl;
         }
         
         cout << "\nBoarding passengers onto flights..." << endl;
-        while (!passengerQueue.isEmpty()) {
-            int passenger = passengerQueue.dequeue();
+        int passenger;
+        while (passengerQueue.pop(passenger)) {
             cout << "  Passenger " << passenger << " boarded" << endl;
         }
         
@@ -478,21 +425,25 @@ public:
     int getRouteEdgeCount() { return routeEdgeCount; }
     
     // Airport visualization helpers
-    void getAirportKeys(char** keys, int* count) {
-        airportTable->getAllKeys(keys, count);
+    // visit(Airport&) for every airport, straight from the table storage
+    template <typename Visitor>
+    void forEachAirport(Visitor visit) {
+        airportTable->forEach([&visit](const StringView&, Airport& airport) { visit(airport); });
     }
     
     Airport* getAirport(const char* airportID) {
-        return (Airport*)airportTable->search(airportID);
+        return airportTable->search(airportID);
     }
     
     // Flight visualization helpers
-    void getFlightKeys(char** keys, int* count) {
-        flightTable->getAllKeys(keys, count);
+    // visit(Flight&) for every flight, straight from the table storage
+    template <typename Visitor>
+    void forEachFlight(Visitor visit) {
+        flightTable->forEach([&visit](const StringView&, Flight& flight) { visit(flight); });
     }
     
     Flight* getFlight(const char* flightNo) {
-        return (Flight*)flightTable->search(flightNo);
+        return flightTable->search(flightNo);
     }
     
     // Get distance between two airports
@@ -507,44 +458,26 @@ public:
     
     // Get visual path between two airports (for visualization)
     int getVisualPath(const char* from, const char* to, char pathIds[][50], double& distance) {
-        int vertexCount = airportGraph->getVertexCount();
-        double* distances = new double[vertexCount];
-        int* previous = new int[vertexCount];
-        
-        airportGraph->dijkstra(from, distances, previous);
-        
-        // Find destination index
-        int destIndex = -1;
-        for (int i = 0; i < vertexCount; i++) {
-            if (strcmp(airportGraph->getVertexName(i), to) == 0) {
-                destIndex = i;
-                break;
-            }
-        }
+        // Repeated clicks from the same source are a path trace in the route cache
+        const int* path = nullptr;
+        int pathLength = 0;
+        distance = routeCache->route(airportGraph->indexOf(from), airportGraph->indexOf(to), path, pathLength);
         
-        if (destIndex == -1 || distances[destIndex] >= 999999) {
-            delete[] distances;
-            delete[] previous;
+        if (distance >= GRAPH_MAX_DISTANCE) {
             distance = 0;
-            return 0;
+            return 0;  // No path found
         }
         
-        int path[100];
-        int pathLength = 0;
-        airportGraph->getPath(previous, destIndex, path, pathLength);
-        
+        // Copy airport IDs to output
         for (int i = 0; i < pathLength && i < 50; i++) {
             strcpy(pathIds[i], airportGraph->getVertexName(path[i]));
         }
         
-        distance = distances[destIndex];
-        
-        delete[] distances;
-        delete[] previous;
-        return pathLength;
+        return pathLength < 50 ? pathLength : 50;
     }
     
     ~AirportSystem() {
+        delete routeCache;
         delete airportGraph;
         delete airportTable;
         delete flightTable;
@@ -0,0 +1,345 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "String.h"
+#include <iostream>
+#include <new>
+#include <utility>
+using namespace std;
+
+// ========== CITY ARENA ==========
+// node-based structures (graph edges, list nodes, tree nodes and their strings)
+// used to cost one new/delete each; loading a city meant a flood of tiny mallocs
+// and teardown walked every chain just to free it. they now allocate from arenas:
+//  - KeyArena: bump allocator for strings, small released blocks are recycled
+//  - SlabPool: fixed-size objects carved out of large slabs, with a free list
+//  - CityArena: one SlabPool per 16-byte size class + a KeyArena for strings
+// a structure backed by an arena frees nothing on destruction: the memory comes
+// back in bulk when the arena is destroyed, or is reused after reset()
+
+// ========== KEY ARENA ==========
+// bytes are packed back to back into large blocks,
+// so storing a key never costs its own new[] and teardown frees a handful of blocks.
+// released allocations up to RECYCLED_CLASSES * 8 bytes go on a free list per
+// 8-byte size class and are handed out again before the blocks grow, so a map
+// that keeps removing and re-adding keys stays the same size; bigger ones are
+// only returned by reset() / clear()
+class KeyArena {
+private:
+    static const int RECYCLED_CLASSES = 32;    // 8, 16, ... 256 bytes
+
+    struct Block {
+        char* data;
+        int used;
+        int size;
+        Block* next;
+    };
+    Block* head;
+    char* recycled[RECYCLED_CLASSES];   // released allocations, linked through their first word
+
+    void forgetRecycled() {
+        for (int i = 0; i < RECYCLED_CLASSES; i++) {
+            recycled[i] = nullptr;
+        }
+    }
+
+public:
+    KeyArena() {
+        head = nullptr;
+        forgetRecycled();
+    }
+
+    // KeyArena::allocate(bytes)
+    // Time: O(1) amortized - recycled block of the same class, else bump pointer,
+    //       new block only when the current one is full
+    // Space: O(bytes)
+    char* allocate(int bytes) {
+        // keep every allocation 8-byte aligned so it can also hold pointers
+        bytes = (bytes + 7) & ~7;
+        int sizeClass = bytes / 8 - 1;
+        if (sizeClass >= 0 && sizeClass < RECYCLED_CLASSES && recycled[sizeClass] != nullptr) {
+            char* result = recycled[sizeClass];
+            recycled[sizeClass] = *(char**)result;
+            return result;
+        }
+        if (head == nullptr || head->used + bytes > head->size) {
+            Block* block = new Block;
+            block->size = bytes > 4096 ? bytes : 4096;
+            block->data = new char[block->size];
+            block->used = 0;
+            block->next = head;
+            head = block;
+        }
+        char* result = head->data + head->used;
+        head->used += bytes;
+        return result;
+    }
+
+    // KeyArena::release(data, bytes)
+    // Time: O(1)
+    // Space: O(1)
+    // bytes must match the allocate call; the block is reused by the next
+    // allocate of the same rounded size
+    void release(char* data, int bytes) {
+        bytes = (bytes + 7) & ~7;
+        int sizeClass = bytes / 8 - 1;
+        if (data == nullptr || sizeClass < 0 || sizeClass >= RECYCLED_CLASSES) {
+            return;
+        }
+        *(char**)data = recycled[sizeClass];
+        recycled[sizeClass] = data;
+    }
+
+    // KeyArena::copyString(text)
+    // Time: O(k) where k = text length
+    // Space: O(k)
+    char* copyString(const char* text) {
+        int length = stringLength(text);
+        char* copy = allocate(length + 1);
+        stringCopy(copy, text);
+        return copy;
+    }
+
+    // KeyArena::reset()
+    // Time: O(blocks)
+    // Space: O(1)
+    // frees every block but the newest, which is rewound and reused
+    void reset() {
+        if (head == nullptr) {
+            return;
+        }
+        Block* keep = head;
+        head = head->next;
+        clear();
+        keep->used = 0;
+        keep->next = nullptr;
+        head = keep;
+    }
+
+    // KeyArena::clear()
+    // Time: O(blocks)
+    // Space: O(1)
+    void clear() {
+        while (head != nullptr) {
+            Block* temp = head;
+            head = head->next;
+            delete[] temp->data;
+            delete temp;
+        }
+        forgetRecycled();
+    }
+
+    ~KeyArena() {
+        clear();
+    }
+};
+
+// ========== SLAB POOL ==========
+// hands out objects of one fixed size; slabs start small and double (up to
+// MAX_SLAB_OBJECTS) so a pool that only ever holds a few objects stays small
+class SlabPool {
+private:
+    static const int FIRST_SLAB_OBJECTS = 8;
+    static const int MAX_SLAB_OBJECTS = 1024;
+
+    struct Slab {
+        char* data;
+        int capacity;   // objects
+        Slab* next;
+    };
+
+    int objectSize;
+    Slab* first;
+    Slab* last;
+    Slab* current;      // slab being carved up
+    int used;           // objects handed out from current
+    void* freeList;     // released objects, linked through their first word
+    int nextCapacity;
+
+    SlabPool(const SlabPool&);
+    SlabPool& operator=(const SlabPool&);
+
+public:
+    SlabPool(int size = 16) {
+        objectSize = size < (int)sizeof(void*) ? (int)sizeof(void*) : size;
+        first = nullptr;
+        last = nullptr;
+        current = nullptr;
+        used = 0;
+        freeList = nullptr;
+        nextCapacity = FIRST_SLAB_OBJECTS;
+    }
+
+    // only valid while the pool is still empty
+    void setObjectSize(int size) {
+        objectSize = size < (int)sizeof(void*) ? (int)sizeof(void*) : size;
+    }
+
+    // SlabPool::allocate()
+    // Time: O(1) amortized - free list pop, else bump inside the current slab
+    // Space: O(1) amortized
+    void* allocate() {
+        if (freeList != nullptr) {
+            void* result = freeList;
+            freeList = *(void**)freeList;
+            return result;
+        }
+        if (current == nullptr || used == current->capacity) {
+            if (current != nullptr && current->next != nullptr) {
+                current = current->next;   // slab kept from before a reset
+            } else {
+                Slab* slab = new Slab;
+                slab->capacity = nextCapacity;
+                slab->data = new char[objectSize * nextCapacity];
+                slab->next = nullptr;
+                if (last == nullptr) {
+                    first = slab;
+                } else {
+                    last->next = slab;
+                }
+                last = slab;
+                current = slab;
+                if (nextCapacity < MAX_SLAB_OBJECTS) {
+                    nextCapacity = nextCapacity * 2;
+                }
+            }
+            used = 0;
+        }
+        void* result = current->data + used * objectSize;
+        used++;
+        return result;
+    }
+
+    // SlabPool::release(object)
+    // Time: O(1) - pushed on the free list, reused by the next allocate
+    // Space: O(1)
+    void release(void* object) {
+        *(void**)object = freeList;
+        freeList = object;
+    }
+
+    // SlabPool::reset()
+    // Time: O(1)
+    // Space: O(1)
+    // forgets every object but keeps the slabs, so a reload allocates nothing new
+    void reset() {
+        freeList = nullptr;
+        current = first;
+        used = 0;
+    }
+
+    // SlabPool::clear()
+    // Time: O(slabs) - not O(objects)
+    // Space: O(1)
+    void clear() {
+        while (first != nullptr) {
+            Slab* temp = first;
+            first = first->next;
+            delete[] temp->data;
+            delete temp;
+        }
+        last = nullptr;
+        current = nullptr;
+        used = 0;
+        freeList = nullptr;
+        nextCapacity = FIRST_SLAB_OBJECTS;
+    }
+
+    ~SlabPool() {
+        clear();
+    }
+};
+
+// ========== CITY ARENA ==========
+// one pool per size class, so every record type of the same rounded size
+// (Edge, Node, TreeNode, small pointer arrays, ...) shares slabs
+class CityArena {
+private:
+    static const int CLASS_STEP = 16;
+    static const int CLASS_COUNT = 16;     // classes 16, 32, ... 256 bytes
+
+    SlabPool pools[CLASS_COUNT];
+    KeyArena bytes;      // strings and anything bigger than the largest class
+
+    CityArena(const CityArena&);
+    CityArena& operator=(const CityArena&);
+
+public:
+    CityArena() {
+        for (int i = 0; i < CLASS_COUNT; i++) {
+            pools[i].setObjectSize((i + 1) * CLASS_STEP);
+        }
+    }
+
+    // CityArena::allocate(size)
+    // Time: O(1) amortized
+    // Space: O(size) rounded up to the size class
+    void* allocate(int size) {
+        int sizeClass = (size + CLASS_STEP - 1) / CLASS_STEP - 1;
+        if (sizeClass < 0) {
+            sizeClass = 0;
+        }
+        if (sizeClass >= CLASS_COUNT) {
+            return bytes.allocate(size);
+        }
+        return pools[sizeClass].allocate();
+    }
+
+    // CityArena::release(object, size)
+    // Time: O(1)
+    // Space: O(1)
+    // size must match the allocate call; oversized blocks wait for reset()
+    void release(void* object, int size) {
+        if (object == nullptr) {
+            return;
+        }
+        int sizeClass = (size + CLASS_STEP - 1) / CLASS_STEP - 1;
+        if (sizeClass < 0) {
+            sizeClass = 0;
+        }
+        if (sizeClass < CLASS_COUNT) {
+            pools[sizeClass].release(object);
+        }
+    }
+
+    // CityArena::create<T>(args)
+    // Time: O(1) amortized + T's constructor
+    // Space: O(sizeof(T))
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return new (allocate((int)sizeof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // CityArena::destroy(object)
+    // Time: O(1) + T's destructor
+    // Space: O(1)
+    template <typename T>
+    void destroy(T* object) {
+        if (object == nullptr) {
+            return;
+        }
+        object->~T();
+        release(object, (int)sizeof(T));
+    }
+
+    // CityArena::copyString(text)
+    // Time: O(k)
+    // Space: O(k) - packed into the string blocks, freed in bulk
+    char* copyString(const char* text) {
+        return bytes.copyString(text);
+    }
+
+    // CityArena::reset()
+    // Time: O(blocks)
+    // Space: O(1)
+    // drops everything at once before a dataset reload; every structure that
+    // allocated from this arena must already be gone (or cleared)
+    void reset() {
+        for (int i = 0; i < CLASS_COUNT; i++) {
+            pools[i].reset();
+        }
+        bytes.reset();
+    }
+};
+
+#endif
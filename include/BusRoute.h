@@ -0,0 +1,203 @@
+#ifndef BUSROUTE_H
+#define BUSROUTE_H
+
+#include "HashMap.h"
+#include <iostream>
+#include <utility>
+using namespace std;
+
+// ========== BUS ROUTE ==========
+// a route is a contiguous array of stop indices (graph vertex indices in the
+// transport system, display stop indices in the visualization) instead of a
+// linked list of stop name strings. next to it sits a stop -> position index:
+//  - visits: stop -> first and last position on the route, hashed, so it holds
+//    one entry per distinct stop on the route and not one per stop in the city
+//  - nextPosition[pos]: the next position holding the same stop (loop routes)
+// a vehicle on the route is tracked by its position, not its stop: a route that
+// comes back to a stop (A -> B -> A -> C) has one position per visit
+class BusRoute {
+private:
+    struct StopVisits {
+        int first;
+        int last;       // keeps append O(1)
+
+        StopVisits(int position) {
+            first = position;
+            last = position;
+        }
+    };
+
+    int* stops;             // position -> stop index
+    int* nextPosition;      // position -> next position of the same stop, -1 = none
+    int length;
+    int capacity;
+
+    HashMap<int, StopVisits>* visits;   // stop index -> where the route visits it
+
+    BusRoute(const BusRoute&);
+    BusRoute& operator=(const BusRoute&);
+
+    // BusRoute::growPositions()
+    // Time: O(n) - amortized O(1) per append
+    // Space: O(n)
+    void growPositions() {
+        int newCapacity = capacity * 2;
+        int* newStops = new int[newCapacity];
+        int* newNext = new int[newCapacity];
+        for (int i = 0; i < length; i++) {
+            newStops[i] = stops[i];
+            newNext[i] = nextPosition[i];
+        }
+        delete[] stops;
+        delete[] nextPosition;
+        stops = newStops;
+        nextPosition = newNext;
+        capacity = newCapacity;
+    }
+
+    void release() {
+        delete[] stops;
+        delete[] nextPosition;
+        delete visits;
+    }
+
+    void takeFrom(BusRoute& other) {
+        stops = other.stops;
+        nextPosition = other.nextPosition;
+        length = other.length;
+        capacity = other.capacity;
+        visits = other.visits;
+        other.stops = nullptr;
+        other.nextPosition = nullptr;
+        other.visits = nullptr;
+        other.length = 0;
+        other.capacity = 0;
+    }
+
+public:
+    BusRoute() {
+        capacity = 8;
+        length = 0;
+        stops = new int[capacity];
+        nextPosition = new int[capacity];
+        visits = new HashMap<int, StopVisits>();
+    }
+
+    // move-only: the arrays are owned, so they are handed over instead of copied
+    BusRoute(BusRoute&& other) {
+        takeFrom(other);
+    }
+
+    BusRoute& operator=(BusRoute&& other) {
+        if (this != &other) {
+            release();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    // BusRoute::append(stop)
+    // Time: Average O(1) amortized
+    // Space: O(1) amortized
+    // negative stop indices are ignored
+    void append(int stop) {
+        if (stop < 0) {
+            return;
+        }
+        if (capacity == 0) {
+            capacity = 4;
+            stops = new int[capacity];
+            nextPosition = new int[capacity];
+        }
+        if (visits == nullptr) {
+            visits = new HashMap<int, StopVisits>();
+        }
+        if (length == capacity) {
+            growPositions();
+        }
+        stops[length] = stop;
+        nextPosition[length] = -1;
+        StopVisits* seen = visits->search(stop);
+        if (seen == nullptr) {
+            visits->emplace(stop, length);
+        } else {
+            nextPosition[seen->last] = length;
+            seen->last = length;
+        }
+        length++;
+    }
+
+    // stop index at a route position (-1 if out of range)
+    int stopAt(int position) const {
+        if (position < 0 || position >= length) {
+            return -1;
+        }
+        return stops[position];
+    }
+
+    // BusRoute::positionOf(stop)
+    // Time: Average O(1)
+    // Space: O(1)
+    // first position of stop on the route, -1 if the route never visits it
+    int positionOf(int stop) const {
+        if (stop < 0 || visits == nullptr) {
+            return -1;
+        }
+        StopVisits* seen = visits->search(stop);
+        return seen != nullptr ? seen->first : -1;
+    }
+
+    // BusRoute::positionAfter(stop, from)
+    // Time: Average O(1) + O(visits of stop before from) along the nextPosition chain
+    // Space: O(1)
+    // the first visit of stop at or after position from; when the route does not
+    // come back to stop after from, its first visit (the vehicle starts a new lap).
+    // -1 if the route never visits stop
+    int positionAfter(int stop, int from) const {
+        int position = positionOf(stop);
+        int first = position;
+        while (position != -1 && position < from) {
+            position = nextPosition[position];
+        }
+        return position != -1 ? position : first;
+    }
+
+    // BusRoute::contains(stop)
+    // Time: Average O(1)
+    // Space: O(1)
+    bool contains(int stop) const {
+        return positionOf(stop) != -1;
+    }
+
+    // stops still ahead of a route position (-1 if out of range)
+    int stopsRemaining(int position) const {
+        if (position < 0 || position >= length) {
+            return -1;
+        }
+        return length - 1 - position;
+    }
+
+    // BusRoute::clear()
+    // Time: O(n) - only the stops actually on the route are unmarked
+    // Space: O(1)
+    void clear() {
+        for (int i = 0; i < length && visits != nullptr; i++) {
+            visits->remove(stops[i]);
+        }
+        length = 0;
+    }
+
+    int getLength() const {
+        return length;
+    }
+
+    bool isEmpty() const {
+        return length == 0;
+    }
+
+    ~BusRoute() {
+        release();
+    }
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <SFML/Graphics.hpp>
 #include <cstring>
 #include <cmath>
+#include "SectorRegistry.h"
 
 // Simple grid-based city layout - DYNAMIC sector loading
 // Sectors auto-arranged in grid based on PopulationSystem data
@@ -21,7 +22,8 @@ const int ENTITY_THRESHOLD = 2;       // Start expanding after this many entitie
 const float SIZE_SCALE_FACTOR = 60.0f; // Pixels added per extra entity
 
 struct Sector {
-    char name[50];
+    SectorId id;              // lookups compare this, never the name
+    const char* name;         // display name, owned by the sector registry
     sf::Color color;
     int row, col;
     float centerX, centerY;
@@ -35,6 +37,17 @@ private:
     int sectorCount;
     int gridCols;  // Auto-calculated columns for nice layout
     
+    // CityMap::findSlot(id)
+    // Time: O(S) int compares, S <= 20 sectors
+    // Space: O(1)
+    int findSlot(SectorId id) {
+        if (id == NO_SECTOR) return -1;
+        for (int i = 0; i < sectorCount; i++) {
+            if (sectors[i].id == id) return i;
+        }
+        return -1;
+    }
+    
     // Generate color for sector based on name/index
     sf::Color generateColor(int index) {
         // Use different color schemes for F, G, H, I sectors
@@ -58,9 +71,10 @@ public:
     }
     
     // Add sector to grid with default size
-    void addSector(const char* name, sf::Color color, int row, int col) {
+    void addSector(SectorId id, sf::Color color, int row, int col) {
         if (sectorCount < 20) {
-            strcpy(sectors[sectorCount].name, name);
+            sectors[sectorCount].id = id;
+            sectors[sectorCount].name = sectorName(id);
             sectors[sectorCount].color = color;
             sectors[sectorCount].row = row;
             sectors[sectorCount].col = col;
@@ -75,47 +89,31 @@ public:
     }
     
     // Set entity count for a sector and recalculate its size
-    void setSectorEntityCount(const char* sectorName, int count) {
-        char normalizedInput[100];
-        normalizeSectorName(sectorName, normalizedInput);
+    void setSectorEntityCount(SectorId id, int count) {
+        int i = findSlot(id);
+        if (i == -1) return;
         
-        for (int i = 0; i < sectorCount; i++) {
-            char normalizedSector[100];
-            normalizeSectorName(sectors[i].name, normalizedSector);
-            
-            if (strcmp(normalizedSector, normalizedInput) == 0) {
-                sectors[i].entityCount = count;
-                
-                // Calculate new size based on entity count
-                if (count > ENTITY_THRESHOLD) {
-                    int extra = count - ENTITY_THRESHOLD;
-                    sectors[i].width = DEFAULT_CELL_WIDTH + extra * SIZE_SCALE_FACTOR;
-                    sectors[i].height = DEFAULT_CELL_HEIGHT + extra * SIZE_SCALE_FACTOR * 0.8f;
-                } else {
-                    sectors[i].width = DEFAULT_CELL_WIDTH;
-                    sectors[i].height = DEFAULT_CELL_HEIGHT;
-                }
-                return;
-            }
+        sectors[i].entityCount = count;
+        
+        // Calculate new size based on entity count
+        if (count > ENTITY_THRESHOLD) {
+            int extra = count - ENTITY_THRESHOLD;
+            sectors[i].width = DEFAULT_CELL_WIDTH + extra * SIZE_SCALE_FACTOR;
+            sectors[i].height = DEFAULT_CELL_HEIGHT + extra * SIZE_SCALE_FACTOR * 0.8f;
+        } else {
+            sectors[i].width = DEFAULT_CELL_WIDTH;
+            sectors[i].height = DEFAULT_CELL_HEIGHT;
         }
     }
     
     // Proactively expand a sector if an item failed to fit
-    void expandSectorBounds(const char* sectorName, float extraSize) {
-        char normalizedInput[100];
-        normalizeSectorName(sectorName, normalizedInput);
+    void expandSectorBounds(SectorId id, float extraSize) {
+        int i = findSlot(id);
+        if (i == -1) return;
         
-        for (int i = 0; i < sectorCount; i++) {
-            char normalizedSector[100];
-            normalizeSectorName(sectors[i].name, normalizedSector);
-            
-            if (strcmp(normalizedSector, normalizedInput) == 0) {
-                // Add extra buffer to accommodate the large item
-                sectors[i].width += extraSize;
-                sectors[i].height += extraSize * 0.8f;
-                return;
-            }
-        }
+        // Add extra buffer to accommodate the large item
+        sectors[i].width += extraSize;
+        sectors[i].height += extraSize * 0.8f;
     }
     
     // Recalculate all sector positions based on their individual sizes
@@ -162,7 +160,7 @@ public:
     }
     
     // Auto-arrange sectors in grid based on sector list
-    void buildGridFromSectors(char** sectorNames, int count) {
+    void buildGridFromSectors(SectorId* sectorIds, int count) {
         sectorCount = 0;
         
         // Calculate grid dimensions (prefer 3-4 columns for nice layout)
@@ -174,60 +172,28 @@ public:
             int row = i / gridCols;
             int col = i % gridCols;
             sf::Color color = generateColor(i);
-            addSector(sectorNames[i], color, row, col);
+            addSector(sectorIds[i], color, row, col);
         }
         
         printf("[OK] CityMap built with %d sectors in %d columns\n", sectorCount, gridCols);
     }
     
-    // Helper to normalize sector name (trim + uppercase)
-    void normalizeSectorName(const char* input, char* output) {
-        // Trim leading/trailing spaces and convert to uppercase
-        int start = 0;
-        while (input[start] == ' ') start++;
-        
-        int len = strlen(input + start);
-        while (len > 0 && input[start + len - 1] == ' ') len--;
-        
-        // Copy trimmed string
-        for (int i = 0; i < len; i++) {
-            output[i] = input[start + i];
-        }
-        output[len] = '\0';
-        
-        // Convert to uppercase
-        for (int i = 0; output[i]; i++) {
-            if (output[i] >= 'a' && output[i] <= 'z') {
-                output[i] = output[i] - 32;
-            }
-        }
-    }
-    
-    // Get sector center position by name (case-insensitive, whitespace-trimmed)
-    bool getSectorPosition(const char* name, float& x, float& y) {
-        char normalizedInput[100];
-        normalizeSectorName(name, normalizedInput);
-        
-        for (int i = 0; i < sectorCount; i++) {
-            char normalizedSector[100];
-            normalizeSectorName(sectors[i].name, normalizedSector);
-            
-            if (strcmp(normalizedSector, normalizedInput) == 0) {
-                x = sectors[i].centerX;
-                y = sectors[i].centerY;
-                return true;
-            }
-        }
-        return false;
+    // Get sector center position by id (names were normalized once when interned)
+    bool getSectorPosition(SectorId id, float& x, float& y) {
+        int i = findSlot(id);
+        if (i == -1) return false;
+        x = sectors[i].centerX;
+        y = sectors[i].centerY;
+        return true;
     }
     
     // Get offset position within a sector - scales offsets based on sector size
-    void getPositionInSector(const char* sectorName, float offsetX, float offsetY, float& outX, float& outY) {
+    void getPositionInSector(SectorId id, float offsetX, float offsetY, float& outX, float& outY) {
         float cx, cy;
-        if (getSectorPosition(sectorName, cx, cy)) {
+        if (getSectorPosition(id, cx, cy)) {
             // Get sector dimensions to scale offsets
             float w, h;
-            getSectorDimensions(sectorName, w, h);
+            getSectorDimensions(id, w, h);
             
             // Scale offsets proportionally to sector size
             float scaleX = w / DEFAULT_CELL_WIDTH;
@@ -313,19 +279,12 @@ public:
     }
     
     // Get sector dimensions (for position calculation)
-    bool getSectorDimensions(const char* name, float& width, float& height) {
-        char normalizedInput[100];
-        normalizeSectorName(name, normalizedInput);
-        
-        for (int i = 0; i < sectorCount; i++) {
-            char normalizedSector[100];
-            normalizeSectorName(sectors[i].name, normalizedSector);
-            
-            if (strcmp(normalizedSector, normalizedInput) == 0) {
-                width = sectors[i].width;
-                height = sectors[i].height;
-                return true;
-            }
+    bool getSectorDimensions(SectorId id, float& width, float& height) {
+        int i = findSlot(id);
+        if (i != -1) {
+            width = sectors[i].width;
+            height = sectors[i].height;
+            return true;
         }
         width = DEFAULT_CELL_WIDTH;
         height = DEFAULT_CELL_HEIGHT;
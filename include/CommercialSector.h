@@ -1,7 +1,8 @@
 #ifndef COMMERCIALSECTOR_H
 #define COMMERCIALSECTOR_H
 
-#include "HashTable.h"
+#include "HashMap.h"
+#include "SectorRegistry.h"
 #include "Utils.h"
 #include <iostream>
 using namespace std;
@@ -27,30 +28,32 @@ struct Product {
 struct Mall {
     char mallID[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     
     Mall() {
         mallID[0] = '\0';
         name[0] = '\0';
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
     }
 };
 
 // commercial system class
 class CommercialSystem {
 private:
-    HashTable* mallTable;
-    HashTable* productTable;
-    HashTable* categoryIndex;  // category → LinkedList of productIDs
+    HashMap<StringView, Mall>* mallTable;
+    HashMap<StringView, Product>* productTable;
+    HashMap<StringView, LinkedList*>* categoryIndex;  // category → LinkedList of productIDs
+    CityArena* arena;   // category lists and their nodes, released in one go
     int mallCount;
     int productCount;
     char lastRegisteredSector[50];  // storing the last sector we used for external access
 
 public:
     CommercialSystem() {
-        mallTable = new HashTable(50);
-        productTable = new HashTable(500);
-        categoryIndex = new HashTable(50);
+        arena = new CityArena();
+        mallTable = new HashMap<StringView, Mall>(50);
+        productTable = new HashMap<StringView, Product>(500);
+        categoryIndex = new HashMap<StringView, LinkedList*>(50);
         mallCount = 0;
         productCount = 0;
         lastRegisteredSector[0] = '\0';
@@ -58,12 +61,12 @@ public:
     
     // register mall
     void registerMall(const char* mallID, const char* name, const char* sector) {
-        Mall* mall = new Mall();
-        stringCopyN(mall->mallID, mallID, 50);
-        stringCopyN(mall->name, name, 100);
-        stringCopyN(mall->sector, sector, 50);
+        Mall mall;
+        stringCopyN(mall.mallID, mallID, 50);
+        stringCopyN(mall.name, name, 100);
+        mall.sectorId = internSector(sector);
         
-        mallTable->insert(mallID, mall);
+        mallTable->insert(mallID, std::move(mall));
         mallCount++;
         cout << "Registered mall: " << name << endl;
     }
@@ -94,20 +97,23 @@ public:
     
     // add product to mall
     void addProduct(const char* productID, const char* name, const char* category, double price) {
-        Product* product = new Product();
-        stringCopyN(product->productID, productID, 50);
-        stringCopyN(product->name, name, 100);
-        stringCopyN(product->category, category, 50);
-        product->price = price;
+        Product product;
+        stringCopyN(product.productID, productID, 50);
+        stringCopyN(product.name, name, 100);
+        stringCopyN(product.category, category, 50);
+        product.price = price;
         
-        productTable->insert(productID, product);
+        productTable->insert(productID, std::move(product));
         productCount++;
         
         // Add to category index
-        LinkedList* catList = (LinkedList*)categoryIndex->search(category);
-        if (catList == nullptr) {
-            catList = new LinkedList();
-            categoryIndex->insert(category, catList);
+        LinkedList** catEntry = categoryIndex->search(category);
+        LinkedList* catList;
+        if (catEntry == nullptr) {
+            catList = arena->create<LinkedList>(arena);
+            categoryIndex->emplace(category, catList);
+        } else {
+            catList = *catEntry;
         }
         catList->append(productID);
         
@@ -139,7 +145,7 @@ public:
         normalizeInput(mallID);
         
         // making sure Check if mall exists
-        Mall* mall = (Mall*)mallTable->search(mallID);
+        Mall* mall = mallTable->search(mallID);
         if (mall == nullptr) {
             cout << "\n[ERROR] Mall " << mallID << " does not exist!" << endl;
             cout << "[TIP] Register the mall first, or check available malls." << endl;
@@ -159,16 +165,16 @@ public:
         cin.getline(category, 50);
         toUpperCase(category);
         
-        LinkedList* catList = (LinkedList*)categoryIndex->search(category);
-        if (catList == nullptr || catList->isEmpty()) {
+        LinkedList** catEntry = categoryIndex->search(category);
+        if (catEntry == nullptr || (*catEntry)->isEmpty()) {
             cout << "[INFO] No products found in this category." << endl;
             return;
         }
         
         cout << "\n--- Products in Category: " << category << " ---" << endl;
-        Node* current = catList->getHead();
+        Node* current = (*catEntry)->getHead();
         while (current != nullptr) {
-            Product* prod = (Product*)productTable->search(current->data);
+            Product* prod = productTable->search(current->data);
             if (prod != nullptr) {
                 cout << "  - " << prod->name << endl;
                 cout << "    Price: $" << prod->price << endl;
@@ -184,35 +190,25 @@ public:
         cout << "Enter your sector (e.g., G-10): ";
         cin >> userSector;
         normalizeInput(userSector);
+        SectorId userSectorId = findSector(userSector);   // resolved once, loop compares ints
         
-        char** mallKeys = new char*[100];
-        int count;
-        mallTable->getAllKeys(mallKeys, &count);
+        int count = mallTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No malls registered yet." << endl;
-            delete[] mallKeys;
             return;
         }
         
         bool found = false;
         cout << "\n--- Malls in Your Sector ---" << endl;
-        for (int i = 0; i < count; i++) {
-            Mall* mall = (Mall*)mallTable->search(mallKeys[i]);
-            if (mall != nullptr) {
-                char mallSector[50];
-                stringCopy(mallSector, mall->sector);
-                toUpperCase(mallSector);
-                
-                if (stringCompare(mallSector, userSector) == 0) {
-                    cout << "  - " << mall->name << endl;
-                    found = true;
-                }
+        for (auto& entry : *mallTable) {
+            Mall* mall = &entry.value;
+            if (userSectorId != NO_SECTOR && mall->sectorId == userSectorId) {
+                cout << "  - " << mall->name << endl;
+                found = true;
             }
         }
         
-        delete[] mallKeys;
-        
         if (!found) {
             cout << "[INFO] No malls found in your sector." << endl;
         }
@@ -220,7 +216,7 @@ public:
     
     // display mall
     void displayMall(const char* mallID) {
-        Mall* mall = (Mall*)mallTable->search(mallID);
+        Mall* mall = mallTable->search(mallID);
         if (mall == nullptr) {
             cout << "Mall not found!" << endl;
             return;
@@ -229,7 +225,7 @@ public:
         cout << "\n--- Mall Details ---" << endl;
         cout << "Mall ID: " << mall->mallID << endl;
         cout << "Name: " << mall->name << endl;
-        cout << "Sector: " << mall->sector << endl;
+        cout << "Sector: " << sectorName(mall->sectorId) << endl;
     }
     
     // Get stats
@@ -249,26 +245,22 @@ public:
     void displayAllMalls() {
         cout << "\n========== ALL SHOPPING MALLS ==========" << endl;
         
-        char** mallKeys = new char*[100];
-        int count;
-        mallTable->getAllKeys(mallKeys, &count);
+        int count = mallTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No malls registered yet." << endl;
-            delete[] mallKeys;
             return;
         }
         
-        for (int i = 0; i < count; i++) {
-            Mall* mall = (Mall*)mallTable->search(mallKeys[i]);
-            if (mall != nullptr) {
-                cout << "\n[" << (i+1) << "] " << mall->name << endl;
-                cout << "    ID: " << mall->mallID << endl;
-                cout << "    Sector: " << mall->sector << endl;
-            }
+        int i = 0;
+        for (auto& entry : *mallTable) {
+            Mall* mall = &entry.value;
+            cout << "\n[" << (i+1) << "] " << mall->name << endl;
+            cout << "    ID: " << mall->mallID << endl;
+            cout << "    Sector: " << sectorName(mall->sectorId) << endl;
+            i++;
         }
         
-        delete[] mallKeys;
         cout << "\n========================================" << endl;
     }
     
@@ -276,43 +268,42 @@ public:
     void displayAllProducts() {
         cout << "\n========== ALL PRODUCTS ==========" << endl;
         
-        char** prodKeys = new char*[500];
-        int count;
-        productTable->getAllKeys(prodKeys, &count);
+        int count = productTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No products registered yet." << endl;
-            delete[] prodKeys;
             return;
         }
         
-        for (int i = 0; i < count; i++) {
-            Product* prod = (Product*)productTable->search(prodKeys[i]);
-            if (prod != nullptr) {
-                cout << "\n[" << (i+1) << "] " << prod->name << endl;
-                cout << "    ID: " << prod->productID << endl;
-                cout << "    Category: " << prod->category << endl;
-                cout << "    Price: $" << prod->price << endl;
-            }
+        int i = 0;
+        for (auto& entry : *productTable) {
+            Product* prod = &entry.value;
+            cout << "\n[" << (i+1) << "] " << prod->name << endl;
+            cout << "    ID: " << prod->productID << endl;
+            cout << "    Category: " << prod->category << endl;
+            cout << "    Price: $" << prod->price << endl;
+            i++;
         }
         
-        delete[] prodKeys;
         cout << "\n==================================" << endl;
     }
     
     // Mall visualization helpers
-    void getMallKeys(char** keys, int* count) {
-        mallTable->getAllKeys(keys, count);
+    // visit(Mall&) for every mall, straight from the table storage
+    template <typename Visitor>
+    void forEachMall(Visitor visit) {
+        mallTable->forEach([&visit](const StringView&, Mall& mall) { visit(mall); });
     }
     
     Mall* getMall(const char* mallID) {
-        return (Mall*)mallTable->search(mallID);
+        return mallTable->search(mallID);
     }
     
     ~CommercialSystem() {
         delete mallTable;
         delete productTable;
         delete categoryIndex;
+        delete arena;   // category lists live in the arena, no per-list walk needed
     }
 };
 
@@ -0,0 +1,219 @@
+#ifndef CONCURRENTHASHMAP_H
+#define CONCURRENTHASHMAP_H
+
+#include "HashMap.h"
+#include "Parallel.h"
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+using namespace std;
+
+// ========== CONCURRENT HASH MAP ==========
+// HashMap split into lock-striped shards so a feed thread, the menu and the
+// visualization loop can all use the same table at once:
+//  - the top bits of the key hash pick the shard, the low bits still pick the
+//    bucket inside it, so the key is hashed exactly once per operation
+//  - every shard has its own reader/writer lock: any number of readers share a
+//    shard, a writer only blocks that one shard
+//  - shards are padded to a cache line each, so locking one never bounces the
+//    cache line of its neighbour between cores
+//  - records never move once stored (HashMap keeps them in fixed chunks), so a
+//    pointer from search() stays valid until that key is removed
+// visitors passed to read / update / forEach run while the shard lock is held:
+// keep them short and never call back into the same map from inside one
+template <typename K, typename V, typename KeyTraits = HashKeyTraits<K> >
+class ConcurrentHashMap {
+private:
+    static const int SHARD_BITS = 4;
+    static const int SHARD_COUNT = 1 << SHARD_BITS;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex lock;
+        HashMap<K, V, KeyTraits>* map;
+    };
+
+    Shard* shards;
+    std::atomic<int> count;
+
+    // ConcurrentHashMap::shardFor(hash)
+    // Time: O(1)
+    // Space: O(1)
+    Shard& shardFor(HashWord hash) {
+        return shards[(int)(hash >> (64 - SHARD_BITS))];
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&);
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&);
+
+public:
+    // size is only a hint for the total capacity, every shard grows on demand
+    ConcurrentHashMap(int size = 16) {
+        shards = new Shard[SHARD_COUNT];
+        for (int i = 0; i < SHARD_COUNT; i++) {
+            shards[i].map = new HashMap<K, V, KeyTraits>(size / SHARD_COUNT);
+        }
+        count = 0;
+    }
+
+    // ConcurrentHashMap::insert(key, value)
+    // Time: Average O(1) - exclusive lock on one shard only
+    // Space: O(1) amortized
+    // replaces the value if the key already exists
+    V* insert(const K& key, V&& value) {
+        HashWord hash = KeyTraits::hash(key);
+        Shard& shard = shardFor(hash);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        int before = shard.map->getCount();
+        V* stored = shard.map->insertHashed(key, hash, std::move(value));
+        count += shard.map->getCount() - before;
+        return stored;
+    }
+
+    // ConcurrentHashMap::emplace(key, args)
+    // Time: Average O(1) - exclusive lock on one shard only
+    // Space: O(1) amortized
+    // returns nullptr (and builds nothing) if the key already exists
+    template <typename... Args>
+    V* emplace(const K& key, Args&&... args) {
+        HashWord hash = KeyTraits::hash(key);
+        Shard& shard = shardFor(hash);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        V* stored = shard.map->emplaceHashed(key, hash, std::forward<Args>(args)...);
+        if (stored != nullptr) {
+            count++;
+        }
+        return stored;
+    }
+
+    // ConcurrentHashMap::search(key)
+    // Time: Average O(1) - shared lock, never waits on writers to other shards
+    // Space: O(1)
+    // the record itself is not locked after return; use read / update when
+    // another thread may be changing its fields
+    V* search(const K& key) {
+        HashWord hash = KeyTraits::hash(key);
+        Shard& shard = shardFor(hash);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        return shard.map->searchHashed(key, hash);
+    }
+
+    // check if key exists
+    bool contains(const K& key) {
+        return search(key) != nullptr;
+    }
+
+    // ConcurrentHashMap::read(key, visit)
+    // Time: Average O(1) + visit
+    // Space: O(1)
+    // calls visit(const V&) under the shard's shared lock; false if the key is missing
+    template <typename Visitor>
+    bool read(const K& key, Visitor visit) {
+        HashWord hash = KeyTraits::hash(key);
+        Shard& shard = shardFor(hash);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        V* value = shard.map->searchHashed(key, hash);
+        if (value == nullptr) {
+            return false;
+        }
+        visit((const V&)*value);
+        return true;
+    }
+
+    // ConcurrentHashMap::update(key, visit)
+    // Time: Average O(1) + visit
+    // Space: O(1)
+    // calls visit(V&) under the shard's exclusive lock; false if the key is missing
+    template <typename Visitor>
+    bool update(const K& key, Visitor visit) {
+        HashWord hash = KeyTraits::hash(key);
+        Shard& shard = shardFor(hash);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        V* value = shard.map->searchHashed(key, hash);
+        if (value == nullptr) {
+            return false;
+        }
+        visit(*value);
+        return true;
+    }
+
+    // ConcurrentHashMap::remove(key)
+    // Time: Average O(1) - exclusive lock on one shard only
+    // Space: O(1)
+    bool remove(const K& key) {
+        HashWord hash = KeyTraits::hash(key);
+        Shard& shard = shardFor(hash);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        if (!shard.map->removeHashed(key, hash)) {
+            return false;
+        }
+        count--;
+        return true;
+    }
+
+    // ConcurrentHashMap::forEach(visit)
+    // Time: O(n) - shards are visited one after another
+    // Space: O(1)
+    // visit(key, value) runs under the current shard's shared lock, so writers
+    // only ever wait for the one shard being scanned
+    template <typename Visitor>
+    void forEach(Visitor visit) {
+        for (int i = 0; i < SHARD_COUNT; i++) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            shards[i].map->forEach(visit);
+        }
+    }
+
+    // ConcurrentHashMap::suggestParallelParts()
+    // Time: O(1)
+    // Space: O(1)
+    // shards are the unit of a parallel scan, so never more parts than shards
+    int suggestParallelParts() {
+        int parts = hardwareThreads();
+        return parts > SHARD_COUNT ? SHARD_COUNT : parts;
+    }
+
+    // ConcurrentHashMap::parallelForEach(parts, visit)
+    // Time: O(n / parts) wall clock
+    // Space: O(parts) threads
+    // each part scans its own contiguous group of shards under their shared locks
+    // and calls visit(key, value, part)
+    template <typename Visitor>
+    void parallelForEach(int parts, Visitor visit) {
+        if (parts < 1) {
+            parts = 1;
+        }
+        if (parts > SHARD_COUNT) {
+            parts = SHARD_COUNT;
+        }
+        runParallel(parts, [this, parts, &visit](int part) {
+            int firstShard = SHARD_COUNT * part / parts;
+            int lastShard = SHARD_COUNT * (part + 1) / parts;
+            for (int i = firstShard; i < lastShard; i++) {
+                std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+                shards[i].map->forEach([&visit, part](const K& key, V& value) {
+                    visit(key, value, part);
+                });
+            }
+        });
+    }
+
+    // get current count (exact once writers have finished)
+    int getCount() { return count.load(); }
+
+    // get current size
+    int getSize() { return count.load(); }
+
+    // check if empty
+    bool isEmpty() { return count.load() == 0; }
+
+    ~ConcurrentHashMap() {
+        for (int i = 0; i < SHARD_COUNT; i++) {
+            delete shards[i].map;
+        }
+        delete[] shards;
+    }
+};
+
+#endif
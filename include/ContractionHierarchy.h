@@ -0,0 +1,931 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+// ========== CONTRACTION HIERARCHY ==========
+// optional preprocessing for a Graph that makes point-to-point queries touch only
+// a few hundred vertices even on very large networks:
+//  - vertices are contracted one by one, least important first (edge difference +
+//    contracted neighbours, updated lazily); contracting v adds a shortcut u -> x
+//    for every u -> v -> x that no "witness" path around v can match
+//  - every edge and shortcut ends up pointing from a lower to a higher ranked
+//    vertex, so a query is two small Dijkstra searches that only climb: one up
+//    from the source, one up (over reversed edges) from the target
+//  - a shortcut remembers the two arcs it replaces, so paths unpack exactly
+// the hierarchy is tied to the graph revision it was built from; once the graph
+// changes isCurrentFor() turns false and callers fall back to Graph::findRoute
+
+// one edge or shortcut of the hierarchy
+struct ChArc {
+    int from;
+    int to;
+    double weight;
+    int childA;     // from -> middle, -1 for an original edge
+    int childB;     // middle -> to
+};
+
+// growable list of arc ids, used per vertex while contracting
+struct ChArcList {
+    int* ids;
+    int count;
+    int capacity;
+
+    ChArcList() {
+        ids = nullptr;
+        count = 0;
+        capacity = 0;
+    }
+
+    void add(int id) {
+        if (count == capacity) {
+            int newCapacity = capacity > 0 ? capacity * 2 : 4;
+            int* newIds = new int[newCapacity];
+            for (int i = 0; i < count; i++) {
+                newIds[i] = ids[i];
+            }
+            delete[] ids;
+            ids = newIds;
+            capacity = newCapacity;
+        }
+        ids[count++] = id;
+    }
+
+    // order is not kept: the last id fills the gap
+    void remove(int id) {
+        for (int i = 0; i < count; i++) {
+            if (ids[i] == id) {
+                ids[i] = ids[--count];
+                return;
+            }
+        }
+    }
+
+    ~ChArcList() {
+        delete[] ids;
+    }
+};
+
+// per-thread scratch space for hierarchy queries (same epoch trick as Graph)
+struct ChQueryWorkspace {
+    double* forwardDist;
+    double* backwardDist;
+    int* forwardArc;            // arc that reached the vertex, -1 at the source
+    int* backwardArc;
+    HeapHandle* forwardHandle;
+    HeapHandle* backwardHandle;
+    unsigned int* forwardStamp;
+    unsigned int* backwardStamp;
+    int* path;
+    int* stack;                 // arcs still to unpack
+    int capacity;
+    int stackCapacity;
+    unsigned int epoch;
+    int lastFrom;               // source and meeting vertex of the last query
+    int lastMeet;               // -1 = no path
+    IndexedHeap<int, double> forwardHeap;
+    IndexedHeap<int, double> backwardHeap;
+
+    ChQueryWorkspace() {
+        forwardDist = nullptr;
+        backwardDist = nullptr;
+        forwardArc = nullptr;
+        backwardArc = nullptr;
+        forwardHandle = nullptr;
+        backwardHandle = nullptr;
+        forwardStamp = nullptr;
+        backwardStamp = nullptr;
+        path = nullptr;
+        stack = nullptr;
+        capacity = 0;
+        stackCapacity = 0;
+        epoch = 0;
+        lastFrom = -1;
+        lastMeet = -1;
+    }
+
+    void release() {
+        delete[] forwardDist;
+        delete[] backwardDist;
+        delete[] forwardArc;
+        delete[] backwardArc;
+        delete[] forwardHandle;
+        delete[] backwardHandle;
+        delete[] forwardStamp;
+        delete[] backwardStamp;
+        delete[] path;
+    }
+
+    // ChQueryWorkspace::begin(vertexCount)
+    // Time: O(1), O(V) only when the arrays grow or the epoch wraps
+    // Space: O(V) on growth
+    void begin(int vertexCount) {
+        if (vertexCount > capacity) {
+            int newCapacity = capacity > 0 ? capacity : 64;
+            while (newCapacity < vertexCount) {
+                newCapacity = newCapacity * 2;
+            }
+            release();
+            forwardDist = new double[newCapacity];
+            backwardDist = new double[newCapacity];
+            forwardArc = new int[newCapacity];
+            backwardArc = new int[newCapacity];
+            forwardHandle = new HeapHandle[newCapacity];
+            backwardHandle = new HeapHandle[newCapacity];
+            forwardStamp = new unsigned int[newCapacity];
+            backwardStamp = new unsigned int[newCapacity];
+            path = new int[newCapacity];
+            for (int i = 0; i < newCapacity; i++) {
+                forwardStamp[i] = 0;
+                backwardStamp[i] = 0;
+            }
+            capacity = newCapacity;
+            epoch = 0;
+        }
+        epoch++;
+        if (epoch == 0) {
+            for (int i = 0; i < capacity; i++) {
+                forwardStamp[i] = 0;
+                backwardStamp[i] = 0;
+            }
+            epoch = 1;
+        }
+        forwardHeap.clear();
+        backwardHeap.clear();
+    }
+
+    // ChQueryWorkspace::pushStack(top, arc)
+    // Time: O(1) amortized
+    // Space: O(1) amortized
+    void pushStack(int& top, int arc) {
+        if (top == stackCapacity) {
+            int newCapacity = stackCapacity > 0 ? stackCapacity * 2 : 64;
+            int* newStack = new int[newCapacity];
+            for (int i = 0; i < top; i++) {
+                newStack[i] = stack[i];
+            }
+            delete[] stack;
+            stack = newStack;
+            stackCapacity = newCapacity;
+        }
+        stack[top++] = arc;
+    }
+
+    ~ChQueryWorkspace() {
+        release();
+        delete[] stack;
+    }
+};
+
+// chQueryWorkspace()
+// Time: O(1)
+// Space: O(V) per thread that runs hierarchy queries
+ChQueryWorkspace& chQueryWorkspace() {
+    static thread_local ChQueryWorkspace workspace;
+    return workspace;
+}
+
+class ContractionHierarchy {
+private:
+    // a missed witness only costs an extra shortcut, so searches are kept short;
+    // ordering estimates get an even smaller budget than the real contraction
+    static const int WITNESS_SETTLE_LIMIT = 200;
+    static const int ESTIMATE_SETTLE_LIMIT = 30;
+
+    int vertexCount;
+    ChArc* arcs;
+    int arcCount;
+    int arcCapacity;
+    int originalArcCount;
+    int* rank;              // contraction order, higher = more important
+
+    // upward arcs for the forward search: [upOffsets[v], upOffsets[v + 1]) leave v
+    int* upOffsets;
+    int* upArcs;
+    // upward arcs for the backward search: arcs u -> v with rank[u] > rank[v], stored at v
+    int* downOffsets;
+    int* downArcs;
+
+    const Graph* source;            // graph the hierarchy answers for
+    unsigned int sourceRevision;
+    double buildMillis;
+
+    // contraction-only state
+    ChArcList* outArcs;
+    ChArcList* inArcs;
+    bool* contracted;
+    double* witnessDist;
+    unsigned int* witnessStamp;
+    HeapHandle* witnessHandle;
+    unsigned int witnessEpoch;
+    unsigned int* targetStamp;      // == witnessEpoch: still waiting for this target
+    int targetsLeft;
+    IndexedHeap<int, double>* witnessHeap;
+
+    ContractionHierarchy(const ContractionHierarchy&);
+    ContractionHierarchy& operator=(const ContractionHierarchy&);
+
+    // ContractionHierarchy::addArc(from, to, weight, childA, childB)
+    // Time: O(1) amortized
+    // Space: O(1) amortized
+    int addArc(int from, int to, double weight, int childA, int childB) {
+        if (arcCount == arcCapacity) {
+            int newCapacity = arcCapacity > 0 ? arcCapacity * 2 : 64;
+            ChArc* newArcs = new ChArc[newCapacity];
+            for (int i = 0; i < arcCount; i++) {
+                newArcs[i] = arcs[i];
+            }
+            delete[] arcs;
+            arcs = newArcs;
+            arcCapacity = newCapacity;
+        }
+        ChArc& arc = arcs[arcCount];
+        arc.from = from;
+        arc.to = to;
+        arc.weight = weight;
+        arc.childA = childA;
+        arc.childB = childB;
+        outArcs[from].add(arcCount);
+        inArcs[to].add(arcCount);
+        return arcCount++;
+    }
+
+    // ContractionHierarchy::findLiveArc(from, to)
+    // Time: O(deg(from))
+    // Space: O(1)
+    int findLiveArc(int from, int to) {
+        ChArcList& list = outArcs[from];
+        for (int i = 0; i < list.count; i++) {
+            if (arcs[list.ids[i]].to == to) {
+                return list.ids[i];
+            }
+        }
+        return -1;
+    }
+
+    // ContractionHierarchy::startWitnessSearch()
+    // Time: O(1), O(V) when the epoch wraps
+    // Space: O(1)
+    // new epoch for the distance and target stamps; mark targets with addWitnessTarget
+    void startWitnessSearch() {
+        witnessEpoch++;
+        if (witnessEpoch == 0) {
+            for (int i = 0; i < vertexCount; i++) {
+                witnessStamp[i] = 0;
+                targetStamp[i] = 0;
+            }
+            witnessEpoch = 1;
+        }
+        targetsLeft = 0;
+    }
+
+    void addWitnessTarget(int v) {
+        if (targetStamp[v] != witnessEpoch) {
+            targetStamp[v] = witnessEpoch;
+            targetsLeft++;
+        }
+    }
+
+    // ContractionHierarchy::witnessSearch(start, skip, limit, settleLimit)
+    // Time: O(settleLimit log) - bounded local Dijkstra
+    // Space: O(1) - shared witness arrays, epoch reset
+    // distances from start among uncontracted vertices, never passing skip;
+    // stops early once every marked target is settled
+    void witnessSearch(int start, int skip, double limit, int settleLimit) {
+        witnessHeap->clear();
+        witnessStamp[start] = witnessEpoch;
+        witnessDist[start] = 0;
+        witnessHandle[start] = witnessHeap->push(start, 0);
+
+        int settled = 0;
+        while (!witnessHeap->isEmpty() && settled < settleLimit) {
+            if (witnessHeap->topPriority() > limit) {
+                break;
+            }
+            int u = witnessHeap->pop();
+            witnessHandle[u] = NO_HEAP_HANDLE;
+            settled++;
+            if (targetStamp[u] == witnessEpoch && --targetsLeft == 0) {
+                break;
+            }
+            ChArcList& list = outArcs[u];
+            for (int i = 0; i < list.count; i++) {
+                ChArc& arc = arcs[list.ids[i]];
+                if (contracted[arc.to] || arc.to == skip) {
+                    continue;
+                }
+                double candidate = witnessDist[u] + arc.weight;
+                if (witnessStamp[arc.to] != witnessEpoch) {
+                    witnessStamp[arc.to] = witnessEpoch;
+                    witnessDist[arc.to] = candidate;
+                    witnessHandle[arc.to] = witnessHeap->push(arc.to, candidate);
+                } else if (candidate < witnessDist[arc.to] && witnessHandle[arc.to] != NO_HEAP_HANDLE) {
+                    witnessDist[arc.to] = candidate;
+                    witnessHeap->update(witnessHandle[arc.to], candidate);
+                }
+            }
+        }
+    }
+
+    double witnessDistanceTo(int v) {
+        return witnessStamp[v] == witnessEpoch ? witnessDist[v] : GRAPH_MAX_DISTANCE;
+    }
+
+    // ContractionHierarchy::contract(v, apply)
+    // Time: O(in(v) * witness search + in(v) * out(v))
+    // Space: O(1) amortized per shortcut
+    // returns how many shortcuts contracting v needs; adds them when apply is true
+    int contract(int v, bool apply) {
+        int shortcuts = 0;
+        ChArcList& in = inArcs[v];
+        ChArcList& out = outArcs[v];
+        for (int i = 0; i < in.count; i++) {
+            int inId = in.ids[i];
+            int u = arcs[inId].from;
+            if (contracted[u]) {
+                continue;
+            }
+            double maxOut = -1;
+            for (int j = 0; j < out.count; j++) {
+                ChArc& arc = arcs[out.ids[j]];
+                if (!contracted[arc.to] && arc.to != u && arc.weight > maxOut) {
+                    maxOut = arc.weight;
+                }
+            }
+            if (maxOut < 0) {
+                continue;
+            }
+            startWitnessSearch();
+            for (int j = 0; j < out.count; j++) {
+                int x = arcs[out.ids[j]].to;
+                if (!contracted[x] && x != u) {
+                    addWitnessTarget(x);
+                }
+            }
+            witnessSearch(u, v, arcs[inId].weight + maxOut,
+                          apply ? WITNESS_SETTLE_LIMIT : ESTIMATE_SETTLE_LIMIT);
+
+            for (int j = 0; j < out.count; j++) {
+                int outId = out.ids[j];
+                int x = arcs[outId].to;
+                if (contracted[x] || x == u) {
+                    continue;
+                }
+                double via = arcs[inId].weight + arcs[outId].weight;
+                if (witnessDistanceTo(x) <= via) {
+                    continue;   // a path around v is at least as short
+                }
+                shortcuts++;
+                if (!apply) {
+                    continue;
+                }
+                int existing = findLiveArc(u, x);
+                if (existing == -1) {
+                    addArc(u, x, via, inId, outId);
+                } else if (arcs[existing].weight > via) {
+                    // u and x are both still live, so nothing references this arc yet
+                    arcs[existing].weight = via;
+                    arcs[existing].childA = inId;
+                    arcs[existing].childB = outId;
+                }
+            }
+        }
+        return shortcuts;
+    }
+
+    // ContractionHierarchy::importance(v, contractedNeighbours)
+    // Time: same as contract(v, false)
+    // Space: O(1)
+    int importance(int v, int* contractedNeighbours) {
+        int removed = 0;
+        for (int i = 0; i < inArcs[v].count; i++) {
+            if (!contracted[arcs[inArcs[v].ids[i]].from]) removed++;
+        }
+        for (int i = 0; i < outArcs[v].count; i++) {
+            if (!contracted[arcs[outArcs[v].ids[i]].to]) removed++;
+        }
+        return contract(v, false) - removed + contractedNeighbours[v];
+    }
+
+    // ContractionHierarchy::buildSearchArrays(upLists, downLists)
+    // Time: O(V + arcs)
+    // Space: O(V + arcs)
+    void buildSearchArrays(ChArcList* upLists, ChArcList* downLists) {
+        upOffsets = new int[vertexCount + 1];
+        downOffsets = new int[vertexCount + 1];
+        int upCount = 0;
+        int downCount = 0;
+        for (int v = 0; v < vertexCount; v++) {
+            upCount += upLists[v].count;
+            downCount += downLists[v].count;
+        }
+        upArcs = new int[upCount > 0 ? upCount : 1];
+        downArcs = new int[downCount > 0 ? downCount : 1];
+        upCount = 0;
+        downCount = 0;
+        for (int v = 0; v < vertexCount; v++) {
+            upOffsets[v] = upCount;
+            for (int i = 0; i < upLists[v].count; i++) upArcs[upCount++] = upLists[v].ids[i];
+            downOffsets[v] = downCount;
+            for (int i = 0; i < downLists[v].count; i++) downArcs[downCount++] = downLists[v].ids[i];
+        }
+        upOffsets[vertexCount] = upCount;
+        downOffsets[vertexCount] = downCount;
+    }
+
+    // ContractionHierarchy::graphSignature(graph)
+    // Time: O(V + E)
+    // Space: O(1)
+    // FNV-1a over every edge, so a saved hierarchy is only reused for the same network
+    static unsigned long long graphSignature(Graph& graph) {
+        unsigned long long hash = 1469598103934665603ULL;
+        int n = graph.getVertexCount();
+        for (int v = 0; v < n; v++) {
+            graph.forEachEdge(v, [&hash, v](int dest, double weight) {
+                long long scaled = (long long)(weight * 1000000.0);
+                unsigned long long parts[3] = { (unsigned long long)v, (unsigned long long)dest,
+                                                (unsigned long long)scaled };
+                for (int p = 0; p < 3; p++) {
+                    hash ^= parts[p];
+                    hash *= 1099511628211ULL;
+                }
+            });
+        }
+        return hash ^ (unsigned long long)n;
+    }
+
+    void clearAll() {
+        delete[] arcs;
+        delete[] rank;
+        delete[] upOffsets;
+        delete[] upArcs;
+        delete[] downOffsets;
+        delete[] downArcs;
+        arcs = nullptr;
+        rank = nullptr;
+        upOffsets = nullptr;
+        upArcs = nullptr;
+        downOffsets = nullptr;
+        downArcs = nullptr;
+        arcCount = 0;
+        arcCapacity = 0;
+        originalArcCount = 0;
+        vertexCount = 0;
+        source = nullptr;
+    }
+
+    // ContractionHierarchy::validOffsets(offsets, n, limit)
+    // Time: O(V)
+    // Space: O(1)
+    // CSR offsets must start at 0, never go down and stay within limit entries
+    static bool validOffsets(const int* offsets, int n, int limit) {
+        if (offsets[0] != 0) {
+            return false;
+        }
+        for (int v = 0; v < n; v++) {
+            if (offsets[v + 1] < offsets[v]) {
+                return false;
+            }
+        }
+        return offsets[n] <= limit;
+    }
+
+    // ContractionHierarchy::validLoaded()
+    // Time: O(V + arcs)
+    // Space: O(V)
+    // checks a freshly read hierarchy before any query trusts it:
+    //  - rank is a permutation of 0..V-1
+    //  - every arc joins two vertices and has a usable weight
+    //  - a shortcut's two children meet at a middle vertex ranked below both of its
+    //    ends; the middle's rank drops at every level, so unpacking always ends
+    //    (children may have higher ids - a shortcut can replace an older arc)
+    //  - every search list holds arc ids that really leave / enter that vertex upwards
+    bool validLoaded() {
+        int n = vertexCount;
+        bool* seen = new bool[n];
+        for (int v = 0; v < n; v++) {
+            seen[v] = false;
+        }
+        bool valid = true;
+        for (int v = 0; v < n && valid; v++) {
+            if (rank[v] < 0 || rank[v] >= n || seen[rank[v]]) {
+                valid = false;
+            } else {
+                seen[rank[v]] = true;
+            }
+        }
+        delete[] seen;
+
+        for (int id = 0; id < arcCount && valid; id++) {
+            ChArc& arc = arcs[id];
+            if (arc.from < 0 || arc.from >= n || arc.to < 0 || arc.to >= n ||
+                !(arc.weight >= 0) || arc.weight >= GRAPH_MAX_DISTANCE) {
+                valid = false;
+            } else if (arc.childA == -1) {
+                valid = arc.childB == -1;
+            } else if (arc.childA < 0 || arc.childA >= arcCount || arc.childB < 0 || arc.childB >= arcCount) {
+                valid = false;
+            } else {
+                ChArc& first = arcs[arc.childA];
+                ChArc& second = arcs[arc.childB];
+                int middle = first.to;
+                valid = first.from == arc.from && second.to == arc.to && second.from == middle &&
+                        middle >= 0 && middle < n &&
+                        rank[middle] < rank[arc.from] && rank[middle] < rank[arc.to];
+            }
+        }
+
+        for (int v = 0; v < n && valid; v++) {
+            for (int i = upOffsets[v]; i < upOffsets[v + 1] && valid; i++) {
+                int id = upArcs[i];
+                valid = id >= 0 && id < arcCount && arcs[id].from == v && rank[arcs[id].to] > rank[v];
+            }
+            for (int i = downOffsets[v]; i < downOffsets[v + 1] && valid; i++) {
+                int id = downArcs[i];
+                valid = id >= 0 && id < arcCount && arcs[id].to == v && rank[arcs[id].from] > rank[v];
+            }
+        }
+        return valid;
+    }
+
+public:
+    ContractionHierarchy() {
+        vertexCount = 0;
+        arcs = nullptr;
+        arcCount = 0;
+        arcCapacity = 0;
+        originalArcCount = 0;
+        rank = nullptr;
+        upOffsets = nullptr;
+        upArcs = nullptr;
+        downOffsets = nullptr;
+        downArcs = nullptr;
+        source = nullptr;
+        sourceRevision = 0;
+        buildMillis = 0;
+        outArcs = nullptr;
+        inArcs = nullptr;
+        contracted = nullptr;
+        witnessDist = nullptr;
+        witnessStamp = nullptr;
+        witnessHandle = nullptr;
+        witnessEpoch = 0;
+        targetStamp = nullptr;
+        targetsLeft = 0;
+        witnessHeap = nullptr;
+    }
+
+    // ContractionHierarchy::build(graph)
+    // Time: roughly O(V * d^2 * witness) for average degree d - fine for road-like
+    //       networks, this is the one-off cost that makes queries cheap
+    // Space: O(V + E + shortcuts)
+    void build(Graph& graph) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        clearAll();
+        vertexCount = graph.getVertexCount();
+        int n = vertexCount;
+
+        outArcs = new ChArcList[n];
+        inArcs = new ChArcList[n];
+        contracted = new bool[n];
+        witnessDist = new double[n];
+        witnessStamp = new unsigned int[n];
+        witnessHandle = new HeapHandle[n];
+        targetStamp = new unsigned int[n];
+        witnessHeap = new IndexedHeap<int, double>(64);
+        witnessEpoch = 0;
+        rank = new int[n];
+        int* contractedNeighbours = new int[n];
+        for (int v = 0; v < n; v++) {
+            contracted[v] = false;
+            witnessStamp[v] = 0;
+            targetStamp[v] = 0;
+            contractedNeighbours[v] = 0;
+            rank[v] = -1;
+        }
+
+        // original edges (parallel edges collapse to the shortest, self loops are useless)
+        for (int v = 0; v < n; v++) {
+            graph.forEachEdge(v, [this, v](int dest, double weight) {
+                if (dest == v) {
+                    return;
+                }
+                int existing = findLiveArc(v, dest);
+                if (existing == -1) {
+                    addArc(v, dest, weight, -1, -1);
+                } else if (weight < arcs[existing].weight) {
+                    arcs[existing].weight = weight;
+                }
+            });
+        }
+        originalArcCount = arcCount;
+
+        // contraction order: lazy updates, a vertex is only contracted once its
+        // freshly computed importance is still the smallest
+        IndexedHeap<int, int> order(n);
+        for (int v = 0; v < n; v++) {
+            order.push(v, importance(v, contractedNeighbours));
+        }
+        ChArcList* upLists = new ChArcList[n];
+        ChArcList* downLists = new ChArcList[n];
+        int nextRank = 0;
+        while (!order.isEmpty()) {
+            int v = order.pop();
+            int current = importance(v, contractedNeighbours);
+            if (!order.isEmpty() && current > order.topPriority()) {
+                order.push(v, current);
+                continue;
+            }
+
+            rank[v] = nextRank++;
+            for (int i = 0; i < outArcs[v].count; i++) {
+                int id = outArcs[v].ids[i];
+                if (!contracted[arcs[id].to]) {
+                    upLists[v].add(id);
+                    contractedNeighbours[arcs[id].to]++;
+                }
+            }
+            for (int i = 0; i < inArcs[v].count; i++) {
+                int id = inArcs[v].ids[i];
+                if (!contracted[arcs[id].from]) {
+                    downLists[v].add(id);
+                    contractedNeighbours[arcs[id].from]++;
+                }
+            }
+            contract(v, true);
+            contracted[v] = true;
+            // neighbours forget v, so their lists only ever hold live arcs
+            for (int i = 0; i < upLists[v].count; i++) {
+                inArcs[arcs[upLists[v].ids[i]].to].remove(upLists[v].ids[i]);
+            }
+            for (int i = 0; i < downLists[v].count; i++) {
+                outArcs[arcs[downLists[v].ids[i]].from].remove(downLists[v].ids[i]);
+            }
+        }
+        buildSearchArrays(upLists, downLists);
+
+        delete[] upLists;
+        delete[] downLists;
+        delete[] contractedNeighbours;
+        delete[] outArcs;
+        delete[] inArcs;
+        delete[] contracted;
+        delete[] witnessDist;
+        delete[] witnessStamp;
+        delete[] witnessHandle;
+        delete[] targetStamp;
+        delete witnessHeap;
+        outArcs = nullptr;
+        inArcs = nullptr;
+        contracted = nullptr;
+        witnessDist = nullptr;
+        witnessStamp = nullptr;
+        witnessHandle = nullptr;
+        targetStamp = nullptr;
+        witnessHeap = nullptr;
+
+        source = &graph;
+        sourceRevision = graph.getRevision();
+        buildMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // true while the graph has not changed since build / load
+    bool isCurrentFor(Graph& graph) {
+        return source == &graph && sourceRevision == graph.getRevision();
+    }
+
+    // ContractionHierarchy::query(from, to)
+    // Time: O(s log s) where s = vertices above from / to in the hierarchy (small)
+    // Space: O(1) per query - per-thread workspace
+    // shortest distance, GRAPH_MAX_DISTANCE if unreachable; path via pathTo()
+    double query(int from, int to) {
+        ChQueryWorkspace& ws = chQueryWorkspace();
+        ws.begin(vertexCount);
+        ws.lastFrom = from;
+        ws.lastMeet = -1;
+        if (from < 0 || from >= vertexCount || to < 0 || to >= vertexCount) {
+            return GRAPH_MAX_DISTANCE;
+        }
+
+        ws.forwardStamp[from] = ws.epoch;
+        ws.forwardDist[from] = 0;
+        ws.forwardArc[from] = -1;
+        ws.forwardHandle[from] = ws.forwardHeap.push(from, 0);
+        ws.backwardStamp[to] = ws.epoch;
+        ws.backwardDist[to] = 0;
+        ws.backwardArc[to] = -1;
+        ws.backwardHandle[to] = ws.backwardHeap.push(to, 0);
+
+        double best = GRAPH_MAX_DISTANCE;
+        while (true) {
+            bool forwardLive = !ws.forwardHeap.isEmpty() && ws.forwardHeap.topPriority() < best;
+            bool backwardLive = !ws.backwardHeap.isEmpty() && ws.backwardHeap.topPriority() < best;
+            if (!forwardLive && !backwardLive) {
+                break;
+            }
+            bool forward = forwardLive &&
+                           (!backwardLive || ws.forwardHeap.topPriority() <= ws.backwardHeap.topPriority());
+
+            double* dist = forward ? ws.forwardDist : ws.backwardDist;
+            int* reachedBy = forward ? ws.forwardArc : ws.backwardArc;
+            HeapHandle* handle = forward ? ws.forwardHandle : ws.backwardHandle;
+            unsigned int* stamp = forward ? ws.forwardStamp : ws.backwardStamp;
+            unsigned int* otherStamp = forward ? ws.backwardStamp : ws.forwardStamp;
+            double* otherDist = forward ? ws.backwardDist : ws.forwardDist;
+            IndexedHeap<int, double>& heap = forward ? ws.forwardHeap : ws.backwardHeap;
+            int* offsets = forward ? upOffsets : downOffsets;
+            int* list = forward ? upArcs : downArcs;
+
+            int u = heap.pop();
+            handle[u] = NO_HEAP_HANDLE;
+            if (otherStamp[u] == ws.epoch && dist[u] + otherDist[u] < best) {
+                best = dist[u] + otherDist[u];
+                ws.lastMeet = u;
+            }
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                ChArc& arc = arcs[list[i]];
+                int next = forward ? arc.to : arc.from;
+                double candidate = dist[u] + arc.weight;
+                if (stamp[next] != ws.epoch) {
+                    stamp[next] = ws.epoch;
+                    dist[next] = candidate;
+                    reachedBy[next] = list[i];
+                    handle[next] = heap.push(next, candidate);
+                } else if (candidate < dist[next] && handle[next] != NO_HEAP_HANDLE) {
+                    dist[next] = candidate;
+                    reachedBy[next] = list[i];
+                    heap.update(handle[next], candidate);
+                }
+            }
+        }
+        return best;
+    }
+
+    // ContractionHierarchy::pathTo(length)
+    // Time: O(L) where L = vertices on the unpacked path
+    // Space: O(1) - written into the thread's workspace
+    // original vertices of the last query's path in travel order (length 0 if none);
+    // valid until the next query on this thread
+    const int* pathTo(int& length) {
+        length = 0;
+        ChQueryWorkspace& ws = chQueryWorkspace();
+        if (ws.lastMeet == -1) {
+            return nullptr;
+        }
+        int lastMeet = ws.lastMeet;
+        int top = 0;
+
+        // top-level arcs in travel order: forward half (collected back to front), then backward half
+        int* order = ws.path;   // scratch: arc ids, overwritten by vertices below
+        int count = 0;
+        for (int v = lastMeet; ws.forwardArc[v] != -1; v = arcs[ws.forwardArc[v]].from) {
+            count++;
+        }
+        int position = count;
+        for (int v = lastMeet; ws.forwardArc[v] != -1; v = arcs[ws.forwardArc[v]].from) {
+            order[--position] = ws.forwardArc[v];
+        }
+        for (int v = lastMeet; ws.backwardArc[v] != -1; v = arcs[ws.backwardArc[v]].to) {
+            order[count++] = ws.backwardArc[v];
+        }
+        // the stack holds them reversed so they unpack front to back
+        for (int i = count - 1; i >= 0; i--) {
+            ws.pushStack(top, order[i]);
+        }
+
+        ws.path[length++] = ws.lastFrom;
+        while (top > 0) {
+            int id = ws.stack[--top];
+            if (arcs[id].childA == -1) {
+                ws.path[length++] = arcs[id].to;
+            } else {
+                ws.pushStack(top, arcs[id].childB);
+                ws.pushStack(top, arcs[id].childA);
+            }
+        }
+        return ws.path;
+    }
+
+    // ContractionHierarchy::save(fileName)
+    // Time: O(V + arcs)
+    // Space: O(1)
+    bool save(const char* fileName) {
+        if (source == nullptr) {
+            return false;
+        }
+        ofstream file(fileName, ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        unsigned long long signature = graphSignature(*const_cast<Graph*>(source));
+        file.write("ISBCH1\n", 8);
+        file.write((const char*)&vertexCount, sizeof(int));
+        file.write((const char*)&signature, sizeof(signature));
+        file.write((const char*)&arcCount, sizeof(int));
+        file.write((const char*)&originalArcCount, sizeof(int));
+        file.write((const char*)arcs, sizeof(ChArc) * arcCount);
+        file.write((const char*)rank, sizeof(int) * vertexCount);
+        file.write((const char*)upOffsets, sizeof(int) * (vertexCount + 1));
+        file.write((const char*)upArcs, sizeof(int) * upOffsets[vertexCount]);
+        file.write((const char*)downOffsets, sizeof(int) * (vertexCount + 1));
+        file.write((const char*)downArcs, sizeof(int) * downOffsets[vertexCount]);
+        return file.good();
+    }
+
+    // ContractionHierarchy::load(fileName, graph)
+    // Time: O(V + E + arcs) - includes the signature check against graph
+    // Space: O(V + arcs)
+    // false (and nothing loaded) if the file is missing, damaged or for another network;
+    // sizes are checked against the file before anything is allocated and the
+    // structure is checked by validLoaded() before the hierarchy is used
+    bool load(const char* fileName, Graph& graph) {
+        ifstream file(fileName, ios::binary | ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        long long fileSize = (long long)file.tellg();
+        file.seekg(0);
+        char magic[8];
+        int n = 0;
+        unsigned long long signature = 0;
+        int count = 0;
+        int originals = 0;
+        file.read(magic, 8);
+        file.read((char*)&n, sizeof(int));
+        file.read((char*)&signature, sizeof(signature));
+        file.read((char*)&count, sizeof(int));
+        file.read((char*)&originals, sizeof(int));
+        if (!file.good() || stringCompare(magic, "ISBCH1\n") != 0 ||
+            n != graph.getVertexCount() || signature != graphSignature(graph) ||
+            count < 0 || originals < 0 || originals > count) {
+            return false;
+        }
+        // arcs, rank and both offset arrays must all still be in the file
+        long long needed = (long long)sizeof(ChArc) * count + (long long)sizeof(int) * (3LL * n + 2);
+        if (needed > fileSize - (long long)file.tellg()) {
+            return false;
+        }
+
+        clearAll();
+        vertexCount = n;
+        arcCount = count;
+        arcCapacity = count > 0 ? count : 1;
+        originalArcCount = originals;
+        arcs = new ChArc[arcCapacity];
+        rank = new int[n];
+        upOffsets = new int[n + 1];
+        downOffsets = new int[n + 1];
+        file.read((char*)arcs, sizeof(ChArc) * count);
+        file.read((char*)rank, sizeof(int) * n);
+        file.read((char*)upOffsets, sizeof(int) * (n + 1));
+        if (!file.good() || !validOffsets(upOffsets, n, count)) {
+            clearAll();
+            return false;
+        }
+        int upCount = upOffsets[n];
+        upArcs = new int[upCount > 0 ? upCount : 1];
+        file.read((char*)upArcs, sizeof(int) * upCount);
+        file.read((char*)downOffsets, sizeof(int) * (n + 1));
+        if (!file.good() || !validOffsets(downOffsets, n, count)) {
+            clearAll();
+            return false;
+        }
+        int downCount = downOffsets[n];
+        downArcs = new int[downCount > 0 ? downCount : 1];
+        file.read((char*)downArcs, sizeof(int) * downCount);
+        if (!file.good() || !validLoaded()) {
+            clearAll();
+            return false;
+        }
+        source = &graph;
+        sourceRevision = graph.getRevision();
+        buildMillis = 0;
+        return true;
+    }
+
+    // ========== STATS ==========
+    double getBuildMillis() { return buildMillis; }
+    int getOriginalArcCount() { return originalArcCount; }
+    int getShortcutCount() { return arcCount - originalArcCount; }
+
+    // bytes held by the arc table and the search arrays
+    long long getMemoryBytes() {
+        if (upOffsets == nullptr) {
+            return 0;
+        }
+        return (long long)sizeof(ChArc) * arcCount +
+               (long long)sizeof(int) * (vertexCount + 2 * (vertexCount + 1)) +
+               (long long)sizeof(int) * (upOffsets[vertexCount] + downOffsets[vertexCount]);
+    }
+
+    ~ContractionHierarchy() {
+        clearAll();
+    }
+};
+
+#endif
@@ -2,8 +2,8 @@
 #define EDUCATIONSECTOR_H
 
 #include "Tree.h"
-#include "HashTable.h"
-#include "MinHeap.h"
+#include "HashMap.h"
+#include "SectorRegistry.h"
 #include "Utils.h"
 #include <iostream>
 using namespace std;
@@ -46,7 +46,7 @@ struct Faculty {
 struct School {
     char schoolID[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     double rating;
     char subjects[200];
     Tree* organizationTree;  
@@ -54,12 +54,38 @@ struct School {
     School() {
         schoolID[0] = '\0';
         name[0] = '\0';
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
         rating = 0.0;
         subjects[0] = '\0';
         organizationTree = new Tree();
     }
     
+    // move-only: the organization tree is owned, so it is handed over instead of copied
+    School(School&& other) {
+        stringCopy(schoolID, other.schoolID);
+        stringCopy(name, other.name);
+        sectorId = other.sectorId;
+        rating = other.rating;
+        stringCopy(subjects, other.subjects);
+        organizationTree = other.organizationTree;
+        other.organizationTree = nullptr;
+    }
+    
+    School& operator=(School&& other) {
+        stringCopy(schoolID, other.schoolID);
+        stringCopy(name, other.name);
+        sectorId = other.sectorId;
+        rating = other.rating;
+        stringCopy(subjects, other.subjects);
+        Tree* temp = organizationTree;
+        organizationTree = other.organizationTree;
+        other.organizationTree = temp;   // other's destructor frees our old tree
+        return *this;
+    }
+    
+    School(const School&) = delete;
+    School& operator=(const School&) = delete;
+    
     ~School() {
         delete organizationTree;
     }
@@ -68,20 +94,18 @@ struct School {
 // education system class
 class EducationSystem {
 private:
-    HashTable* schoolTable;
-    HashTable* facultyTable;
-    HashTable* studentTable;
-    MinHeap* schoolRanking;
+    HashMap<StringView, School>* schoolTable;
+    HashMap<StringView, Faculty>* facultyTable;
+    HashMap<StringView, Student>* studentTable;
     int schoolCount;
     int facultyCount;
     int studentCount;
 
 public:
     EducationSystem() {
-        schoolTable = new HashTable(50);
-        facultyTable = new HashTable(100);
-        studentTable = new HashTable(500);
-        schoolRanking = new MinHeap(50);
+        schoolTable = new HashMap<StringView, School>(50);
+        facultyTable = new HashMap<StringView, Faculty>(100);
+        studentTable = new HashMap<StringView, Student>(500);
         schoolCount = 0;
         facultyCount = 0;
         studentCount = 0;
@@ -90,20 +114,17 @@ public:
     // registering school
     void registerSchool(const char* schoolID, const char* name, const char* sector, 
                        double rating, const char* subjects) {
-        School* school = new School();
-        stringCopyN(school->schoolID, schoolID, 50);
-        stringCopyN(school->name, name, 100);
-        stringCopyN(school->sector, sector, 50);
-        school->rating = rating;
-        stringCopyN(school->subjects, subjects, 200);
+        School school;
+        stringCopyN(school.schoolID, schoolID, 50);
+        stringCopyN(school.name, name, 100);
+        school.sectorId = internSector(sector);
+        school.rating = rating;
+        stringCopyN(school.subjects, subjects, 200);
         
         // initialize school tree with root
-        school->organizationTree->setRoot(0, name);
-        
-        schoolTable->insert(schoolID, school);
+        school.organizationTree->setRoot(0, name);
         
-        // add to ranking (using negative rating for min heap)
-        schoolTable->insert(schoolID, school);
+        schoolTable->insert(schoolID, std::move(school));
         schoolCount++;
         
         // School registered (quiet mode)
@@ -121,7 +142,7 @@ public:
     
     // add department to school
     void addDepartment(const char* schoolID, const char* deptName) {
-        School* school = (School*)schoolTable->search(schoolID);
+        School* school = schoolTable->search(schoolID);
         if (school == nullptr) {
             cout << "School not found!" << endl;
             return;
@@ -133,7 +154,7 @@ public:
     
     // add class to department
     void addClass(const char* schoolID, const char* deptName, const char* className) {
-        School* school = (School*)schoolTable->search(schoolID);
+        School* school = schoolTable->search(schoolID);
         if (school == nullptr) {
             cout << "School not found!" << endl;
             return;
@@ -146,13 +167,13 @@ public:
     // register faculty
     void registerFaculty(const char* facultyID, const char* name, 
                         const char* department, const char* subject) {
-        Faculty* faculty = new Faculty();
-        stringCopyN(faculty->facultyID, facultyID, 50);
-        stringCopyN(faculty->name, name, 100);
-        stringCopyN(faculty->department, department, 100);
-        stringCopyN(faculty->subject, subject, 100);
+        Faculty faculty;
+        stringCopyN(faculty.facultyID, facultyID, 50);
+        stringCopyN(faculty.name, name, 100);
+        stringCopyN(faculty.department, department, 100);
+        stringCopyN(faculty.subject, subject, 100);
         
-        facultyTable->insert(facultyID, faculty);
+        facultyTable->insert(facultyID, std::move(faculty));
         facultyCount++;
         cout << "Registered faculty: " << name << endl;
     }
@@ -160,22 +181,22 @@ public:
     // register student
     void registerStudent(const char* studentID, const char* name, const char* cnic,
                         const char* schoolID, int age, const char* className) {
-        Student* student = new Student();
-        stringCopyN(student->studentID, studentID, 50);
-        stringCopyN(student->name, name, 100);
-        stringCopyN(student->cnic, cnic, 20);
-        stringCopyN(student->schoolID, schoolID, 50);
-        student->age = age;
-        stringCopyN(student->className, className, 50);
-        
-        studentTable->insert(studentID, student);
+        Student student;
+        stringCopyN(student.studentID, studentID, 50);
+        stringCopyN(student.name, name, 100);
+        stringCopyN(student.cnic, cnic, 20);
+        stringCopyN(student.schoolID, schoolID, 50);
+        student.age = age;
+        stringCopyN(student.className, className, 50);
+        
+        studentTable->insert(studentID, std::move(student));
         studentCount++;
         cout << "Registered student: " << name << endl;
     }
     
     // display school details
     void displaySchool(const char* schoolID) {
-        School* school = (School*)schoolTable->search(schoolID);
+        School* school = schoolTable->search(schoolID);
         if (school == nullptr) {
             cout << "School not found!" << endl;
             return;
@@ -184,7 +205,7 @@ public:
         cout << "\n--- School Details ---" << endl;
         cout << "School ID: " << school->schoolID << endl;
         cout << "Name: " << school->name << endl;
-        cout << "Sector: " << school->sector << endl;
+        cout << "Sector: " << sectorName(school->sectorId) << endl;
         cout << "Rating: " << school->rating << endl;
         cout << "Subjects: " << school->subjects << endl;
         
@@ -199,23 +220,22 @@ public:
         cout << "Total Faculty: " << facultyCount << endl;
         cout << "Total Students: " << studentCount << endl;
         
-        char** schoolKeys = new char*[100];
-        int count;
-        schoolTable->getAllKeys(schoolKeys, &count);
+        int count = schoolTable->getCount();
         
         if (count == 0) {
             cout << "\n[INFO] No schools registered yet." << endl;
         } else {
             cout << "\nRegistered Schools: ";
-            for (int i = 0; i < count; i++) {
-                cout << schoolKeys[i];
+            int i = 0;
+            for (auto& entry : *schoolTable) {
+                cout << entry.key.data;
                 if (i < count - 1) cout << ", ";
+                i++;
             }
             cout << endl;
             cout << "Use 'Display school details' to see individual school info" << endl;
         }
         
-        delete[] schoolKeys;
         cout << "==========================================" << endl;
     }
     
@@ -223,27 +243,29 @@ public:
     void displaySchoolRankings() {
         cout << "\n========== SCHOOL RANKINGS ==========" << endl;
         
-        char** schoolKeys = new char*[100];
-        int count;
-        schoolTable->getAllKeys(schoolKeys, &count);
+        int count = schoolTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No schools registered yet." << endl;
-            delete[] schoolKeys;
             return;
         }
         
+        // collect the records once, then sort the pointers (no re-search per compare)
+        School** schools = new School*[count];
+        int n = 0;
+        for (auto& entry : *schoolTable) {
+            schools[n] = &entry.value;
+            n++;
+        }
+        
         // Simple bubble sort by rating (descending)
         for (int i = 0; i < count - 1; i++) {
             for (int j = 0; j < count - i - 1; j++) {
-                School* school1 = (School*)schoolTable->search(schoolKeys[j]);
-                School* school2 = (School*)schoolTable->search(schoolKeys[j + 1]);
-                
-                if (school1 && school2 && school1->rating < school2->rating) {
-                    // Swap keys
-                    char* temp = schoolKeys[j];
-                    schoolKeys[j] = schoolKeys[j + 1];
-                    schoolKeys[j + 1] = temp;
+                if (schools[j]->rating < schools[j + 1]->rating) {
+                    // Swap pointers
+                    School* temp = schools[j];
+                    schools[j] = schools[j + 1];
+                    schools[j + 1] = temp;
                 }
             }
         }
@@ -253,26 +275,24 @@ public:
         cout << "-----+-------------------------+--------+--------" << endl;
         
         for (int i = 0; i < count; i++) {
-            School* school = (School*)schoolTable->search(schoolKeys[i]);
-            if (school != nullptr) {
-                cout << " " << (i + 1) << "   | ";
-                cout << school->name;
-                
-                // Padding for name (25 chars)
-                int nameLen = stringLength(school->name);
-                for (int k = nameLen; k < 24; k++) cout << " ";
-                
-                cout << " | " << school->sector;
-                
-                // Padding for sector (6 chars)
-                int sectorLen = stringLength(school->sector);
-                for (int k = sectorLen; k < 6; k++) cout << " ";
-                
-                cout << " | " << school->rating << "/5.0" << endl;
-            }
+            School* school = schools[i];
+            cout << " " << (i + 1) << "   | ";
+            cout << school->name;
+            
+            // Padding for name (25 chars)
+            int nameLen = stringLength(school->name);
+            for (int k = nameLen; k < 24; k++) cout << " ";
+            
+            cout << " | " << sectorName(school->sectorId);
+            
+            // Padding for sector (6 chars)
+            int sectorLen = stringLength(sectorName(school->sectorId));
+            for (int k = sectorLen; k < 6; k++) cout << " ";
+            
+            cout << " | " << school->rating << "/5.0" << endl;
         }
         
-        delete[] schoolKeys;
+        delete[] schools;
         cout << "=====================================" << endl;
     }
     
@@ -401,25 +421,20 @@ public:
             return;
         }
         
-        char** keys = new char*[1000];
-        int count;
-        studentTable->getAllKeys(keys, &count);
-        
         cout << "\n";
-        for (int i = 0; i < count; i++) {
-            Student* student = (Student*)studentTable->search(keys[i]);
-            if (student != nullptr) {
-                cout << "[" << (i+1) << "] " << student->name << endl;
-                cout << "    ID: " << student->studentID << endl;
-                cout << "    CNIC: " << student->cnic << endl;
-                cout << "    School: " << student->schoolID << endl;
-                cout << "    Age: " << student->age << endl;
-                cout << "    Class: " << student->className << endl;
-                cout << endl;
-            }
+        int i = 0;
+        for (auto& entry : *studentTable) {
+            Student* student = &entry.value;
+            cout << "[" << (i+1) << "] " << student->name << endl;
+            cout << "    ID: " << student->studentID << endl;
+            cout << "    CNIC: " << student->cnic << endl;
+            cout << "    School: " << student->schoolID << endl;
+            cout << "    Age: " << student->age << endl;
+            cout << "    Class: " << student->className << endl;
+            cout << endl;
+            i++;
         }
         
-        delete[] keys;
         cout << "=====================================" << endl;
     }
     
@@ -432,50 +447,41 @@ public:
         cin.getline(subject, 100);
         toUpperCase(subject);
         
-        // Get all school keys
-        char** schoolKeys = new char*[100];
-        int count;
-        schoolTable->getAllKeys(schoolKeys, &count);
-        
         bool found = false;
         cout << "\n--- Schools Offering " << subject << " ---" << endl;
         
-        for (int i = 0; i < count; i++) {
-            School* school = (School*)schoolTable->search(schoolKeys[i]);
-            if (school != nullptr) {
-                // Convert subjects to uppercase for comparison
-                char upperSubjects[200];
-                stringCopy(upperSubjects, school->subjects);
-                toUpperCase(upperSubjects);
-                
-                // Simple substring search
-                bool hasSubject = false;
-                int subjLen = stringLength(subject);
-                int fullLen = stringLength(upperSubjects);
-                for (int j = 0; j <= fullLen - subjLen; j++) {
-                    bool match = true;
-                    for (int k = 0; k < subjLen; k++) {
-                        if (upperSubjects[j + k] != subject[k]) {
-                            match = false;
-                            break;
-                        }
-                    }
-                    if (match) {
-                        hasSubject = true;
+        for (auto& entry : *schoolTable) {
+            School* school = &entry.value;
+            // Convert subjects to uppercase for comparison
+            char upperSubjects[200];
+            stringCopy(upperSubjects, school->subjects);
+            toUpperCase(upperSubjects);
+            
+            // Simple substring search
+            bool hasSubject = false;
+            int subjLen = stringLength(subject);
+            int fullLen = stringLength(upperSubjects);
+            for (int j = 0; j <= fullLen - subjLen; j++) {
+                bool match = true;
+                for (int k = 0; k < subjLen; k++) {
+                    if (upperSubjects[j + k] != subject[k]) {
+                        match = false;
                         break;
                     }
                 }
-                
-                if (hasSubject) {
-                    cout << "  - " << school->name << " (" << school->sector << ")" << endl;
-                    cout << "    Rating: " << school->rating << "/5.0" << endl;
-                    found = true;
+                if (match) {
+                    hasSubject = true;
+                    break;
                 }
             }
+            
+            if (hasSubject) {
+                cout << "  - " << school->name << " (" << sectorName(school->sectorId) << ")" << endl;
+                cout << "    Rating: " << school->rating << "/5.0" << endl;
+                found = true;
+            }
         }
         
-        delete[] schoolKeys;
-        
         if (!found) {
             cout << "[INFO] No schools found offering this subject." << endl;
         }
@@ -489,39 +495,28 @@ public:
         cout << "Enter your sector (e.g., G-10): ";
         cin >> userSector;
         normalizeInput(userSector);
+        SectorId userSectorId = findSector(userSector);   // resolved once, loop compares ints
         
         // Get all schools
-        char** schoolKeys = new char*[100];
-        int count;
-        schoolTable->getAllKeys(schoolKeys, &count);
+        int count = schoolTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No schools registered yet." << endl;
-            delete[] schoolKeys;
             return;
         }
         
         bool found = false;
         cout << "\n--- Schools in Your Sector ---" << endl;
         
-        for (int i = 0; i < count; i++) {
-            School* school = (School*)schoolTable->search(schoolKeys[i]);
-            if (school != nullptr) {
-                // Case-insensitive comparison
-                char schoolSector[50];
-                stringCopy(schoolSector, school->sector);
-                normalizeInput(schoolSector);
-                
-                if (stringCompare(schoolSector, userSector) == 0) {
-                    cout << "  - " << school->name << endl;
-                    cout << "    Rating: " << school->rating << "/5.0" << endl;
-                    found = true;
-                }
+        for (auto& entry : *schoolTable) {
+            School* school = &entry.value;
+            if (userSectorId != NO_SECTOR && school->sectorId == userSectorId) {
+                cout << "  - " << school->name << endl;
+                cout << "    Rating: " << school->rating << "/5.0" << endl;
+                found = true;
             }
         }
         
-        delete[] schoolKeys;
-        
         if (!found) {
             cout << "[INFO] No schools found in your sector." << endl;
         }
@@ -530,20 +525,21 @@ public:
     // ========== VISUALIZATION HELPER METHODS ==========
     
     // Get all school keys for visualization
-    void getSchoolKeys(char** keys, int* count) {
-        schoolTable->getAllKeys(keys, count);
+    // visit(School&) for every school, straight from the table storage
+    template <typename Visitor>
+    void forEachSchool(Visitor visit) {
+        schoolTable->forEach([&visit](const StringView&, School& school) { visit(school); });
     }
     
     // Get school by ID
     School* getSchool(const char* schoolID) {
-        return (School*)schoolTable->search(schoolID);
+        return schoolTable->search(schoolID);
     }
     
     ~EducationSystem() {
         delete schoolTable;
         delete facultyTable;
         delete studentTable;
-        delete schoolRanking;
     }
 };
 
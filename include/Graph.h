@@ -2,6 +2,12 @@
 #define GRAPH_H
 
 #include "String.h"
+#include "Arena.h"
+#include "HashMap.h"
+#include "IndexedHeap.h"
+#include "Parallel.h"
+#include <atomic>
+#include <cmath>
 #include <iostream>
 using namespace std;
 
@@ -10,6 +16,19 @@ using namespace std;
 // Using a large but safe value instead of platform-specific DBL_MAX
 const double GRAPH_MAX_DISTANCE = 1.0e+300;
 
+// edge changes a graph remembers for incremental shortest path repair
+const int GRAPH_EDGE_LOG_SIZE = 64;
+
+// Graph::kShortestPaths keeps exact distances-to-target up to this multiple of the
+// shortest route (1 = the area a plain point-to-point query would search); detours
+// reaching further out are guided by a weaker bound
+const double GRAPH_ALTERNATIVE_REACH = 1.0;
+
+// Graph::getBetweenness is exact up to this many vertices, sampled from
+// GRAPH_BETWEENNESS_SAMPLES sources beyond it
+const int GRAPH_EXACT_BETWEENNESS = 2000;
+const int GRAPH_BETWEENNESS_SAMPLES = 256;
+
 
 // edge structure for adjacency list
 struct Edge {
@@ -25,6 +44,7 @@ struct Edge {
 };
 
 // vertex structure
+// name and edges are owned by the graph's arena, so a vertex frees nothing itself
 struct Vertex {
     char* name;
     double latitude;
@@ -38,94 +58,996 @@ struct Vertex {
         edges = nullptr;
     }
     
-    void init(const char* n, double lat, double lon) {
-        int len = stringLength(n);
-        name = new char[len + 1];
-        stringCopy(name, n);
+    void init(const char* n, double lat, double lon, CityArena* arena) {
+        name = arena->copyString(n);
         latitude = lat;
         longitude = lon;
         edges = nullptr;
     }
+};
+
+// one logged change of the (shortest) weight between an ordered vertex pair;
+// GRAPH_MAX_DISTANCE stands for "no edge", so an insert is a decrease from it
+// and a removal an increase to it
+struct EdgeChange {
+    int source;
+    int dest;
+    double oldWeight;
+    double newWeight;
+};
+
+// ========== SHORTEST PATH WORKSPACE ==========
+// scratch arrays for one shortest path query, kept per thread and reused by every
+// query on that thread, so a query allocates nothing once the arrays are big enough.
+// nothing is cleared between queries: a vertex only counts as reached when its
+// stamp equals the current epoch, and starting a query just bumps the epoch
+struct ShortestPathWorkspace {
+    double* distance;
+    int* previous;
+    HeapHandle* handle;         // frontier entry, NO_HEAP_HANDLE once settled
+    unsigned int* stamp;        // epoch in which the vertex was last reached
+    int* path;                  // last path handed out by Graph::pathTo
+    int* settledOrder;          // last set handed out by Graph::reachableWithin
+    int capacity;
+    unsigned int epoch;
+    const void* owner;          // graph the current results belong to
+    IndexedHeap<int, double> frontier;
+    
+    ShortestPathWorkspace() {
+        distance = nullptr;
+        previous = nullptr;
+        handle = nullptr;
+        stamp = nullptr;
+        path = nullptr;
+        settledOrder = nullptr;
+        capacity = 0;
+        epoch = 0;
+        owner = nullptr;
+    }
     
-    ~Vertex() {
-        if (name != nullptr) {
-            delete[] name;
+    // ShortestPathWorkspace::begin(graph, vertexCount)
+    // Time: O(1), O(V) only when the arrays grow or the epoch counter wraps
+    // Space: O(V) on growth
+    void begin(const void* graph, int vertexCount) {
+        if (vertexCount > capacity) {
+            int newCapacity = capacity > 0 ? capacity : 64;
+            while (newCapacity < vertexCount) {
+                newCapacity = newCapacity * 2;
+            }
+            delete[] distance;
+            delete[] previous;
+            delete[] handle;
+            delete[] stamp;
+            delete[] path;
+            delete[] settledOrder;
+            distance = new double[newCapacity];
+            previous = new int[newCapacity];
+            handle = new HeapHandle[newCapacity];
+            stamp = new unsigned int[newCapacity];
+            path = new int[newCapacity];
+            settledOrder = new int[newCapacity];
+            for (int i = 0; i < newCapacity; i++) {
+                stamp[i] = 0;
+            }
+            capacity = newCapacity;
+            epoch = 0;
         }
-        while (edges != nullptr) {
-            Edge* temp = edges;
-            edges = edges->next;
-            delete temp;
+        epoch++;
+        if (epoch == 0) {   // wrapped: old stamps could look current again
+            for (int i = 0; i < capacity; i++) {
+                stamp[i] = 0;
+            }
+            epoch = 1;
         }
+        frontier.clear();
+        owner = graph;
+    }
+    
+    bool reached(int v) {
+        return stamp[v] == epoch;
+    }
+    
+    // first time v is seen in this query
+    void reach(int v, double dist, int from) {
+        stamp[v] = epoch;
+        distance[v] = dist;
+        previous[v] = from;
+        handle[v] = NO_HEAP_HANDLE;
+    }
+    
+    ~ShortestPathWorkspace() {
+        delete[] distance;
+        delete[] previous;
+        delete[] handle;
+        delete[] stamp;
+        delete[] path;
+        delete[] settledOrder;
     }
 };
 
+// shortestPathWorkspace()
+// Time: O(1)
+// Space: O(V) per thread that runs queries
+ShortestPathWorkspace& shortestPathWorkspace() {
+    static thread_local ShortestPathWorkspace workspace;
+    return workspace;
+}
+
+// ========== PATH SET ==========
+// several routes between the same two vertices, kept in one flat vertex array:
+// route i is vertices[start[i] .. start[i] + length[i]), with the running cost at
+// every vertex in along[]. storage is kept between uses, so reusing one PathSet for
+// every dispatch allocates nothing once it is big enough
+class PathSet {
+private:
+    struct Entry {
+        int start;
+        int length;
+        int deviation;      // first position where the route leaves its parent (Yen / Lawler)
+        double cost;
+    };
+
+    Entry* entries;
+    int count;
+    int entryCapacity;
+    int* vertices;
+    double* along;
+    int used;
+    int vertexCapacity;
+
+    PathSet(const PathSet&);
+    PathSet& operator=(const PathSet&);
+
+    // PathSet::reserve(extraVertices)
+    // Time: O(n) when the storage doubles - amortized O(1) per vertex
+    // Space: O(n)
+    void reserve(int extraVertices) {
+        if (count == entryCapacity) {
+            int newCapacity = entryCapacity * 2;
+            Entry* newEntries = new Entry[newCapacity];
+            for (int i = 0; i < count; i++) {
+                newEntries[i] = entries[i];
+            }
+            delete[] entries;
+            entries = newEntries;
+            entryCapacity = newCapacity;
+        }
+        if (used + extraVertices > vertexCapacity) {
+            int newCapacity = vertexCapacity * 2;
+            while (newCapacity < used + extraVertices) {
+                newCapacity = newCapacity * 2;
+            }
+            int* newVertices = new int[newCapacity];
+            double* newAlong = new double[newCapacity];
+            for (int i = 0; i < used; i++) {
+                newVertices[i] = vertices[i];
+                newAlong[i] = along[i];
+            }
+            delete[] vertices;
+            delete[] along;
+            vertices = newVertices;
+            along = newAlong;
+            vertexCapacity = newCapacity;
+        }
+    }
+
+public:
+    PathSet() {
+        entryCapacity = 4;
+        entries = new Entry[entryCapacity];
+        vertexCapacity = 64;
+        vertices = new int[vertexCapacity];
+        along = new double[vertexCapacity];
+        count = 0;
+        used = 0;
+    }
+
+    // PathSet::add(path, costs, length, deviation)
+    // Time: O(L) amortized
+    // Space: O(L)
+    // costs[i] is the running cost at path[i]; the route's cost is the last one
+    void add(const int* path, const double* costs, int length, int deviation) {
+        reserve(length);
+        Entry& entry = entries[count++];
+        entry.start = used;
+        entry.length = length;
+        entry.deviation = deviation;
+        entry.cost = length > 0 ? costs[length - 1] : 0;
+        for (int i = 0; i < length; i++) {
+            vertices[used + i] = path[i];
+            along[used + i] = costs[i];
+        }
+        used += length;
+    }
+
+    // PathSet::remove(i)
+    // Time: O(1) - the last route takes its place, its vertices stay until clear()
+    // Space: O(1)
+    void remove(int i) {
+        if (i < 0 || i >= count) {
+            return;
+        }
+        entries[i] = entries[--count];
+        if (count == 0) {
+            used = 0;
+        }
+    }
+
+    // PathSet::contains(path, length)
+    // Time: O(n * L)
+    // Space: O(1)
+    bool contains(const int* path, int length) {
+        for (int i = 0; i < count; i++) {
+            if (entries[i].length != length) {
+                continue;
+            }
+            const int* other = vertices + entries[i].start;
+            int position = 0;
+            while (position < length && other[position] == path[position]) {
+                position++;
+            }
+            if (position == length) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // PathSet::cheapest()
+    // Time: O(n)
+    // Space: O(1)
+    // index of the lowest cost route (fewest vertices on ties), -1 if empty
+    int cheapest() {
+        int best = -1;
+        for (int i = 0; i < count; i++) {
+            if (best == -1 || entries[i].cost < entries[best].cost ||
+                (entries[i].cost == entries[best].cost && entries[i].length < entries[best].length)) {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // vertices of route i in travel order (nullptr / 0 if out of range)
+    const int* path(int i, int& length) {
+        if (i < 0 || i >= count) {
+            length = 0;
+            return nullptr;
+        }
+        length = entries[i].length;
+        return vertices + entries[i].start;
+    }
+
+    // running costs along route i, parallel to path(i)
+    const double* costs(int i) {
+        return i >= 0 && i < count ? along + entries[i].start : nullptr;
+    }
+
+    double cost(int i) { return i >= 0 && i < count ? entries[i].cost : GRAPH_MAX_DISTANCE; }
+    int deviation(int i) { return i >= 0 && i < count ? entries[i].deviation : 0; }
+    int size() { return count; }
+
+    void clear() {
+        count = 0;
+        used = 0;
+    }
+
+    ~PathSet() {
+        delete[] entries;
+        delete[] vertices;
+        delete[] along;
+    }
+};
+
+// ========== ALTERNATIVE ROUTE WORKSPACE ==========
+// per-thread scratch for Graph::kShortestPaths, next to the shortest path workspace
+// that its spur searches run in. one epoch counter serves both kinds of stamp:
+//  - toTarget / nextHop are valid where targetStamp == the query's epoch
+//  - a vertex or spur edge is blocked where its stamp == the current spur's epoch
+struct AlternativeRouteWorkspace {
+    double* toTarget;           // distance to the target in the unmodified graph
+    int* nextHop;               // next vertex toward the target (reverse search tree)
+    unsigned int* targetStamp;
+    unsigned int* blockedVertex;
+    unsigned int* blockedSpurEdge;  // edge spur -> v is blocked
+    unsigned int* chainClear;   // v's reverse tree chain avoids everything blocked this spur
+    unsigned int* chainBlocked; // ... or runs into something blocked
+    int* route;                 // candidate being assembled
+    double* routeCosts;
+    int capacity;
+    unsigned int epoch;
+    PathSet candidates;
+
+    AlternativeRouteWorkspace() {
+        toTarget = nullptr;
+        nextHop = nullptr;
+        targetStamp = nullptr;
+        blockedVertex = nullptr;
+        blockedSpurEdge = nullptr;
+        chainClear = nullptr;
+        chainBlocked = nullptr;
+        route = nullptr;
+        routeCosts = nullptr;
+        capacity = 0;
+        epoch = 0;
+    }
+
+    // AlternativeRouteWorkspace::nextEpoch(vertexCount)
+    // Time: O(1), O(V) only when the arrays grow or the counter wraps
+    // Space: O(V) on growth
+    unsigned int nextEpoch(int vertexCount) {
+        if (vertexCount > capacity) {
+            int newCapacity = capacity > 0 ? capacity : 64;
+            while (newCapacity < vertexCount) {
+                newCapacity = newCapacity * 2;
+            }
+            delete[] toTarget;
+            delete[] nextHop;
+            delete[] targetStamp;
+            delete[] blockedVertex;
+            delete[] blockedSpurEdge;
+            delete[] chainClear;
+            delete[] chainBlocked;
+            delete[] route;
+            delete[] routeCosts;
+            toTarget = new double[newCapacity];
+            nextHop = new int[newCapacity];
+            targetStamp = new unsigned int[newCapacity];
+            blockedVertex = new unsigned int[newCapacity];
+            blockedSpurEdge = new unsigned int[newCapacity];
+            chainClear = new unsigned int[newCapacity];
+            chainBlocked = new unsigned int[newCapacity];
+            route = new int[newCapacity];
+            routeCosts = new double[newCapacity];
+            for (int i = 0; i < newCapacity; i++) {
+                targetStamp[i] = 0;
+                blockedVertex[i] = 0;
+                blockedSpurEdge[i] = 0;
+                chainClear[i] = 0;
+                chainBlocked[i] = 0;
+            }
+            capacity = newCapacity;
+            epoch = 0;
+        }
+        epoch++;
+        if (epoch == 0) {   // wrapped: old stamps could look current again
+            for (int i = 0; i < capacity; i++) {
+                targetStamp[i] = 0;
+                blockedVertex[i] = 0;
+                blockedSpurEdge[i] = 0;
+                chainClear[i] = 0;
+                chainBlocked[i] = 0;
+            }
+            epoch = 1;
+        }
+        return epoch;
+    }
+
+    ~AlternativeRouteWorkspace() {
+        delete[] toTarget;
+        delete[] nextHop;
+        delete[] targetStamp;
+        delete[] blockedVertex;
+        delete[] blockedSpurEdge;
+        delete[] chainClear;
+        delete[] chainBlocked;
+        delete[] route;
+        delete[] routeCosts;
+    }
+};
+
+// alternativeRouteWorkspace()
+// Time: O(1)
+// Space: O(V) per thread that asks for alternatives
+AlternativeRouteWorkspace& alternativeRouteWorkspace() {
+    static thread_local AlternativeRouteWorkspace workspace;
+    return workspace;
+}
+
 // graph with adjacency list (no templates)
+// edges are added to per-vertex linked lists; before the first query the lists are
+// frozen into CSR arrays (all targets / weights back to back, one offset per vertex)
+// so Dijkstra scans neighbours as contiguous memory. adding a vertex or edge thaws
+// the graph and the next query freezes it again
+//
+// point-to-point queries (findRoute) are goal-directed and stop at the target:
+//  - A*: haversine distance to the target, scaled so it never exceeds any edge
+//    weight, is a lower bound on the remaining distance
+//  - ALT: for graphs without usable coordinates, distances to / from a few
+//    landmark vertices give a lower bound via the triangle inequality
+//
+// a union-find over the edges (taken as undirected) is kept in step with addEdge,
+// so "no route between these two" is answered without searching
 class Graph {
 private:
     Vertex* vertices;
     int vertexCount;
     int capacity;
+    CityArena* arena;       // edges + vertex names (shared by the owning system, or our own)
+    CityArena* ownedArena;  // set only when no arena was handed in
+    HashMap<StringView, int>* vertexIndex;   // name -> index, case-insensitive
+    
+    // CSR copy of the adjacency lists, valid while frozen
+    int* csrOffsets;        // vertex v's edges are [csrOffsets[v], csrOffsets[v + 1])
+    int* csrTargets;
+    double* csrWeights;
+    int edgeCount;
+    bool frozen;
+    unsigned int revision;  // bumped by every change, lets derived indexes spot a stale graph
+    
+    // A*: weight >= geoScale * haversine(u, v) holds for every edge (set by freeze)
+    double geoScale;
+    bool geoUsable;         // false when no edge spans a real distance (e.g. all at 0,0)
+    
+    // ALT: per vertex, distances from / to each landmark, landmarkCount values each
+    int landmarkCount;
+    double* landmarkFrom;   // [v * landmarkCount + i] = d(landmark i, v)
+    double* landmarkTo;     // [v * landmarkCount + i] = d(v, landmark i)
+    bool landmarksReady;
+    
+    // reversed CSR (edge u -> v stored at v), built on demand while frozen
+    int* reverseOffsets;
+    int* reverseTargets;
+    double* reverseWeights;
+    bool reverseReady;
+    
+    // the last GRAPH_EDGE_LOG_SIZE edge changes, so maintained shortest path trees can be
+    // repaired instead of rebuilt. every revision bump after structuralRevision is
+    // in the log, in order (adding a vertex is structural)
+    EdgeChange edgeLog[GRAPH_EDGE_LOG_SIZE];
+    int edgeLogCount;                   // changes logged so far (ring slot = count % size)
+    unsigned int structuralRevision;
+    
+    // weak components: union by size, path halving. removeEdge may split a
+    // component, which a union-find cannot undo, so it only flags a rebuild
+    int* componentParent;
+    int* componentSize;     // valid at roots
+    int componentCount;
+    bool componentsStale;
+    
+    // betweenness of every vertex, cached for one revision (getBetweenness)
+    double* centrality;
+    unsigned int centralityRevision;
+    bool centralityReady;
+    
+    // Graph::greatCircleKm(lat1, lon1, lat2, lon2)
+    // Time: O(1)
+    // Space: O(1)
+    // haversine with the library trig: the A* bound needs the exact great-circle
+    // metric (triangle inequality), which the series approximations in Utils.h miss
+    static double greatCircleKm(double lat1, double lon1, double lat2, double lon2) {
+        const double toRadians = 3.14159265358979323846 / 180.0;
+        double sinLat = std::sin((lat2 - lat1) * toRadians / 2.0);
+        double sinLon = std::sin((lon2 - lon1) * toRadians / 2.0);
+        double a = sinLat * sinLat +
+                   std::cos(lat1 * toRadians) * std::cos(lat2 * toRadians) * sinLon * sinLon;
+        if (a > 1.0) a = 1.0;
+        return 2.0 * 6371.0 * std::asin(std::sqrt(a));
+    }
+    
+    // Graph::searchFrom(sources, sourceCount, settled, estimate, allowed, offsets, targets, weights)
+    // Time: O((V + E) log V) worst case; fewer vertices the tighter estimate is
+    // Space: O(1) per query - the thread's workspace is reused
+    // Dijkstra over the given CSR arrays, ordered by distance + estimate(v), with
+    // every source seeded at distance 0 (previous -1, so each path trace ends at the
+    // source it grew from; out of range and repeated sources are skipped).
+    // settled(v, distance) is called as each vertex is settled and ends the search
+    // by returning true. estimate must never overestimate; a vertex improved after
+    // it was settled (only possible when the estimate is not consistent) is simply
+    // queued again. allowed(from, to) can rule edges out (closed roads, a route's
+    // own vertices when looking for detours)
+    template <typename Settled, typename Heuristic, typename Filter>
+    void searchFrom(const int* sources, int sourceCount, Settled settled, Heuristic estimate,
+                    Filter allowed, const int* offsets, const int* targets, const double* weights) {
+        ShortestPathWorkspace& ws = shortestPathWorkspace();
+        ws.begin(this, vertexCount);
+        for (int i = 0; i < sourceCount; i++) {
+            int source = sources[i];
+            if (source < 0 || source >= vertexCount || ws.reached(source)) {
+                continue;
+            }
+            ws.reach(source, 0, -1);
+            ws.handle[source] = ws.frontier.push(source, estimate(source));
+        }
+        
+        // main loop: settle the most promising unsettled vertex
+        while (!ws.frontier.isEmpty()) {
+            int minIndex = ws.frontier.pop();
+            ws.handle[minIndex] = NO_HEAP_HANDLE;
+            if (settled(minIndex, ws.distance[minIndex])) {
+                break;
+            }
+            
+            // update distances of neighbors
+            double base = ws.distance[minIndex];
+            for (int e = offsets[minIndex]; e < offsets[minIndex + 1]; e++) {
+                int dest = targets[e];
+                if (!allowed(minIndex, dest)) {
+                    continue;
+                }
+                double candidate = base + weights[e];
+                if (!ws.reached(dest)) {
+                    ws.reach(dest, candidate, minIndex);
+                    ws.handle[dest] = ws.frontier.push(dest, candidate + estimate(dest));
+                } else if (candidate < ws.distance[dest]) {
+                    ws.distance[dest] = candidate;
+                    ws.previous[dest] = minIndex;
+                    if (ws.handle[dest] != NO_HEAP_HANDLE) {
+                        ws.frontier.update(ws.handle[dest], candidate + estimate(dest));   // decrease-key
+                    } else {
+                        ws.handle[dest] = ws.frontier.push(dest, candidate + estimate(dest));
+                    }
+                }
+            }
+        }
+    }
+    
+    // Graph::searchUntil(source, settled, estimate, allowed, offsets, targets, weights)
+    // Time: see searchFrom
+    // Space: O(1) per query
+    // single-source searchFrom
+    template <typename Settled, typename Heuristic, typename Filter>
+    void searchUntil(int source, Settled settled, Heuristic estimate, Filter allowed,
+                     const int* offsets, const int* targets, const double* weights) {
+        searchFrom(&source, 1, settled, estimate, allowed, offsets, targets, weights);
+    }
+    
+    // Graph::searchUntil(source, settled, estimate, offsets, targets, weights)
+    // Time: same as above, every edge allowed
+    // Space: O(1) per query
+    template <typename Settled, typename Heuristic>
+    void searchUntil(int source, Settled settled, Heuristic estimate,
+                     const int* offsets, const int* targets, const double* weights) {
+        searchUntil(source, settled, estimate, [](int, int) { return true; },
+                    offsets, targets, weights);
+    }
+    
+    // Graph::search(source, target, estimate, offsets, targets, weights)
+    // Time: O((V + E) log V) worst case, stops once target is settled
+    // Space: O(1) per query
+    // distance to target (GRAPH_MAX_DISTANCE if unreachable); target = -1 settles everything
+    template <typename Heuristic>
+    double search(int source, int target, Heuristic estimate,
+                  const int* offsets, const int* targets, const double* weights) {
+        searchUntil(source, [target](int v, double) { return v == target; },
+                    estimate, offsets, targets, weights);
+        ShortestPathWorkspace& ws = shortestPathWorkspace();
+        return target >= 0 && target < vertexCount && ws.reached(target) ? ws.distance[target] : GRAPH_MAX_DISTANCE;
+    }
     
     // find vertex index by name - CASE INSENSITIVE
+    // Graph::findVertexIndex(name)
+    // Time: Average O(k) - one hash lookup, the name is folded while it is hashed
+    // Space: O(1) - no uppercase copies
     int findVertexIndex(const char* name) {
+        if (name == nullptr) {
+            return -1;
+        }
+        int* index = vertexIndex->search(name);
+        return index != nullptr ? *index : -1;
+    }
+    
+    // Graph::growVertices()
+    // Time: O(V) - amortized O(1) per addVertex
+    // Space: O(V)
+    // names and edge lists live in the arena, so only the Vertex records move
+    void growVertices() {
+        int newCapacity = capacity > 0 ? capacity * 2 : 16;
+        Vertex* newVertices = new Vertex[newCapacity];
         for (int i = 0; i < vertexCount; i++) {
-            char vertexNameUpper[100], searchNameUpper[100];
-            stringCopy(vertexNameUpper, vertices[i].name);
-            stringCopy(searchNameUpper, name);
-            toUpperCase(vertexNameUpper);
-            toUpperCase(searchNameUpper);
-            
-            if (stringCompare(vertexNameUpper, searchNameUpper) == 0) {
-                return i;
+            newVertices[i] = vertices[i];
+        }
+        delete[] vertices;
+        vertices = newVertices;
+        int* newParent = new int[newCapacity];
+        int* newSize = new int[newCapacity];
+        for (int i = 0; i < vertexCount; i++) {
+            newParent[i] = componentParent[i];
+            newSize[i] = componentSize[i];
+        }
+        delete[] componentParent;
+        delete[] componentSize;
+        componentParent = newParent;
+        componentSize = newSize;
+        capacity = newCapacity;
+    }
+    
+    // Graph::findComponent(v)
+    // Time: O(alpha(V)) amortized
+    // Space: O(1)
+    // root of v's component; halves the path on the way up
+    int findComponent(int v) {
+        while (componentParent[v] != v) {
+            componentParent[v] = componentParent[componentParent[v]];
+            v = componentParent[v];
+        }
+        return v;
+    }
+    
+    // Graph::uniteComponents(a, b)
+    // Time: O(alpha(V)) amortized
+    // Space: O(1)
+    void uniteComponents(int a, int b) {
+        int rootA = findComponent(a);
+        int rootB = findComponent(b);
+        if (rootA == rootB) {
+            return;
+        }
+        if (componentSize[rootA] < componentSize[rootB]) {
+            int swap = rootA;
+            rootA = rootB;
+            rootB = swap;
+        }
+        componentParent[rootB] = rootA;
+        componentSize[rootA] += componentSize[rootB];
+        componentCount--;
+    }
+    
+    // Graph::syncComponents()
+    // Time: O(1), O((V + E) alpha(V)) after a removeEdge
+    // Space: O(1)
+    void syncComponents() {
+        if (!componentsStale) {
+            return;
+        }
+        for (int v = 0; v < vertexCount; v++) {
+            componentParent[v] = v;
+            componentSize[v] = 1;
+        }
+        componentCount = vertexCount;
+        for (int v = 0; v < vertexCount; v++) {
+            for (Edge* edge = vertices[v].edges; edge != nullptr; edge = edge->next) {
+                uniteComponents(v, edge->destIndex);
             }
         }
-        return -1;
+        componentsStale = false;
+    }
+    
+    // Graph::rejectUnreachable(source, target)
+    // Time: O(alpha(V)) amortized
+    // Space: O(1)
+    // true if no path can join source and target, in which case the thread's
+    // workspace is reset so distanceTo / pathTo report target as unreached
+    bool rejectUnreachable(int source, int target) {
+        if (source < 0 || source >= vertexCount || target < 0 || target >= vertexCount ||
+            connected(source, target)) {
+            return false;
+        }
+        shortestPathWorkspace().begin(this, vertexCount);
+        return true;
+    }
+
+    // Graph::pairWeight(srcIndex, destIndex)
+    // Time: O(deg(src))
+    // Space: O(1)
+    // shortest edge src -> dest in the adjacency list, GRAPH_MAX_DISTANCE if none
+    double pairWeight(int srcIndex, int destIndex) {
+        double best = GRAPH_MAX_DISTANCE;
+        for (Edge* edge = vertices[srcIndex].edges; edge != nullptr; edge = edge->next) {
+            if (edge->destIndex == destIndex && edge->weight < best) {
+                best = edge->weight;
+            }
+        }
+        return best;
+    }
+    
+    // Graph::logEdgeChange(srcIndex, destIndex, oldWeight, newWeight)
+    // Time: O(1)
+    // Space: O(1) - fixed ring, the oldest entry is overwritten
+    void logEdgeChange(int srcIndex, int destIndex, double oldWeight, double newWeight) {
+        EdgeChange& change = edgeLog[edgeLogCount % GRAPH_EDGE_LOG_SIZE];
+        change.source = srcIndex;
+        change.dest = destIndex;
+        change.oldWeight = oldWeight;
+        change.newWeight = newWeight;
+        edgeLogCount++;
+        revision++;
+    }
+    
+    // Graph::buildReverse()
+    // Time: O(V + E)
+    // Space: O(V + E)
+    // graph must be frozen
+    void buildReverse() {
+        delete[] reverseOffsets;
+        delete[] reverseTargets;
+        delete[] reverseWeights;
+        reverseOffsets = new int[vertexCount + 1];
+        reverseTargets = new int[edgeCount > 0 ? edgeCount : 1];
+        reverseWeights = new double[edgeCount > 0 ? edgeCount : 1];
+        for (int v = 0; v <= vertexCount; v++) {
+            reverseOffsets[v] = 0;
+        }
+        for (int e = 0; e < edgeCount; e++) {
+            reverseOffsets[csrTargets[e] + 1]++;
+        }
+        for (int v = 0; v < vertexCount; v++) {
+            reverseOffsets[v + 1] += reverseOffsets[v];
+        }
+        int* fill = new int[vertexCount > 0 ? vertexCount : 1];
+        for (int v = 0; v < vertexCount; v++) {
+            fill[v] = reverseOffsets[v];
+        }
+        for (int v = 0; v < vertexCount; v++) {
+            for (int e = csrOffsets[v]; e < csrOffsets[v + 1]; e++) {
+                int slot = fill[csrTargets[e]]++;
+                reverseTargets[slot] = v;
+                reverseWeights[slot] = csrWeights[e];
+            }
+        }
+        delete[] fill;
+        reverseReady = true;
     }
 
 public:
-    Graph(int size = 100) {
+    static const int DEFAULT_LANDMARKS = 8;
+    
+    Graph(int size = 100, CityArena* sharedArena = nullptr) {
         capacity = size;
         vertexCount = 0;
         vertices = new Vertex[capacity];
+        ownedArena = nullptr;
+        if (sharedArena == nullptr) {
+            ownedArena = new CityArena();
+            sharedArena = ownedArena;
+        }
+        arena = sharedArena;
+        vertexIndex = new HashMap<StringView, int>(size);
+        csrOffsets = nullptr;
+        csrTargets = nullptr;
+        csrWeights = nullptr;
+        edgeCount = 0;
+        frozen = false;
+        revision = 0;
+        geoScale = 0;
+        geoUsable = false;
+        landmarkCount = 0;
+        landmarkFrom = nullptr;
+        landmarkTo = nullptr;
+        landmarksReady = false;
+        reverseOffsets = nullptr;
+        reverseTargets = nullptr;
+        reverseWeights = nullptr;
+        reverseReady = false;
+        edgeLogCount = 0;
+        structuralRevision = 0;
+        componentParent = new int[capacity];
+        componentSize = new int[capacity];
+        componentCount = 0;
+        componentsStale = false;
+        centrality = nullptr;
+        centralityRevision = 0;
+        centralityReady = false;
+    }
+    
+    // index of a vertex by name (case-insensitive), -1 if missing
+    // resolve once, then use the int overloads below
+    int indexOf(const char* name) {
+        return findVertexIndex(name);
     }
     
     // Graph::addVertex(name, lat, lon)
-    // Time: O(V) - findVertexIndex scans all vertices
-    // Space: O(1) - single vertex added
+    // Time: Average O(k) - one hash lookup + insert, amortized O(1) growth
+    // Space: O(k) for the name
+    // size passed to the constructor is only a hint, the graph grows on demand
     bool addVertex(const char* name, double lat, double lon) {
-        if (vertexCount >= capacity) {
-            cout << "Graph is full!" << endl;
-            return false;
-        }
         if (findVertexIndex(name) != -1) {
             return false; // already exists
         }
-        vertices[vertexCount].init(name, lat, lon);
+        if (vertexCount >= capacity) {
+            growVertices();
+        }
+        vertices[vertexCount].init(name, lat, lon, arena);
+        vertexIndex->emplace(name, vertexCount);
+        componentParent[vertexCount] = vertexCount;
+        componentSize[vertexCount] = 1;
+        componentCount++;
         vertexCount++;
+        frozen = false;
+        revision++;
+        structuralRevision = revision;
         return true;
     }
     
     // Graph::addEdge(source, dest, weight)
-    // Time: O(V) - findVertexIndex for source and dest takes O(V) each
+    // Time: Average O(k) - two hash lookups, then addEdge by index
     // Space: O(1) - single edge node created
     bool addEdge(const char* source, const char* dest, double weight) {
-        int srcIndex = findVertexIndex(source);
-        int destIndex = findVertexIndex(dest);
-        
-        if (srcIndex == -1 || destIndex == -1) {
+        return addEdge(findVertexIndex(source), findVertexIndex(dest), weight);
+    }
+    
+    // Graph::addEdge(srcIndex, destIndex, weight)
+    // Time: O(deg(src)) - for callers that resolved the names once - plus one
+    //       O(alpha(V)) component union
+    // Space: O(1) - single edge node created
+    bool addEdge(int srcIndex, int destIndex, double weight) {
+        if (srcIndex < 0 || srcIndex >= vertexCount || destIndex < 0 || destIndex >= vertexCount) {
             return false;
         }
+        double oldWeight = pairWeight(srcIndex, destIndex);
         
-        // add edge to source's adjacency list
-        Edge* newEdge = new Edge(destIndex, weight);
+        // add edge to source's adjacency list (slab allocated, no malloc per edge)
+        Edge* newEdge = arena->create<Edge>(destIndex, weight);
         newEdge->next = vertices[srcIndex].edges;
         vertices[srcIndex].edges = newEdge;
+        edgeCount++;
+        frozen = false;
+        if (!componentsStale) {
+            uniteComponents(srcIndex, destIndex);
+        }
+        logEdgeChange(srcIndex, destIndex, oldWeight, weight < oldWeight ? weight : oldWeight);
         
         return true;
     }
     
+    // Graph::updateEdgeWeight(source, dest, weight)
+    // Time: Average O(k) - two hash lookups, then updateEdgeWeight by index
+    // Space: O(1)
+    bool updateEdgeWeight(const char* source, const char* dest, double weight) {
+        return updateEdgeWeight(findVertexIndex(source), findVertexIndex(dest), weight);
+    }
+    
+    // Graph::updateEdgeWeight(srcIndex, destIndex, weight)
+    // Time: O(deg(src) + deg(dest)) - the CSR arrays are patched in place, no refreeze
+    // Space: O(1)
+    // sets every src -> dest edge to weight (traffic, roadworks); false if there is
+    // none. landmarks are dropped (their bounds may no longer hold) and the A*
+    // scale is tightened if the new weight needs it
+    bool updateEdgeWeight(int srcIndex, int destIndex, double weight) {
+        if (srcIndex < 0 || srcIndex >= vertexCount || destIndex < 0 || destIndex >= vertexCount ||
+            weight < 0) {
+            return false;
+        }
+        double oldWeight = pairWeight(srcIndex, destIndex);
+        if (oldWeight >= GRAPH_MAX_DISTANCE) {
+            return false;
+        }
+        for (Edge* edge = vertices[srcIndex].edges; edge != nullptr; edge = edge->next) {
+            if (edge->destIndex == destIndex) {
+                edge->weight = weight;
+            }
+        }
+        
+        if (frozen) {
+            for (int e = csrOffsets[srcIndex]; e < csrOffsets[srcIndex + 1]; e++) {
+                if (csrTargets[e] == destIndex) {
+                    csrWeights[e] = weight;
+                }
+            }
+            if (reverseReady) {
+                for (int e = reverseOffsets[destIndex]; e < reverseOffsets[destIndex + 1]; e++) {
+                    if (reverseTargets[e] == srcIndex) {
+                        reverseWeights[e] = weight;
+                    }
+                }
+            }
+            if (geoUsable) {
+                double straight = greatCircleKm(vertices[srcIndex].latitude, vertices[srcIndex].longitude,
+                                                vertices[destIndex].latitude, vertices[destIndex].longitude);
+                if (straight > 1e-9 && weight < geoScale * straight) {
+                    geoScale = weight / straight * 0.999;
+                    geoUsable = geoScale > 0;
+                }
+            }
+            landmarksReady = false;
+        }
+        if (weight != oldWeight) {
+            logEdgeChange(srcIndex, destIndex, oldWeight, weight);
+        }
+        return true;
+    }
+    
+    // Graph::removeEdge(source, dest)
+    // Time: Average O(k) - two hash lookups, then removeEdge by index
+    // Space: O(1)
+    bool removeEdge(const char* source, const char* dest) {
+        return removeEdge(findVertexIndex(source), findVertexIndex(dest));
+    }
+    
+    // Graph::removeEdge(srcIndex, destIndex)
+    // Time: O(deg(src)); the next query refreezes in O(V + E)
+    // Space: O(1) - the unlinked nodes stay in the arena until it is released
+    // removes every src -> dest edge (road closure); false if there is none
+    bool removeEdge(int srcIndex, int destIndex) {
+        if (srcIndex < 0 || srcIndex >= vertexCount || destIndex < 0 || destIndex >= vertexCount) {
+            return false;
+        }
+        double oldWeight = pairWeight(srcIndex, destIndex);
+        if (oldWeight >= GRAPH_MAX_DISTANCE) {
+            return false;
+        }
+        Edge** link = &vertices[srcIndex].edges;
+        while (*link != nullptr) {
+            if ((*link)->destIndex == destIndex) {
+                *link = (*link)->next;
+                edgeCount--;
+            } else {
+                link = &(*link)->next;
+            }
+        }
+        frozen = false;
+        componentsStale = true;
+        logEdgeChange(srcIndex, destIndex, oldWeight, GRAPH_MAX_DISTANCE);
+        return true;
+    }
+    
+    // Graph::connected(source, target)
+    // Time: O(alpha(V)) amortized; O((V + E) alpha(V)) once after a removeEdge
+    // Space: O(1)
+    // false means no route exists in either direction, so a search can be skipped.
+    // edges count both ways here, so true on a one-way network is only a maybe
+    bool connected(int source, int target) {
+        if (source < 0 || source >= vertexCount || target < 0 || target >= vertexCount) {
+            return false;
+        }
+        syncComponents();
+        return findComponent(source) == findComponent(target);
+    }
+    
+    // Graph::connected(sourceName, targetName)
+    // Time: Average O(k) name lookups + connected by index
+    // Space: O(1)
+    bool connected(const char* sourceName, const char* targetName) {
+        return connected(findVertexIndex(sourceName), findVertexIndex(targetName));
+    }
+    
+    // Graph::getComponentCount()
+    // Time: O(1), a rebuild after a removeEdge
+    // Space: O(1)
+    int getComponentCount() {
+        syncComponents();
+        return componentCount;
+    }
+    
+    // Graph::listComponents(labels, sizes)
+    // Time: O(V alpha(V))
+    // Space: O(1) - both arrays are the caller's (vertexCount entries each)
+    // labels[v] = component of v, numbered 0.. in order of each component's first
+    // vertex; sizes[c] = vertices in component c. returns the component count
+    int listComponents(int* labels, int* sizes) {
+        syncComponents();
+        int count = 0;
+        for (int v = 0; v < vertexCount; v++) {
+            labels[v] = -1;
+        }
+        for (int v = 0; v < vertexCount; v++) {
+            int root = findComponent(v);
+            if (labels[root] == -1) {
+                labels[root] = count;
+                sizes[count] = 0;
+                count++;
+            }
+            labels[v] = labels[root];
+            sizes[labels[v]]++;
+        }
+        return count;
+    }
+    
+    // Graph::edgeChangesSince(since, visit)
+    // Time: O(c) where c = changes after revision since
+    // Space: O(1)
+    // calls visit(const EdgeChange&) for every edge change after revision since, oldest
+    // first. false (nothing visited) if the log cannot account for all of them: a vertex
+    // was added, or more than GRAPH_EDGE_LOG_SIZE changes happened
+    template <typename Visitor>
+    bool edgeChangesSince(unsigned int since, Visitor visit) {
+        unsigned int pending = revision - since;
+        if (since < structuralRevision || pending > (unsigned int)GRAPH_EDGE_LOG_SIZE ||
+            pending > (unsigned int)edgeLogCount) {
+            return false;
+        }
+        for (int i = edgeLogCount - (int)pending; i < edgeLogCount; i++) {
+            visit(edgeLog[i % GRAPH_EDGE_LOG_SIZE]);
+        }
+        return true;
+    }
+    
     // add bidirectional edge
     bool addBidirectionalEdge(const char* v1, const char* v2, double weight) {
+        return addBidirectionalEdge(findVertexIndex(v1), findVertexIndex(v2), weight);
+    }
+    
+    bool addBidirectionalEdge(int v1, int v2, double weight) {
         return addEdge(v1, v2, weight) && addEdge(v2, v1, weight);
     }
     
@@ -136,74 +1058,1121 @@ public:
         return &vertices[index];
     }
     
+    // Graph::freeze()
+    // Time: O(V + E) - one pass over every adjacency list
+    // Space: O(V + E) for the CSR arrays
+    // neighbours keep their adjacency list order, so ties resolve exactly as before.
+    // also calibrates the A* bound and drops landmarks computed for the old graph
+    void freeze() {
+        delete[] csrOffsets;
+        delete[] csrTargets;
+        delete[] csrWeights;
+        csrOffsets = new int[vertexCount + 1];
+        csrTargets = new int[edgeCount > 0 ? edgeCount : 1];
+        csrWeights = new double[edgeCount > 0 ? edgeCount : 1];
+        
+        int next = 0;
+        for (int v = 0; v < vertexCount; v++) {
+            csrOffsets[v] = next;
+            for (Edge* edge = vertices[v].edges; edge != nullptr; edge = edge->next) {
+                csrTargets[next] = edge->destIndex;
+                csrWeights[next] = edge->weight;
+                next++;
+            }
+        }
+        csrOffsets[vertexCount] = next;
+        
+        // largest scale with weight >= scale * haversine on every edge, so the
+        // scaled straight-line distance to the target is always a lower bound
+        geoScale = GRAPH_MAX_DISTANCE;
+        geoUsable = false;
+        for (int v = 0; v < vertexCount; v++) {
+            for (int e = csrOffsets[v]; e < csrOffsets[v + 1]; e++) {
+                Vertex& to = vertices[csrTargets[e]];
+                double straight = greatCircleKm(vertices[v].latitude, vertices[v].longitude,
+                                                    to.latitude, to.longitude);
+                if (straight > 1e-9) {
+                    double ratio = csrWeights[e] / straight;
+                    if (ratio < geoScale) {
+                        geoScale = ratio;
+                    }
+                    geoUsable = true;
+                }
+            }
+        }
+        // small margin so floating point rounding can never push the bound above the truth
+        geoScale = geoUsable && geoScale > 0 ? geoScale * 0.999 : 0;
+        geoUsable = geoScale > 0;
+        
+        landmarksReady = false;
+        reverseReady = false;
+        frozen = true;
+    }
+    
+    // true while the CSR arrays match the adjacency lists
+    bool isFrozen() {
+        return frozen;
+    }
+    
+    // Graph::shortestPath(source, target)
+    // Time: O((V + E) log V) worst case - indexed 4-ary heap with decrease-key over
+    //       the CSR arrays; stops as soon as target is settled
+    // Space: O(1) per query - the thread's workspace is reused
+    // returns the distance to target (GRAPH_MAX_DISTANCE if unreachable); pass
+    // target = -1 to settle every reachable vertex. read the results with
+    // distanceTo / previousOf / pathTo before the next query on this thread
+    double shortestPath(int source, int target) {
+        if (!frozen) {
+            freeze();
+        }
+        if (rejectUnreachable(source, target)) {
+            return GRAPH_MAX_DISTANCE;
+        }
+        return search(source, target, [](int) { return 0.0; },
+                      csrOffsets, csrTargets, csrWeights);
+    }
+    
+    // Graph::shortestPathAStar(source, target)
+    // Time: O((V + E) log V) worst case, usually a narrow corridor toward the target
+    // Space: O(1) per query
+    // same results as shortestPath; falls back to plain Dijkstra without coordinates
+    double shortestPathAStar(int source, int target) {
+        if (!frozen) {
+            freeze();
+        }
+        if (target < 0 || target >= vertexCount || !geoUsable) {
+            return shortestPath(source, target);
+        }
+        if (rejectUnreachable(source, target)) {
+            return GRAPH_MAX_DISTANCE;
+        }
+        double targetLat = vertices[target].latitude;
+        double targetLon = vertices[target].longitude;
+        double scale = geoScale;
+        Vertex* all = vertices;
+        return search(source, target, [=](int v) {
+            return scale * greatCircleKm(all[v].latitude, all[v].longitude, targetLat, targetLon);
+        }, csrOffsets, csrTargets, csrWeights);
+    }
+    
+    // Graph::prepareLandmarks(count)
+    // Time: O(count * (V + E) log V) - two full searches per landmark
+    // Space: O(count * V)
+    // landmarks are picked farthest-first: each new one is the vertex worst covered
+    // by the ones already chosen (unreachable vertices first, so every component
+    // gets one). distances to the landmarks come from a search on the reversed
+    // edges, so one-way edges are handled too
+    void prepareLandmarks(int count) {
+        if (!frozen) {
+            freeze();
+        }
+        if (count > vertexCount) {
+            count = vertexCount;
+        }
+        delete[] landmarkFrom;
+        delete[] landmarkTo;
+        landmarkFrom = nullptr;
+        landmarkTo = nullptr;
+        landmarkCount = count;
+        landmarksReady = true;
+        if (count <= 0) {
+            return;
+        }
+        landmarkFrom = new double[vertexCount * count];
+        landmarkTo = new double[vertexCount * count];
+        
+        if (!reverseReady) {
+            buildReverse();
+        }
+        
+        double* coverage = new double[vertexCount];   // distance to the closest landmark so far
+        for (int v = 0; v < vertexCount; v++) {
+            coverage[v] = GRAPH_MAX_DISTANCE;
+        }
+        
+        int landmark = 0;
+        for (int i = 0; i < count; i++) {
+            search(landmark, -1, [](int) { return 0.0; }, csrOffsets, csrTargets, csrWeights);
+            for (int v = 0; v < vertexCount; v++) {
+                double d = distanceTo(v);
+                landmarkFrom[v * count + i] = d;
+                if (d < coverage[v]) {
+                    coverage[v] = d;
+                }
+            }
+            search(landmark, -1, [](int) { return 0.0; }, reverseOffsets, reverseTargets, reverseWeights);
+            for (int v = 0; v < vertexCount; v++) {
+                landmarkTo[v * count + i] = distanceTo(v);
+            }
+            
+            // next landmark: the vertex farthest from every landmark so far
+            int farthest = landmark;
+            for (int v = 0; v < vertexCount; v++) {
+                if (coverage[v] > coverage[farthest]) {
+                    farthest = v;
+                }
+            }
+            landmark = farthest;
+        }
+        
+        delete[] coverage;
+        shortestPathWorkspace().owner = nullptr;   // the last search belongs to no caller
+    }
+    
+    // Graph::shortestPathALT(source, target)
+    // Time: O((V + E) log V) worst case; landmarks are prepared on first use
+    // Space: O(1) per query once landmarks exist
+    double shortestPathALT(int source, int target) {
+        if (!frozen || !landmarksReady) {
+            prepareLandmarks(DEFAULT_LANDMARKS);
+        }
+        if (target < 0 || target >= vertexCount || landmarkCount == 0) {
+            return shortestPath(source, target);
+        }
+        int k = landmarkCount;
+        const double* fromAll = landmarkFrom;
+        const double* toAll = landmarkTo;
+        const double* fromTarget = landmarkFrom + target * k;
+        const double* toTarget = landmarkTo + target * k;
+        if (rejectUnreachable(source, target)) {
+            return GRAPH_MAX_DISTANCE;
+        }
+        return search(source, target, [=](int v) {
+            // d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L)
+            const double* fromV = fromAll + v * k;
+            const double* toV = toAll + v * k;
+            double bound = 0;
+            for (int i = 0; i < k; i++) {
+                if (fromTarget[i] < GRAPH_MAX_DISTANCE && fromV[i] < GRAPH_MAX_DISTANCE &&
+                    fromTarget[i] - fromV[i] > bound) {
+                    bound = fromTarget[i] - fromV[i];
+                }
+                if (toV[i] < GRAPH_MAX_DISTANCE && toTarget[i] < GRAPH_MAX_DISTANCE &&
+                    toV[i] - toTarget[i] > bound) {
+                    bound = toV[i] - toTarget[i];
+                }
+            }
+            return bound;
+        }, csrOffsets, csrTargets, csrWeights);
+    }
+    
+    // Graph::findRoute(source, target)
+    // Time: see shortestPathAStar / shortestPathALT
+    // Space: O(1) per query
+    // point-to-point query for interactive use: A* when the stops have real
+    // coordinates, ALT landmarks otherwise (airports are registered at 0,0)
+    double findRoute(int source, int target) {
+        if (!frozen) {
+            freeze();
+        }
+        if (geoUsable) {
+            return shortestPathAStar(source, target);
+        }
+        return shortestPathALT(source, target);
+    }
+    
+    // Graph::shortestPath(startName, targetName)
+    // Time: O(V) name lookups + shortestPath(source, target)
+    // Space: O(1)
+    double shortestPath(const char* startName, const char* targetName) {
+        return shortestPath(findVertexIndex(startName), findVertexIndex(targetName));
+    }
+    
+    // distance found by this thread's last query on this graph
+    // (GRAPH_MAX_DISTANCE if the vertex was not reached)
+    double distanceTo(int v) {
+        ShortestPathWorkspace& ws = shortestPathWorkspace();
+        if (ws.owner != this || v < 0 || v >= vertexCount || !ws.reached(v)) {
+            return GRAPH_MAX_DISTANCE;
+        }
+        return ws.distance[v];
+    }
+    
+    // predecessor of v on the last query's shortest path tree (-1 = none)
+    int previousOf(int v) {
+        ShortestPathWorkspace& ws = shortestPathWorkspace();
+        if (ws.owner != this || v < 0 || v >= vertexCount || !ws.reached(v)) {
+            return -1;
+        }
+        return ws.previous[v];
+    }
+    
+    // Graph::pathTo(target, length)
+    // Time: O(L) where L = number of vertices on the path
+    // Space: O(1) - the path is written into the thread's workspace
+    // vertex indices from the last query's source to target, in travel order;
+    // length is 0 if target was not reached. valid until the next query
+    const int* pathTo(int target, int& length) {
+        length = 0;
+        if (distanceTo(target) >= GRAPH_MAX_DISTANCE) {
+            return nullptr;
+        }
+        ShortestPathWorkspace& ws = shortestPathWorkspace();
+        for (int v = target; v != -1; v = ws.previous[v]) {
+            length++;
+        }
+        int position = length - 1;
+        for (int v = target; v != -1; v = ws.previous[v]) {
+            ws.path[position--] = v;
+        }
+        return ws.path;
+    }
+    
+    // Graph::reachableWithin(sourceName, budget, count, reverse)
+    // Time: Average O(k) name lookup + reachableWithin by index
+    // Space: O(1)
+    const int* reachableWithin(const char* sourceName, double budget, int& count, bool reverse = false) {
+        return reachableWithin(findVertexIndex(sourceName), budget, count, reverse);
+    }
+    
+    // Graph::reachableWithin(source, budget, count, reverse)
+    // Time: O((R + E_R) log R) where R = vertices within budget and E_R their edges,
+    //       independent of the rest of the graph (epoch stamps, nothing is cleared)
+    // Space: O(1) per query - the thread's workspace is reused
+    // isochrone: every vertex whose distance from source is at most budget, nearest
+    // first (source included). with reverse the edges are followed backwards, giving
+    // every vertex that can reach source within budget. distanceTo / previousOf then
+    // describe the listed vertices (previousOf is the next hop toward source when
+    // reverse). valid until the next query on this thread
+    const int* reachableWithin(int source, double budget, int& count, bool reverse = false) {
+        count = 0;
+        if (!frozen) {
+            freeze();
+        }
+        if (reverse && !reverseReady) {
+            buildReverse();
+        }
+        ShortestPathWorkspace& ws = shortestPathWorkspace();
+        int settledCount = 0;
+        searchUntil(source, [&](int v, double distance) {
+            if (distance > budget) {
+                return true;
+            }
+            ws.settledOrder[settledCount++] = v;
+            return false;
+        }, [](int) { return 0.0; },
+           reverse ? reverseOffsets : csrOffsets,
+           reverse ? reverseTargets : csrTargets,
+           reverse ? reverseWeights : csrWeights);
+        count = settledCount;
+        return count > 0 ? ws.settledOrder : nullptr;
+    }
+    
+    // Graph::nearestSource(sources, sourceCount, target, distance)
+    // Time: O((V + E) log V) worst case, one search however many sources there are;
+    //       it only grows the frontier out to the nearest source's distance
+    // Space: O(1) per query - the thread's workspace is reused
+    // multi-source search: the vertex in sources with the shortest path to target,
+    // -1 if none reaches it. distance gets its length, and pathTo(target) then gives
+    // the route from that source. A* toward target when the graph has coordinates
+    // (the estimate only depends on target, so it stays valid for every source)
+    int nearestSource(const int* sources, int sourceCount, int target, double& distance) {
+        distance = GRAPH_MAX_DISTANCE;
+        if (!frozen) {
+            freeze();
+        }
+        if (target < 0 || target >= vertexCount || sourceCount <= 0) {
+            return -1;
+        }
+        double targetLat = vertices[target].latitude;
+        double targetLon = vertices[target].longitude;
+        double scale = geoUsable ? geoScale : 0.0;
+        Vertex* all = vertices;
+        searchFrom(sources, sourceCount, [target](int v, double) { return v == target; },
+                   [=](int v) {
+                       return scale > 0 ? scale * greatCircleKm(all[v].latitude, all[v].longitude,
+                                                                targetLat, targetLon) : 0.0;
+                   }, [](int, int) { return true; }, csrOffsets, csrTargets, csrWeights);
+        ShortestPathWorkspace& ws = shortestPathWorkspace();
+        if (!ws.reached(target)) {
+            return -1;
+        }
+        distance = ws.distance[target];
+        int v = target;
+        while (ws.previous[v] != -1) {
+            v = ws.previous[v];
+        }
+        return v;
+    }
+    
+    // Graph::kShortestPaths(sourceName, targetName, k, paths)
+    // Time: Average O(k) name lookups + kShortestPaths by index
+    // Space: see below
+    int kShortestPaths(const char* sourceName, const char* targetName, int k, PathSet& paths) {
+        return kShortestPaths(findVertexIndex(sourceName), findVertexIndex(targetName), k, paths);
+    }
+    
+    // Graph::kShortestPaths(source, target, k, paths)
+    // Time: one reverse search from target, then per route one spur search for every
+    //       vertex past the route's deviation point. the spur searches are A* guided
+    //       by the reverse search's exact distances, so they mostly walk straight in
+    // Space: O(V) per thread (reused) + O(k L) for the routes
+    // up to k loopless routes, cheapest first, into paths (route 0 is the shortest
+    // path). Yen's algorithm with Lawler's rule: a route only spurs from its own
+    // deviation point on, earlier spurs were already tried for its parent. returns
+    // the number of routes found
+    int kShortestPaths(int source, int target, int k, PathSet& paths) {
+        paths.clear();
+        if (!frozen) {
+            freeze();
+        }
+        if (source < 0 || source >= vertexCount || target < 0 || target >= vertexCount || k <= 0) {
+            return 0;
+        }
+        if (!reverseReady) {
+            buildReverse();
+        }
+        AlternativeRouteWorkspace& alt = alternativeRouteWorkspace();
+        ShortestPathWorkspace& ws = shortestPathWorkspace();
+        unsigned int queryEpoch = alt.nextEpoch(vertexCount);
+        
+        // reverse search: distance to target and next hop for everything within
+        // GRAPH_ALTERNATIVE_REACH times the route length. any vertex not settled is at
+        // least frontierFloor away, which keeps the bound below consistent
+        double sourceDistance = GRAPH_MAX_DISTANCE;
+        double frontierFloor = 0;
+        searchUntil(target, [&](int v, double distance) {
+            frontierFloor = distance;
+            if (sourceDistance < GRAPH_MAX_DISTANCE && distance > sourceDistance * GRAPH_ALTERNATIVE_REACH) {
+                return true;
+            }
+            alt.targetStamp[v] = queryEpoch;
+            alt.toTarget[v] = distance;
+            alt.nextHop[v] = ws.previous[v];
+            if (v == source) {
+                sourceDistance = distance;
+            }
+            return false;
+        }, [](int) { return 0.0; }, reverseOffsets, reverseTargets, reverseWeights);
+        if (sourceDistance >= GRAPH_MAX_DISTANCE) {
+            ws.owner = nullptr;
+            return 0;
+        }
+        
+        // route 0 straight off the reverse tree
+        int length = 0;
+        for (int v = source; v != -1; v = alt.nextHop[v]) {
+            alt.route[length] = v;
+            alt.routeCosts[length] = sourceDistance - alt.toTarget[v];
+            length++;
+        }
+        paths.add(alt.route, alt.routeCosts, length, 0);
+        
+        PathSet& candidates = alt.candidates;
+        candidates.clear();
+        auto estimate = [&](int v) {
+            return alt.targetStamp[v] == queryEpoch ? alt.toTarget[v] : frontierFloor;
+        };
+        while (paths.size() < k) {
+            int lastLength = 0;
+            const int* last = paths.path(paths.size() - 1, lastLength);
+            const double* lastCosts = paths.costs(paths.size() - 1);
+            
+            for (int i = paths.deviation(paths.size() - 1); i < lastLength - 1; i++) {
+                int spur = last[i];
+                unsigned int spurEpoch = alt.nextEpoch(vertexCount);
+                
+                // the root may not be revisited, and no known route may be repeated
+                for (int j = 0; j < i; j++) {
+                    alt.blockedVertex[last[j]] = spurEpoch;
+                }
+                for (int p = 0; p < paths.size(); p++) {
+                    int otherLength = 0;
+                    const int* other = paths.path(p, otherLength);
+                    int shared = 0;
+                    while (shared <= i && shared < otherLength && other[shared] == last[shared]) {
+                        shared++;
+                    }
+                    if (shared == i + 1 && otherLength > i + 1) {
+                        alt.blockedSpurEdge[other[i + 1]] = spurEpoch;
+                    }
+                }
+                
+                // with exact distances to target the first settled vertex whose reverse
+                // tree chain is still open completes the cheapest spur path: its key
+                // already is the full cost, and every other key is a lower bound
+                auto chainOpen = [&](int v) {
+                    int u = v;
+                    bool open = true;
+                    while (u != target) {
+                        if (alt.chainClear[u] == spurEpoch) {
+                            break;
+                        }
+                        int next = alt.nextHop[u];
+                        if (alt.chainBlocked[u] == spurEpoch || alt.blockedVertex[next] == spurEpoch ||
+                            next == spur || (u == spur && alt.blockedSpurEdge[next] == spurEpoch)) {
+                            open = false;
+                            break;
+                        }
+                        u = next;
+                    }
+                    unsigned int* verdict = open ? alt.chainClear : alt.chainBlocked;
+                    for (int w = v; w != u; w = alt.nextHop[w]) {
+                        verdict[w] = spurEpoch;
+                    }
+                    if (!open) {
+                        alt.chainBlocked[u] = spurEpoch;
+                    }
+                    return open;
+                };
+                int meet = -1;
+                searchUntil(spur, [&](int v, double) {
+                    if (v == target || (alt.targetStamp[v] == queryEpoch && chainOpen(v))) {
+                        meet = v;
+                    }
+                    return meet != -1;
+                }, estimate, [&](int from, int to) {
+                    return alt.blockedVertex[to] != spurEpoch &&
+                           (from != spur || alt.blockedSpurEdge[to] != spurEpoch);
+                }, csrOffsets, csrTargets, csrWeights);
+                if (meet == -1) {
+                    continue;
+                }
+                
+                // root + searched part up to meet + reverse tree chain from meet
+                int spurLength = 0;
+                for (int v = meet; v != -1; v = ws.previous[v]) {
+                    spurLength++;
+                }
+                for (int j = 0; j < i; j++) {
+                    alt.route[j] = last[j];
+                    alt.routeCosts[j] = lastCosts[j];
+                }
+                int position = i + spurLength - 1;
+                for (int v = meet; v != -1; v = ws.previous[v]) {
+                    alt.route[position] = v;
+                    alt.routeCosts[position] = lastCosts[i] + ws.distance[v];
+                    position--;
+                }
+                int routeLength = i + spurLength;
+                double meetCost = alt.routeCosts[routeLength - 1];
+                for (int v = meet; v != target; ) {
+                    v = alt.nextHop[v];
+                    alt.route[routeLength] = v;
+                    alt.routeCosts[routeLength] = meetCost + alt.toTarget[meet] - alt.toTarget[v];
+                    routeLength++;
+                }
+                if (!candidates.contains(alt.route, routeLength)) {
+                    candidates.add(alt.route, alt.routeCosts, routeLength, i);
+                }
+            }
+            
+            int best = candidates.cheapest();
+            if (best == -1) {
+                break;
+            }
+            int bestLength = 0;
+            const int* bestPath = candidates.path(best, bestLength);
+            paths.add(bestPath, candidates.costs(best), bestLength, candidates.deviation(best));
+            candidates.remove(best);
+        }
+        ws.owner = nullptr;     // the last spur search belongs to no caller
+        return paths.size();
+    }
+    
     // Graph::dijkstra(startName, distances, previous)
-    // Time: O(V²) - current array-based implementation; TODO: optimize to O((V+E)log V) with heap
-    // Space: O(V) - arrays for distances, previous, visited
+    // Time: O((V + E) log V) - full shortestPath run, then copied out
+    // Space: O(1) extra - fills the caller's arrays
     void dijkstra(const char* startName, double* distances, int* previous) {
-        int startIndex = findVertexIndex(startName);
-        if (startIndex == -1) return;
+        dijkstra(findVertexIndex(startName), distances, previous);
+    }
+    
+    // Graph::dijkstra(startIndex, distances, previous)
+    // Time: O((V + E) log V)
+    // Space: O(1) extra
+    void dijkstra(int startIndex, double* distances, int* previous) {
+        if (startIndex < 0 || startIndex >= vertexCount) return;
         
-        // initialize
-        bool* visited = new bool[vertexCount];
+        shortestPath(startIndex, -1);
         for (int i = 0; i < vertexCount; i++) {
-            distances[i] = GRAPH_MAX_DISTANCE;
-            previous[i] = -1;
-            visited[i] = false;
+            distances[i] = distanceTo(i);
+            previous[i] = previousOf(i);
+        }
+    }
+    
+    // Graph::deltaWidth()
+    // Time: O(E)
+    // Space: O(1)
+    // bucket width deltaStepping picks on its own: the heaviest edge over the
+    // average out-degree, so a bucket holds about one edge's worth of distance
+    // spread over the neighbours. never narrower than the average edge, so a
+    // graph of many light edges and a few very heavy ones does not end up with
+    // a bucket per vertex
+    double deltaWidth() {
+        if (!frozen) {
+            freeze();
+        }
+        int edgeTotal = csrOffsets[vertexCount];
+        if (edgeTotal == 0) {
+            return 1.0;
+        }
+        double heaviest = 0;
+        double total = 0;
+        for (int e = 0; e < edgeTotal; e++) {
+            if (csrWeights[e] > heaviest) {
+                heaviest = csrWeights[e];
+            }
+            total += csrWeights[e];
+        }
+        double width = heaviest * vertexCount / edgeTotal;
+        double average = total / edgeTotal;
+        if (width < average) {
+            width = average;
+        }
+        return width > 0 ? width : 1.0;
+    }
+    
+    // Graph::deltaStepping(startIndex, distances, previous, delta, threads)
+    // Time: O(V + E) work plus re-relaxations inside a bucket; about
+    //       O((V + E) / threads + B) wall clock for B non-empty buckets
+    // Space: O(V) shared + the bucket entries each part holds
+    // the same distances as dijkstra(startIndex, ...) from one search spread over
+    // many cores. vertices sit in buckets of width delta (delta <= 0 = deltaWidth())
+    // by tentative distance; all parts relax the lowest non-empty bucket together,
+    // lowering distances with a compare-and-swap, then meet at a barrier to pick
+    // the next one. a vertex lowered into the bucket being worked on is relaxed
+    // again, so a bucket needs no order inside, and every edge is relaxed the same
+    // way (no light / heavy split). a part keeps working through its own share of
+    // the current bucket while it stays small instead of waiting for the others.
+    // previous is rebuilt from the final distances afterwards, so it does not
+    // depend on how the threads interleaved; between equally short routes it may
+    // pick another predecessor than dijkstra would
+    void deltaStepping(int startIndex, double* distances, int* previous, double delta = 0, int threads = 0) {
+        if (startIndex < 0 || startIndex >= vertexCount) return;
+        if (!frozen) {
+            freeze();   // before the workers start: they only read the CSR arrays
+        }
+        if (!reverseReady) {
+            buildReverse();
+        }
+        if (delta <= 0) {
+            delta = deltaWidth();
+        }
+        if (threads <= 0) {
+            threads = hardwareThreads();
         }
-        distances[startIndex] = 0;
         
-        // main loop
-        for (int count = 0; count < vertexCount; count++) {
-            // find minimum distance vertex
-            double minDist = GRAPH_MAX_DISTANCE;
-            int minIndex = -1;
-            for (int i = 0; i < vertexCount; i++) {
-                if (!visited[i] && distances[i] < minDist) {
-                    minDist = distances[i];
-                    minIndex = i;
+        // one bucket list per part and bucket number, grown as buckets are reached
+        struct Bucket {
+            int* items;
+            int count;
+            int capacity;
+        };
+        const int FUSE_LIMIT = 1000;    // own share of a bucket worked through alone
+        const int CLAIM_CHUNK = 64;     // frontier entries taken per claim
+        const int NO_BUCKET = 0x7fffffff;
+        
+        int n = vertexCount;
+        std::atomic<double>* best = new std::atomic<double>[n];
+        for (int v = 0; v < n; v++) {
+            best[v].store(GRAPH_MAX_DISTANCE, std::memory_order_relaxed);
+        }
+        best[startIndex].store(0, std::memory_order_relaxed);
+        
+        int* frontier = new int[16];        // the bucket being relaxed, gathered from every part
+        int frontierCapacity = 16;
+        int frontierSize = 1;
+        frontier[0] = startIndex;
+        int currentBucket = 0;
+        std::atomic<int> claimed(0);
+        std::atomic<int> nextBucket(NO_BUCKET);
+        int* handOver = new int[threads + 1];   // entries each part adds to the next frontier
+        const int* offsets = csrOffsets;
+        const int* edgeTargets = csrTargets;
+        const double* weights = csrWeights;
+        
+        runTogether(threads, [&](int part, int running, ThreadBarrier& barrier) {
+            Bucket* buckets = nullptr;
+            int bucketCount = 0;
+            int* scratch = new int[16];
+            int scratchCapacity = 16;
+            
+            auto bucketOf = [&](double distance) {
+                double slot = distance / delta;
+                return slot < (double)(NO_BUCKET - 1) ? (int)slot : NO_BUCKET - 1;
+            };
+            auto push = [&](int bucket, int v) {
+                if (bucket >= bucketCount) {
+                    int grown = bucketCount > 0 ? bucketCount : 16;
+                    while (grown <= bucket) {
+                        grown = grown * 2;
+                    }
+                    Bucket* larger = new Bucket[grown];
+                    for (int b = 0; b < grown; b++) {
+                        if (b < bucketCount) {
+                            larger[b] = buckets[b];
+                        } else {
+                            larger[b].items = nullptr;
+                            larger[b].count = 0;
+                            larger[b].capacity = 0;
+                        }
+                    }
+                    delete[] buckets;
+                    buckets = larger;
+                    bucketCount = grown;
                 }
-            }
+                Bucket& list = buckets[bucket];
+                if (list.count == list.capacity) {
+                    int grown = list.capacity > 0 ? list.capacity * 2 : 8;
+                    int* items = new int[grown];
+                    for (int i = 0; i < list.count; i++) {
+                        items[i] = list.items[i];
+                    }
+                    delete[] list.items;
+                    list.items = items;
+                    list.capacity = grown;
+                }
+                list.items[list.count++] = v;
+            };
+            auto relax = [&](int u, int bucket) {
+                double reach = best[u].load(std::memory_order_relaxed);
+                if (bucketOf(reach) < bucket) {
+                    return;     // lowered again since it was queued; that entry came first
+                }
+                for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                    int v = edgeTargets[e];
+                    double candidate = reach + weights[e];
+                    double current = best[v].load(std::memory_order_relaxed);
+                    while (candidate < current) {
+                        if (best[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                            push(bucketOf(candidate), v);
+                            break;
+                        }
+                    }
+                }
+            };
             
-            if (minIndex == -1) break;
-            visited[minIndex] = true;
+            while (true) {
+                int bucket = currentBucket;
+                int from;
+                while ((from = claimed.fetch_add(CLAIM_CHUNK)) < frontierSize) {
+                    int to = from + CLAIM_CHUNK < frontierSize ? from + CLAIM_CHUNK : frontierSize;
+                    for (int i = from; i < to; i++) {
+                        relax(frontier[i], bucket);
+                    }
+                }
+                while (bucket < bucketCount && buckets[bucket].count > 0 &&
+                       buckets[bucket].count < FUSE_LIMIT) {
+                    Bucket& own = buckets[bucket];
+                    if (own.count > scratchCapacity) {
+                        delete[] scratch;
+                        scratchCapacity = own.capacity;
+                        scratch = new int[scratchCapacity];
+                    }
+                    int taken = own.count;
+                    for (int i = 0; i < taken; i++) {
+                        scratch[i] = own.items[i];
+                    }
+                    own.count = 0;
+                    for (int i = 0; i < taken; i++) {
+                        relax(scratch[i], bucket);
+                    }
+                }
+                
+                int lowest = bucket;
+                while (lowest < bucketCount && buckets[lowest].count == 0) {
+                    lowest++;
+                }
+                if (lowest < bucketCount) {
+                    int seen = nextBucket.load(std::memory_order_relaxed);
+                    while (lowest < seen && !nextBucket.compare_exchange_weak(seen, lowest)) {
+                    }
+                }
+                barrier.wait();
+                int chosen = nextBucket.load(std::memory_order_relaxed);
+                if (chosen == NO_BUCKET) {
+                    break;
+                }
+                handOver[part] = chosen < bucketCount ? buckets[chosen].count : 0;
+                barrier.wait();
+                if (part == 0) {
+                    int total = 0;
+                    for (int p = 0; p < running; p++) {
+                        int count = handOver[p];
+                        handOver[p] = total;
+                        total += count;
+                    }
+                    if (total > frontierCapacity) {
+                        while (frontierCapacity < total) {
+                            frontierCapacity = frontierCapacity * 2;
+                        }
+                        delete[] frontier;
+                        frontier = new int[frontierCapacity];
+                    }
+                    frontierSize = total;
+                    currentBucket = chosen;
+                    claimed.store(0, std::memory_order_relaxed);
+                    nextBucket.store(NO_BUCKET, std::memory_order_relaxed);
+                }
+                barrier.wait();
+                if (chosen < bucketCount) {
+                    Bucket& own = buckets[chosen];
+                    for (int i = 0; i < own.count; i++) {
+                        frontier[handOver[part] + i] = own.items[i];
+                    }
+                    delete[] own.items;
+                    own.items = nullptr;
+                    own.count = 0;
+                    own.capacity = 0;
+                }
+                barrier.wait();
+            }
             
-            // update distances of neighbors
-            Edge* edge = vertices[minIndex].edges;
-            while (edge != nullptr) {
-                int dest = edge->destIndex;
-                double weight = edge->weight;
-                if (!visited[dest] && distances[minIndex] + weight < distances[dest]) {
-                    distances[dest] = distances[minIndex] + weight;
-                    previous[dest] = minIndex;
+            for (int b = 0; b < bucketCount; b++) {
+                delete[] buckets[b].items;
+            }
+            delete[] buckets;
+            delete[] scratch;
+        });
+        delete[] frontier;
+        delete[] handOver;
+        
+        for (int v = 0; v < n; v++) {
+            distances[v] = best[v].load(std::memory_order_relaxed);
+        }
+        delete[] best;
+        
+        // predecessors from the settled distances: any in-edge that adds up exactly.
+        // an edge of weight 0 is only taken from a vertex that already has one, so
+        // equal-distance cycles cannot form loops in the tree
+        const int* inOffsets = reverseOffsets;
+        const int* inSources = reverseTargets;
+        const double* inWeights = reverseWeights;
+        const int PENDING = -2;
+        std::atomic<int> nextVertex(0);
+        std::atomic<int> pendingCount(0);
+        runParallel(threads, [&](int) {
+            int from;
+            while ((from = nextVertex.fetch_add(CLAIM_CHUNK)) < n) {
+                int to = from + CLAIM_CHUNK < n ? from + CLAIM_CHUNK : n;
+                for (int v = from; v < to; v++) {
+                    previous[v] = -1;
+                    if (v == startIndex || distances[v] >= GRAPH_MAX_DISTANCE) {
+                        continue;
+                    }
+                    for (int e = inOffsets[v]; e < inOffsets[v + 1]; e++) {
+                        if (inWeights[e] > 0 && distances[inSources[e]] + inWeights[e] == distances[v]) {
+                            previous[v] = inSources[e];
+                            break;
+                        }
+                    }
+                    if (previous[v] == -1) {
+                        previous[v] = PENDING;
+                        pendingCount.fetch_add(1);
+                    }
+                }
+            }
+        });
+        if (pendingCount.load() > 0) {
+            int* queue = new int[n];
+            int head = 0;
+            int tail = 0;
+            for (int v = 0; v < n; v++) {
+                if (previous[v] != PENDING) {
+                    continue;
+                }
+                for (int e = inOffsets[v]; e < inOffsets[v + 1]; e++) {
+                    int u = inSources[e];
+                    if (inWeights[e] == 0 && distances[u] == distances[v] &&
+                        (u == startIndex || previous[u] >= 0)) {
+                        previous[v] = u;
+                        queue[tail++] = v;
+                        break;
+                    }
+                }
+            }
+            while (head < tail) {
+                int u = queue[head++];
+                for (int e = csrOffsets[u]; e < csrOffsets[u + 1]; e++) {
+                    int v = csrTargets[e];
+                    if (previous[v] == PENDING && csrWeights[e] == 0 && distances[v] == distances[u]) {
+                        previous[v] = u;
+                        queue[tail++] = v;
+                    }
+                }
+            }
+            for (int v = 0; v < n; v++) {
+                if (previous[v] == PENDING) {
+                    previous[v] = -1;
                 }
-                edge = edge->next;
             }
+            delete[] queue;
+        }
+    }
+    
+    // Graph::distanceMatrix(sources, sourceCount, targets, targetCount, result, nearestLimit, threads)
+    // Time: O(N (V + E) log V / threads) wall clock worst case; each search stops
+    //       as soon as every target (or the nearestLimit closest ones) is settled
+    // Space: O(V + M) shared + one workspace per thread, nothing per search
+    // result[i * targetCount + j] = distance from sources[i] to targets[j]
+    // (GRAPH_MAX_DISTANCE if unreachable or not among the nearestLimit closest).
+    // rows are handed out one at a time to runParallel parts (threads <= 0 = all cores)
+    void distanceMatrix(const int* sources, int sourceCount, const int* targets, int targetCount,
+                        double* result, int nearestLimit = 0, int threads = 0) {
+        if (sourceCount <= 0 || targetCount <= 0) {
+            return;
+        }
+        if (!frozen) {
+            freeze();   // before the workers start: they only read the CSR arrays
         }
         
-        delete[] visited;
+        // vertex -> first column that wants it, columns chained for repeated targets
+        int* firstColumn = new int[vertexCount > 0 ? vertexCount : 1];
+        int* nextColumn = new int[targetCount];
+        for (int v = 0; v < vertexCount; v++) {
+            firstColumn[v] = -1;
+        }
+        int distinctTargets = 0;
+        for (int j = targetCount - 1; j >= 0; j--) {
+            int t = targets[j];
+            nextColumn[j] = -1;
+            if (t < 0 || t >= vertexCount) {
+                continue;
+            }
+            if (firstColumn[t] == -1) {
+                distinctTargets++;
+            }
+            nextColumn[j] = firstColumn[t];
+            firstColumn[t] = j;
+        }
+        int wanted = distinctTargets;
+        if (nearestLimit > 0 && nearestLimit < wanted) {
+            wanted = nearestLimit;
+        }
+        
+        if (threads <= 0) {
+            threads = hardwareThreads();
+        }
+        if (threads > sourceCount) {
+            threads = sourceCount;
+        }
+        std::atomic<int> nextRow(0);
+        const int* offsets = csrOffsets;
+        const int* edgeTargets = csrTargets;
+        const double* weights = csrWeights;
+        runParallel(threads, [&](int) {
+            int i;
+            while ((i = nextRow.fetch_add(1)) < sourceCount) {
+                double* row = result + (long long)i * targetCount;
+                for (int j = 0; j < targetCount; j++) {
+                    row[j] = GRAPH_MAX_DISTANCE;
+                }
+                int remaining = wanted;
+                if (remaining == 0) {
+                    continue;
+                }
+                searchUntil(sources[i], [&](int v, double distance) {
+                    if (firstColumn[v] == -1) {
+                        return false;
+                    }
+                    for (int j = firstColumn[v]; j != -1; j = nextColumn[j]) {
+                        row[j] = distance;
+                    }
+                    return --remaining == 0;
+                }, [](int) { return 0.0; }, offsets, edgeTargets, weights);
+            }
+        });
+        
+        delete[] firstColumn;
+        delete[] nextColumn;
     }
     
-    // get path from source to destination
-    void getPath(int* previous, int destIndex, int* path, int& pathLength) {
-        pathLength = 0;
-        if (previous[destIndex] == -1 && destIndex != 0) {
-            return; // no path
+    // Graph::betweenness(result, samples, threads, seed)
+    // Time: O(S (V + E) log V / threads) wall clock for S sources (all V, or samples)
+    // Space: O(threads * V) - per-part sums and path counts, one workspace per thread
+    // Brandes: result[v] = sum over ordered pairs (s, t) with s != v != t of the share
+    // of shortest s -> t paths through v (ties split by their path counts). with
+    // 0 < samples < V only that many random sources are searched and the sums scaled
+    // by V / samples, an unbiased estimate. sources go to runParallel parts one at a
+    // time; each part accumulates into its own array and the arrays are added up at
+    // the end. zero-weight ties are not counted as separate paths
+    void betweenness(double* result, int samples = 0, int threads = 0, unsigned int seed = 1) {
+        for (int v = 0; v < vertexCount; v++) {
+            result[v] = 0;
+        }
+        if (vertexCount < 3) {
+            return;
+        }
+        if (!frozen) {
+            freeze();   // before the workers start: they only read the CSR arrays
+        }
+        if (!reverseReady) {
+            buildReverse();
         }
         
-        // trace back
-        int current = destIndex;
-        int tempPath[100];
-        int tempLen = 0;
-        while (current != -1) {
-            tempPath[tempLen++] = current;
-            current = previous[current];
+        int* sources = new int[vertexCount];
+        for (int v = 0; v < vertexCount; v++) {
+            sources[v] = v;
+        }
+        int sourceCount = vertexCount;
+        if (samples > 0 && samples < vertexCount) {
+            // partial Fisher-Yates: the first samples entries become a random subset
+            for (int i = 0; i < samples; i++) {
+                seed = seed * 1103515245u + 12345u;
+                int j = i + (int)((seed >> 8) % (unsigned int)(vertexCount - i));
+                int swap = sources[i];
+                sources[i] = sources[j];
+                sources[j] = swap;
+            }
+            sourceCount = samples;
+        }
+        
+        if (threads <= 0) {
+            threads = hardwareThreads();
+        }
+        if (threads > sourceCount) {
+            threads = sourceCount;
         }
+        int n = vertexCount;
+        double* partSums = new double[(long long)threads * n];
+        for (long long i = 0; i < (long long)threads * n; i++) {
+            partSums[i] = 0;
+        }
+        std::atomic<int> nextSource(0);
+        const int* offsets = csrOffsets;
+        const int* edgeTargets = csrTargets;
+        const double* weights = csrWeights;
+        const int* inOffsets = reverseOffsets;
+        const int* inSources = reverseTargets;
+        const double* inWeights = reverseWeights;
+        runParallel(threads, [&](int part) {
+            double* sums = partSums + (long long)part * n;
+            double* sigma = new double[n];      // shortest paths from the source
+            double* delta = new double[n];      // dependency of the source on v
+            ShortestPathWorkspace& ws = shortestPathWorkspace();
+            int i;
+            while ((i = nextSource.fetch_add(1)) < sourceCount) {
+                int source = sources[i];
+                int settledCount = 0;
+                searchUntil(source, [&](int v, double) {
+                    ws.settledOrder[settledCount++] = v;
+                    return false;
+                }, [](int) { return 0.0; }, offsets, edgeTargets, weights);
+                const int* order = ws.settledOrder;
+                
+                // path counts in settle order: a predecessor on a shortest path is
+                // always settled first
+                for (int k = 0; k < settledCount; k++) {
+                    sigma[order[k]] = 0;
+                    delta[order[k]] = 0;
+                }
+                sigma[source] = 1;
+                for (int k = 1; k < settledCount; k++) {
+                    int v = order[k];
+                    double reach = ws.distance[v];
+                    double tolerance = 1e-9 * (reach > 1.0 ? reach : 1.0);
+                    double paths = 0;
+                    for (int e = inOffsets[v]; e < inOffsets[v + 1]; e++) {
+                        int u = inSources[e];
+                        if (ws.reached(u) && std::fabs(ws.distance[u] + inWeights[e] - reach) <= tolerance) {
+                            paths += sigma[u];
+                        }
+                    }
+                    sigma[v] = paths;
+                }
+                
+                // dependencies in reverse settle order, pushed back to predecessors
+                for (int k = settledCount - 1; k > 0; k--) {
+                    int w = order[k];
+                    if (sigma[w] == 0) {
+                        continue;
+                    }
+                    double reach = ws.distance[w];
+                    double tolerance = 1e-9 * (reach > 1.0 ? reach : 1.0);
+                    double share = (1.0 + delta[w]) / sigma[w];
+                    for (int e = inOffsets[w]; e < inOffsets[w + 1]; e++) {
+                        int u = inSources[e];
+                        if (ws.reached(u) && std::fabs(ws.distance[u] + inWeights[e] - reach) <= tolerance) {
+                            delta[u] += sigma[u] * share;
+                        }
+                    }
+                    sums[w] += delta[w];
+                }
+            }
+            delete[] sigma;
+            delete[] delta;
+        });
         
-        // reverse
-        for (int i = 0; i < tempLen; i++) {
-            path[i] = tempPath[tempLen - 1 - i];
+        double scale = (double)n / sourceCount;
+        for (int part = 0; part < threads; part++) {
+            const double* sums = partSums + (long long)part * n;
+            for (int v = 0; v < n; v++) {
+                result[v] += sums[v];
+            }
+        }
+        if (sourceCount < n) {
+            for (int v = 0; v < n; v++) {
+                result[v] *= scale;
+            }
+        }
+        delete[] partSums;
+        delete[] sources;
+    }
+    
+    // Graph::getBetweenness()
+    // Time: O(1) while the graph is unchanged, otherwise one betweenness run -
+    //       exact up to GRAPH_EXACT_BETWEENNESS vertices, sampled above
+    // Space: O(V) for the cached values
+    // betweenness of every vertex (see betweenness), nullptr for an empty graph
+    const double* getBetweenness() {
+        if (vertexCount == 0) {
+            return nullptr;
+        }
+        if (!centralityReady || centralityRevision != revision) {
+            delete[] centrality;
+            centrality = new double[vertexCount];
+            betweenness(centrality, vertexCount > GRAPH_EXACT_BETWEENNESS ? GRAPH_BETWEENNESS_SAMPLES : 0);
+            centralityRevision = revision;
+            centralityReady = true;
+        }
+        return centrality;
+    }
+    
+    // Graph::forEachEdge(v, visit)
+    // Time: O(deg(v)) - contiguous CSR scan (freezes first if needed)
+    // Space: O(1)
+    // visit(destIndex, weight) for every edge leaving v
+    template <typename Visitor>
+    void forEachEdge(int v, Visitor visit) {
+        if (!frozen) {
+            freeze();
+        }
+        if (v < 0 || v >= vertexCount) {
+            return;
+        }
+        for (int e = csrOffsets[v]; e < csrOffsets[v + 1]; e++) {
+            visit(csrTargets[e], csrWeights[e]);
+        }
+    }
+    
+    // Graph::forEachIncomingEdge(v, visit)
+    // Time: O(deg_in(v)), plus O(V + E) once to build the reversed arrays
+    // Space: O(V + E) for the reversed arrays, kept until the graph changes shape
+    // visit(sourceIndex, weight) for every edge arriving at v
+    template <typename Visitor>
+    void forEachIncomingEdge(int v, Visitor visit) {
+        if (!frozen) {
+            freeze();
         }
-        pathLength = tempLen;
+        if (!reverseReady) {
+            buildReverse();
+        }
+        if (v < 0 || v >= vertexCount) {
+            return;
+        }
+        for (int e = reverseOffsets[v]; e < reverseOffsets[v + 1]; e++) {
+            visit(reverseTargets[e], reverseWeights[e]);
+        }
+    }
+    
+    // number of directed edges (a bidirectional connection counts twice)
+    int getEdgeCount() {
+        return edgeCount;
+    }
+    
+    // changes whenever a vertex or edge is added, updated or removed
+    unsigned int getRevision() {
+        return revision;
     }
     
     // get vertex count
@@ -262,8 +2231,99 @@ public:
         }
     }
     
+    // Graph::displayComponents()
+    // Time: O(V alpha(V)) + O(V) per printed component
+    // Space: O(V) for the labels
+    // network health: how many disconnected pieces there are, and what is cut off
+    // from the largest one
+    void displayComponents() {
+        if (vertexCount == 0) {
+            return;
+        }
+        int* labels = new int[vertexCount];
+        int* sizes = new int[vertexCount];
+        int count = listComponents(labels, sizes);
+        int largest = 0;
+        for (int c = 1; c < count; c++) {
+            if (sizes[c] > sizes[largest]) {
+                largest = c;
+            }
+        }
+        cout << "Connected components: " << count << " (largest: " << sizes[largest] << " of "
+             << vertexCount << ")" << endl;
+        for (int c = 0; c < count; c++) {
+            if (c == largest) {
+                continue;
+            }
+            cout << "  [cut off] ";
+            int shown = 0;
+            for (int v = 0; v < vertexCount && shown < 10; v++) {
+                if (labels[v] == c) {
+                    cout << (shown > 0 ? ", " : "") << vertices[v].name;
+                    shown++;
+                }
+            }
+            if (sizes[c] > shown) {
+                cout << " ... (" << sizes[c] << " total)";
+            }
+            cout << endl;
+        }
+        delete[] labels;
+        delete[] sizes;
+    }
+    
+    // Graph::displayCriticalVertices(top)
+    // Time: getBetweenness + O(top * V) selection
+    // Space: O(top)
+    // the vertices the most shortest paths run through, as a share of all pairs
+    void displayCriticalVertices(int top) {
+        const double* values = getBetweenness();
+        if (values == nullptr || vertexCount < 3) {
+            return;
+        }
+        if (top > vertexCount) {
+            top = vertexCount;
+        }
+        double pairs = (double)(vertexCount - 1) * (vertexCount - 2);
+        bool* picked = new bool[vertexCount];
+        for (int v = 0; v < vertexCount; v++) {
+            picked[v] = false;
+        }
+        cout << "Critical points (share of shortest paths through them"
+             << (vertexCount > GRAPH_EXACT_BETWEENNESS ? ", sampled" : "") << "):" << endl;
+        for (int rank = 1; rank <= top; rank++) {
+            int best = -1;
+            for (int v = 0; v < vertexCount; v++) {
+                if (!picked[v] && (best == -1 || values[v] > values[best])) {
+                    best = v;
+                }
+            }
+            if (values[best] <= 0) {
+                break;
+            }
+            picked[best] = true;
+            cout << "  " << rank << ". " << vertices[best].name << " - "
+                 << 100.0 * values[best] / pairs << "%" << endl;
+        }
+        delete[] picked;
+    }
+    
+    // edge lists are not walked: the arena releases them in bulk
     ~Graph() {
         delete[] vertices;
+        delete vertexIndex;
+        delete[] csrOffsets;
+        delete[] csrTargets;
+        delete[] csrWeights;
+        delete[] landmarkFrom;
+        delete[] landmarkTo;
+        delete[] reverseOffsets;
+        delete[] reverseTargets;
+        delete[] reverseWeights;
+        delete[] componentParent;
+        delete[] componentSize;
+        delete[] centrality;
+        delete ownedArena;
     }
 };
 
@@ -0,0 +1,573 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include "String.h"
+#include "Arena.h"
+#include "Parallel.h"
+#include <iostream>
+#include <new>
+#include <utility>
+using namespace std;
+
+// ========== WORD-AT-A-TIME CASE FOLDING + HASHING ==========
+// keys are processed 8 bytes per step: each word is uppercased with bit tricks (SWAR)
+// and mixed into the hash in the same pass, so there is no copy, no toUpperCase
+// and no separate stringLength walk
+
+typedef unsigned long long HashWord;
+
+const HashWord HASH_ONES = 0x0101010101010101ULL;
+const HashWord HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+// loadWord(p, n)
+// Time: O(1) - at most 8 bytes; compilers turn the full-word case into one load
+// Space: O(1)
+// reads n <= 8 bytes little-endian, missing bytes are zero
+HashWord loadWord(const char* p, int n) {
+    HashWord word = 0;
+    for (int i = 0; i < n; i++) {
+        word |= (HashWord)(unsigned char)p[i] << (8 * i);
+    }
+    return word;
+}
+
+// foldWord(word)
+// Time: O(1) - uppercases 8 ASCII bytes at once without branches
+// Space: O(1)
+HashWord foldWord(HashWord word) {
+    HashWord low7 = word & (0x7F * HASH_ONES);
+    HashWord atLeastA = low7 + ((0x80 - 'a') * HASH_ONES);     // high bit set when byte >= 'a'
+    HashWord aboveZ = low7 + ((0x80 - 'z' - 1) * HASH_ONES);   // high bit set when byte > 'z'
+    HashWord isLower = (atLeastA ^ aboveZ) & ~word & (0x80 * HASH_ONES);
+    return word ^ (isLower >> 2);   // 0x80 >> 2 = 0x20 = case bit
+}
+
+// mixHashWord(hash, word)
+// Time: O(1)
+// Space: O(1)
+HashWord mixHashWord(HashWord hash, HashWord word) {
+    hash = (hash ^ word) * HASH_MULTIPLIER;
+    return hash ^ (hash >> 29);
+}
+
+// hashKeyFolded(key)
+// Time: O(k / 8) where k = key length
+// Space: O(1)
+// case-insensitive 64-bit hash ("g-10" and "G-10" hash the same)
+HashWord hashKeyFolded(StringView key) {
+    HashWord hash = (HashWord)key.length * HASH_MULTIPLIER;
+    int i = 0;
+    for (; i + 8 <= key.length; i += 8) {
+        hash = mixHashWord(hash, foldWord(loadWord(key.data + i, 8)));
+    }
+    if (i < key.length) {
+        hash = mixHashWord(hash, foldWord(loadWord(key.data + i, key.length - i)));
+    }
+    // final avalanche so the low bits (used for the bucket) depend on every byte
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// keyEqualsFolded(storedUpper, key)
+// Time: O(k / 8) - compares a word at a time
+// Space: O(1)
+// storedUpper is already uppercase and has the same length as key
+bool keyEqualsFolded(const char* storedUpper, StringView key) {
+    int i = 0;
+    for (; i + 8 <= key.length; i += 8) {
+        if (loadWord(storedUpper + i, 8) != foldWord(loadWord(key.data + i, 8))) {
+            return false;
+        }
+    }
+    if (i < key.length) {
+        int rest = key.length - i;
+        return loadWord(storedUpper + i, rest) == foldWord(loadWord(key.data + i, rest));
+    }
+    return true;
+}
+
+// ========== KEY TRAITS ==========
+// tells HashMap how to hash, compare and store a key type
+
+// default: integer-like keys (stop indices, ids, ...)
+template <typename K>
+struct HashKeyTraits {
+    static HashWord hash(const K& key) {
+        HashWord hash = ((HashWord)key + 1) * HASH_MULTIPLIER;
+        return hash ^ (hash >> 32);
+    }
+    static bool equals(const K& stored, const K& key) {
+        return stored == key;
+    }
+    static K store(const K& key, KeyArena&) {
+        return key;
+    }
+    static void release(const K&, KeyArena&) {
+    }
+};
+
+// string keys: CASE-INSENSITIVE, stored uppercase and null-terminated inside the arena
+template <>
+struct HashKeyTraits<StringView> {
+    static HashWord hash(const StringView& key) {
+        return hashKeyFolded(key);
+    }
+    static bool equals(const StringView& stored, const StringView& key) {
+        return stored.length == key.length && keyEqualsFolded(stored.data, key);
+    }
+    static StringView store(const StringView& key, KeyArena& arena) {
+        char* copy = arena.allocate(key.length + 1);
+        for (int i = 0; i < key.length; i += 8) {
+            int n = key.length - i < 8 ? key.length - i : 8;
+            HashWord word = foldWord(loadWord(key.data + i, n));
+            for (int b = 0; b < n; b++) {
+                copy[i + b] = (char)(word >> (8 * b));
+            }
+        }
+        copy[key.length] = '\0';
+        return StringView(copy, key.length);
+    }
+    // hands the copy made by store back to the arena for the next key of its size
+    static void release(const StringView& stored, KeyArena& arena) {
+        arena.release((char*)stored.data, stored.length + 1);
+    }
+};
+
+// ========== HASH MAP ==========
+// type-safe hash map for every sector's tables:
+//  - records are stored inline next to their key inside fixed chunks of entries,
+//    so an entry costs no allocation of its own and pointers to records never move
+//  - a separate Robin Hood index maps hash -> entry slot: linear probing over a
+//    power-of-two array, an entry further from home steals the slot of a richer
+//    one, the index doubles past 7/8 load and removal shifts back (no tombstones)
+//  - removed entries go on a free list and are reused by the next insert; so do
+//    their key bytes (KeyArena recycles them per size class)
+//  - values are moved or constructed in place (insert / emplace), never copied by the map
+template <typename K, typename V, typename KeyTraits = HashKeyTraits<K> >
+class HashMap {
+public:
+    // one stored pair, this is what iteration hands out
+    struct Entry {
+        K key;
+        V value;
+
+        template <typename... Args>
+        Entry(const K& k, Args&&... args) : key(k), value(std::forward<Args>(args)...) {}
+    };
+
+private:
+    static const int CHUNK_SIZE = 64;
+
+    // one block of CHUNK_SIZE entries; storage is raw until an entry is constructed
+    struct Chunk {
+        Entry* entries;
+        bool live[CHUNK_SIZE];
+        int nextFree[CHUNK_SIZE];
+
+        Chunk() {
+            entries = (Entry*)::operator new(sizeof(Entry) * CHUNK_SIZE);
+            for (int i = 0; i < CHUNK_SIZE; i++) {
+                live[i] = false;
+                nextFree[i] = -1;
+            }
+        }
+
+        ~Chunk() {
+            for (int i = 0; i < CHUNK_SIZE; i++) {
+                if (live[i]) {
+                    entries[i].~Entry();
+                }
+            }
+            ::operator delete(entries);
+        }
+    };
+
+    struct IndexSlot {
+        HashWord hash;
+        int entry;      // position in the chunked entry storage
+        int distance;   // -1 = empty
+
+        IndexSlot() {
+            hash = 0;
+            entry = -1;
+            distance = -1;
+        }
+    };
+
+    IndexSlot* index;
+    int capacity;   // always a power of two
+    int mask;
+    int count;
+
+    Chunk** chunks;
+    int chunkCount;
+    int chunkCapacity;
+    int usedEntries;    // entry slots handed out so far (live or on the free list)
+    int freeHead;       // first reusable entry slot, -1 = none
+
+    KeyArena keyArena;
+
+    // HashMap::entryAt(position)
+    // Time: O(1)
+    // Space: O(1)
+    Entry& entryAt(int position) {
+        return chunks[position / CHUNK_SIZE]->entries[position % CHUNK_SIZE];
+    }
+
+    // HashMap::findSlot(key, hash)
+    // Time: Average O(1) - Robin Hood probe, hashes compared before keys
+    // Space: O(1)
+    int findSlot(const K& key, HashWord hash) {
+        int slot = (int)(hash & (HashWord)mask);
+        int distance = 0;
+        while (true) {
+            IndexSlot& current = index[slot];
+            if (current.distance < distance) {
+                return -1;
+            }
+            if (current.hash == hash && KeyTraits::equals(entryAt(current.entry).key, key)) {
+                return slot;
+            }
+            slot = (slot + 1) & mask;
+            distance++;
+        }
+    }
+
+    // HashMap::placeSlot(slot)
+    // Time: Average O(1)
+    // Space: O(1)
+    void placeSlot(IndexSlot item) {
+        int slot = (int)(item.hash & (HashWord)mask);
+        item.distance = 0;
+        while (true) {
+            IndexSlot& current = index[slot];
+            if (current.distance < 0) {
+                current = item;
+                return;
+            }
+            if (current.distance < item.distance) {
+                IndexSlot temp = current;
+                current = item;
+                item = temp;
+            }
+            slot = (slot + 1) & mask;
+            item.distance++;
+        }
+    }
+
+    // HashMap::growIndex()
+    // Time: O(n) - only the small index slots move, records stay where they are
+    // Space: O(capacity)
+    void growIndex() {
+        IndexSlot* oldIndex = index;
+        int oldCapacity = capacity;
+
+        capacity = capacity * 2;
+        mask = capacity - 1;
+        index = new IndexSlot[capacity];
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldIndex[i].distance >= 0) {
+                placeSlot(oldIndex[i]);
+            }
+        }
+        delete[] oldIndex;
+    }
+
+    // HashMap::takeEntrySlot()
+    // Time: O(1) amortized - reuses the free list or appends (new chunk every CHUNK_SIZE entries)
+    // Space: O(1) amortized
+    int takeEntrySlot() {
+        if (freeHead != -1) {
+            int position = freeHead;
+            freeHead = chunks[position / CHUNK_SIZE]->nextFree[position % CHUNK_SIZE];
+            return position;
+        }
+        if (usedEntries == chunkCount * CHUNK_SIZE) {
+            if (chunkCount == chunkCapacity) {
+                chunkCapacity = chunkCapacity * 2;
+                Chunk** newChunks = new Chunk*[chunkCapacity];
+                for (int i = 0; i < chunkCount; i++) {
+                    newChunks[i] = chunks[i];
+                }
+                delete[] chunks;
+                chunks = newChunks;
+            }
+            chunks[chunkCount] = new Chunk();
+            chunkCount++;
+        }
+        return usedEntries++;
+    }
+
+    // HashMap::addEntry(key, hash, args)
+    // Time: Average O(1)
+    // Space: O(1) amortized
+    template <typename... Args>
+    V* addEntry(const K& key, HashWord hash, Args&&... args) {
+        if ((count + 1) * 8 > capacity * 7) {
+            growIndex();
+        }
+
+        int position = takeEntrySlot();
+        Chunk* chunk = chunks[position / CHUNK_SIZE];
+        Entry* entry = &chunk->entries[position % CHUNK_SIZE];
+        new (entry) Entry(KeyTraits::store(key, keyArena), std::forward<Args>(args)...);
+        chunk->live[position % CHUNK_SIZE] = true;
+
+        IndexSlot item;
+        item.hash = hash;
+        item.entry = position;
+        placeSlot(item);
+        count++;
+        return &entry->value;
+    }
+
+    HashMap(const HashMap&);
+    HashMap& operator=(const HashMap&);
+
+public:
+    // size is only a hint for the initial capacity, the map grows on demand
+    HashMap(int size = 16) {
+        capacity = 16;
+        while (capacity < size) {
+            capacity = capacity * 2;
+        }
+        mask = capacity - 1;
+        count = 0;
+        index = new IndexSlot[capacity];
+
+        chunkCapacity = 4;
+        chunkCount = 0;
+        chunks = new Chunk*[chunkCapacity];
+        usedEntries = 0;
+        freeHead = -1;
+    }
+
+    // HashMap::insert(key, value)
+    // Time: Average O(1)
+    // Space: O(1) amortized - value is moved into the map
+    // replaces the value if the key already exists
+    V* insert(const K& key, V&& value) {
+        return insertHashed(key, KeyTraits::hash(key), std::move(value));
+    }
+
+    // HashMap::insertHashed(key, hash, value)
+    // Time: Average O(1)
+    // Space: O(1) amortized
+    // same as insert, for callers that already hashed the key (e.g. to pick a shard)
+    V* insertHashed(const K& key, HashWord hash, V&& value) {
+        int slot = findSlot(key, hash);
+        if (slot != -1) {
+            V* existing = &entryAt(index[slot].entry).value;
+            *existing = std::move(value);
+            return existing;
+        }
+        return addEntry(key, hash, std::move(value));
+    }
+
+    // HashMap::emplace(key, args)
+    // Time: Average O(1)
+    // Space: O(1) amortized - value is constructed directly in its final place
+    // returns nullptr (and builds nothing) if the key already exists
+    template <typename... Args>
+    V* emplace(const K& key, Args&&... args) {
+        return emplaceHashed(key, KeyTraits::hash(key), std::forward<Args>(args)...);
+    }
+
+    // HashMap::emplaceHashed(key, hash, args)
+    // Time: Average O(1)
+    // Space: O(1) amortized
+    template <typename... Args>
+    V* emplaceHashed(const K& key, HashWord hash, Args&&... args) {
+        if (findSlot(key, hash) != -1) {
+            return nullptr;
+        }
+        return addEntry(key, hash, std::forward<Args>(args)...);
+    }
+
+    // HashMap::search(key)
+    // Time: Average O(1)
+    // Space: O(1)
+    V* search(const K& key) {
+        return searchHashed(key, KeyTraits::hash(key));
+    }
+
+    // HashMap::searchHashed(key, hash)
+    // Time: Average O(1)
+    // Space: O(1)
+    V* searchHashed(const K& key, HashWord hash) {
+        int slot = findSlot(key, hash);
+        if (slot == -1) {
+            return nullptr;
+        }
+        return &entryAt(index[slot].entry).value;
+    }
+
+    // check if key exists
+    bool contains(const K& key) {
+        return findSlot(key, KeyTraits::hash(key)) != -1;
+    }
+
+    // HashMap::remove(key)
+    // Time: Average O(1) - backward-shift in the index, entry slot goes on the free list
+    // Space: O(1)
+    bool remove(const K& key) {
+        return removeHashed(key, KeyTraits::hash(key));
+    }
+
+    // HashMap::removeHashed(key, hash)
+    // Time: Average O(1)
+    // Space: O(1) - the stored key's bytes go back to the key arena
+    bool removeHashed(const K& key, HashWord hash) {
+        int slot = findSlot(key, hash);
+        if (slot == -1) {
+            return false;
+        }
+
+        int position = index[slot].entry;
+        Chunk* chunk = chunks[position / CHUNK_SIZE];
+        KeyTraits::release(chunk->entries[position % CHUNK_SIZE].key, keyArena);
+        chunk->entries[position % CHUNK_SIZE].~Entry();
+        chunk->live[position % CHUNK_SIZE] = false;
+        chunk->nextFree[position % CHUNK_SIZE] = freeHead;
+        freeHead = position;
+
+        int next = (slot + 1) & mask;
+        while (index[next].distance > 0) {
+            index[slot] = index[next];
+            index[slot].distance--;
+            slot = next;
+            next = (next + 1) & mask;
+        }
+        index[slot] = IndexSlot();
+
+        count--;
+        return true;
+    }
+
+    // ========== ITERATION ==========
+    // walks the entry chunks directly: no key array to size up front
+    // and no second lookup per key (order is storage order, i.e. insertion order
+    // until removed slots get reused)
+
+    class Iterator {
+    private:
+        HashMap* map;
+        int position;
+
+        void skipDead() {
+            while (position < map->usedEntries &&
+                   !map->chunks[position / CHUNK_SIZE]->live[position % CHUNK_SIZE]) {
+                position++;
+            }
+        }
+
+    public:
+        Iterator(HashMap* owner, int start) {
+            map = owner;
+            position = start;
+            skipDead();
+        }
+
+        Entry& operator*() { return map->entryAt(position); }
+        Entry* operator->() { return &map->entryAt(position); }
+
+        Iterator& operator++() {
+            position++;
+            skipDead();
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+        bool operator==(const Iterator& other) const { return position == other.position; }
+    };
+
+    // range-for support: for (auto& entry : map) { entry.key / entry.value }
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, usedEntries); }
+
+    // HashMap::forEach(visit)
+    // Time: O(n) - one sequential pass, visit(key, value) per live entry
+    // Space: O(1)
+    template <typename Visitor>
+    void forEach(Visitor visit) {
+        forEachInChunks(0, chunkCount, visit);
+    }
+
+    // number of storage chunks, the unit used to split a scan into ranges
+    int getChunkCount() { return chunkCount; }
+
+    // HashMap::forEachInChunks(firstChunk, lastChunk, visit)
+    // Time: O(entries in the range)
+    // Space: O(1)
+    // visits live entries of chunks [firstChunk, lastChunk); disjoint ranges never share an entry
+    template <typename Visitor>
+    void forEachInChunks(int firstChunk, int lastChunk, Visitor visit) {
+        for (int c = firstChunk; c < lastChunk; c++) {
+            Chunk* chunk = chunks[c];
+            int limit = usedEntries - c * CHUNK_SIZE;
+            if (limit > CHUNK_SIZE) {
+                limit = CHUNK_SIZE;
+            }
+            for (int i = 0; i < limit; i++) {
+                if (chunk->live[i]) {
+                    visit(chunk->entries[i].key, chunk->entries[i].value);
+                }
+            }
+        }
+    }
+
+    // HashMap::suggestParallelParts()
+    // Time: O(1)
+    // Space: O(1)
+    // how many parts a parallel scan should use (never more parts than chunks)
+    int suggestParallelParts() {
+        int parts = hardwareThreads();
+        if (parts > chunkCount) {
+            parts = chunkCount;
+        }
+        return parts < 1 ? 1 : parts;
+    }
+
+    // HashMap::parallelForEach(parts, visit)
+    // Time: O(n / parts) wall clock
+    // Space: O(parts) threads
+    // splits the chunks into 'parts' contiguous ranges and scans them concurrently,
+    // calling visit(key, value, part); part lets callers keep per-thread results
+    // without locking (merging parts 0..parts-1 in order gives storage order)
+    // the map must not be modified while the scan runs
+    template <typename Visitor>
+    void parallelForEach(int parts, Visitor visit) {
+        if (parts < 1) {
+            parts = 1;
+        }
+        runParallel(parts, [this, parts, &visit](int part) {
+            int firstChunk = (int)((long long)chunkCount * part / parts);
+            int lastChunk = (int)((long long)chunkCount * (part + 1) / parts);
+            forEachInChunks(firstChunk, lastChunk, [&visit, part](const K& key, V& value) {
+                visit(key, value, part);
+            });
+        });
+    }
+
+    // get current count
+    int getCount() { return count; }
+
+    // get current size
+    int getSize() { return count; }
+
+    // check if empty
+    bool isEmpty() { return count == 0; }
+
+    ~HashMap() {
+        for (int i = 0; i < chunkCount; i++) {
+            delete chunks[i];
+        }
+        delete[] chunks;
+        delete[] index;
+    }
+};
+
+#endif
@@ -0,0 +1,307 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <iostream>
+#include <utility>
+using namespace std;
+
+// ========== INDEXED D-ARY HEAP ==========
+// one priority queue for everything that used MinHeap / MaxHeap:
+//  - the ordering is a compile-time policy (LowerFirst / HigherFirst), no copied classes
+//  - ARITY children per node; 4 keeps the tree shallow and a node's children
+//    next to each other in memory, which suits decrease-key heavy work like Dijkstra
+//  - storage grows on demand, nothing is ever dropped with "Heap is full!"
+//  - push returns a stable handle, so a priority can be changed (update) or an
+//    entry removed later in O(log n) without searching for it
+
+typedef int HeapHandle;
+const HeapHandle NO_HEAP_HANDLE = -1;
+
+// smallest priority comes out first (distances, costs)
+template <typename P>
+struct LowerFirst {
+    static bool before(const P& a, const P& b) { return a < b; }
+};
+
+// largest priority comes out first (free beds, urgency)
+template <typename P>
+struct HigherFirst {
+    static bool before(const P& a, const P& b) { return b < a; }
+};
+
+template <typename T, typename P = double, typename Order = LowerFirst<P>, int ARITY = 4>
+class IndexedHeap {
+private:
+    struct Item {
+        T value;
+        P priority;
+        HeapHandle handle;
+    };
+
+    Item* items;
+    int heapSize;
+    int capacity;
+
+    int* position;      // handle -> index in items, -1 while the handle is free
+    int* nextFree;      // free handle chain
+    int handleCapacity;
+    int handlesUsed;
+    int freeHandle;
+
+    IndexedHeap(const IndexedHeap&);
+    IndexedHeap& operator=(const IndexedHeap&);
+
+    // IndexedHeap::growItems()
+    // Time: O(n) - amortized O(1) per push
+    // Space: O(n)
+    void growItems() {
+        int newCapacity = capacity * 2;
+        Item* newItems = new Item[newCapacity];
+        for (int i = 0; i < heapSize; i++) {
+            newItems[i] = std::move(items[i]);
+        }
+        delete[] items;
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    // IndexedHeap::takeHandle()
+    // Time: O(1) amortized - free list first, array doubles when exhausted
+    // Space: O(1) amortized
+    HeapHandle takeHandle() {
+        if (freeHandle != NO_HEAP_HANDLE) {
+            HeapHandle handle = freeHandle;
+            freeHandle = nextFree[handle];
+            return handle;
+        }
+        if (handlesUsed == handleCapacity) {
+            int newCapacity = handleCapacity * 2;
+            int* newPosition = new int[newCapacity];
+            int* newNextFree = new int[newCapacity];
+            for (int i = 0; i < handlesUsed; i++) {
+                newPosition[i] = position[i];
+                newNextFree[i] = nextFree[i];
+            }
+            delete[] position;
+            delete[] nextFree;
+            position = newPosition;
+            nextFree = newNextFree;
+            handleCapacity = newCapacity;
+        }
+        return handlesUsed++;
+    }
+
+    // IndexedHeap::place(index, item)
+    // Time: O(1)
+    // Space: O(1)
+    void place(int index, Item& item) {
+        items[index] = std::move(item);
+        position[items[index].handle] = index;
+    }
+
+    // IndexedHeap::siftUp(index)
+    // Time: O(log_d n) - moves a hole up instead of swapping at every level
+    // Space: O(1)
+    void siftUp(int index) {
+        Item moving = std::move(items[index]);
+        while (index > 0) {
+            int parent = (index - 1) / ARITY;
+            if (!Order::before(moving.priority, items[parent].priority)) {
+                break;
+            }
+            place(index, items[parent]);
+            index = parent;
+        }
+        place(index, moving);
+    }
+
+    // IndexedHeap::siftDown(index)
+    // Time: O(d log_d n) - d child compares per level, iterative
+    // Space: O(1)
+    void siftDown(int index) {
+        Item moving = std::move(items[index]);
+        while (true) {
+            int first = index * ARITY + 1;
+            if (first >= heapSize) {
+                break;
+            }
+            int last = first + ARITY < heapSize ? first + ARITY : heapSize;
+            int best = first;
+            for (int c = first + 1; c < last; c++) {
+                if (Order::before(items[c].priority, items[best].priority)) {
+                    best = c;
+                }
+            }
+            if (!Order::before(items[best].priority, moving.priority)) {
+                break;
+            }
+            place(index, items[best]);
+            index = best;
+        }
+        place(index, moving);
+    }
+
+    // IndexedHeap::removeAt(index)
+    // Time: O(d log_d n)
+    // Space: O(1)
+    void removeAt(int index) {
+        HeapHandle handle = items[index].handle;
+        position[handle] = -1;
+        nextFree[handle] = freeHandle;
+        freeHandle = handle;
+
+        heapSize--;
+        if (index == heapSize) {
+            return;
+        }
+        place(index, items[heapSize]);
+        // the moved-in item may belong above or below this spot
+        if (index > 0 && Order::before(items[index].priority, items[(index - 1) / ARITY].priority)) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    }
+
+public:
+    // size is only a hint, the heap grows on demand
+    IndexedHeap(int size = 16) {
+        capacity = size > 4 ? size : 4;
+        heapSize = 0;
+        items = new Item[capacity];
+
+        handleCapacity = capacity;
+        handlesUsed = 0;
+        freeHandle = NO_HEAP_HANDLE;
+        position = new int[handleCapacity];
+        nextFree = new int[handleCapacity];
+    }
+
+    // IndexedHeap::push(value, priority)
+    // Time: O(log_d n), amortized O(1) extra when storage grows
+    // Space: O(1) amortized
+    // the returned handle stays valid until the entry is popped or removed
+    HeapHandle push(const T& value, P priority) {
+        if (heapSize == capacity) {
+            growItems();
+        }
+        HeapHandle handle = takeHandle();
+        items[heapSize].value = value;
+        items[heapSize].priority = priority;
+        items[heapSize].handle = handle;
+        position[handle] = heapSize;
+        heapSize++;
+        siftUp(heapSize - 1);
+        return handle;
+    }
+
+    // IndexedHeap::top()
+    // Time: O(1)
+    // Space: O(1)
+    // heap must not be empty
+    const T& top() {
+        return items[0].value;
+    }
+
+    // priority of the top entry (heap must not be empty)
+    P topPriority() {
+        return items[0].priority;
+    }
+
+    // handle of the top entry (heap must not be empty)
+    HeapHandle topHandle() {
+        return items[0].handle;
+    }
+
+    // IndexedHeap::pop()
+    // Time: O(d log_d n)
+    // Space: O(1)
+    // removes and returns the top value (heap must not be empty)
+    T pop() {
+        T value = items[0].value;
+        removeAt(0);
+        return value;
+    }
+
+    // IndexedHeap::update(handle, priority)
+    // Time: O(log_d n) for a move toward the top (decrease-key in a LowerFirst heap),
+    //       O(d log_d n) toward the bottom
+    // Space: O(1)
+    // false if the handle is no longer in the heap
+    bool update(HeapHandle handle, P priority) {
+        if (!contains(handle)) {
+            return false;
+        }
+        int index = position[handle];
+        P old = items[index].priority;
+        items[index].priority = priority;
+        if (Order::before(priority, old)) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+        return true;
+    }
+
+    // IndexedHeap::remove(handle)
+    // Time: O(d log_d n)
+    // Space: O(1)
+    // false if the handle is no longer in the heap
+    bool remove(HeapHandle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        removeAt(position[handle]);
+        return true;
+    }
+
+    // true while the entry behind handle is still queued
+    bool contains(HeapHandle handle) {
+        return handle >= 0 && handle < handlesUsed && position[handle] != -1;
+    }
+
+    // value stored behind a live handle
+    T& valueOf(HeapHandle handle) {
+        return items[position[handle]].value;
+    }
+
+    // priority stored behind a live handle
+    P priorityOf(HeapHandle handle) {
+        return items[position[handle]].priority;
+    }
+
+    // IndexedHeap::forEach(visit)
+    // Time: O(n) - storage order, not priority order
+    // Space: O(1)
+    template <typename Visitor>
+    void forEach(Visitor visit) {
+        for (int i = 0; i < heapSize; i++) {
+            visit(items[i].value, items[i].priority);
+        }
+    }
+
+    // IndexedHeap::clear()
+    // Time: O(1) - storage is kept for reuse, every handle becomes invalid
+    // Space: O(1)
+    void clear() {
+        heapSize = 0;
+        handlesUsed = 0;
+        freeHandle = NO_HEAP_HANDLE;
+    }
+
+    bool isEmpty() {
+        return heapSize == 0;
+    }
+
+    int size() {
+        return heapSize;
+    }
+
+    ~IndexedHeap() {
+        delete[] items;
+        delete[] position;
+        delete[] nextFree;
+    }
+};
+
+#endif
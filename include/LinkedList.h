@@ -2,24 +2,20 @@
 #define LINKEDLIST_H
 
 #include "String.h"
+#include "Arena.h"
 #include <iostream>
 using namespace std;
 
 // node for linked list (stores strings only)
+// nodes and their strings live in the list's arena, not on the heap one by one
 struct Node {
     char* data;
     Node* next;
     
-    Node(const char* val) {
-        int len = stringLength(val);
-        data = new char[len + 1];
-        stringCopy(data, val);
+    Node(char* storedValue) {
+        data = storedValue;
         next = nullptr;
     }
-    
-    ~Node() {
-        delete[] data;
-    }
 };
 
 // linked list for strings
@@ -28,12 +24,27 @@ private:
     Node* head;
     Node* tail;  // added for O(1) append as per spec
     int size;
+    CityArena* arena;       // where nodes come from (shared by the owning system, or our own)
+    CityArena* ownedArena;  // set only when no arena was handed in
+
+    // LinkedList::makeNode(value)
+    // Time: O(k) where k = value length
+    // Space: O(k) - node and string both come from the arena
+    Node* makeNode(const char* value) {
+        return arena->create<Node>(arena->copyString(value));
+    }
 
 public:
-    LinkedList() {
+    LinkedList(CityArena* sharedArena = nullptr) {
         head = nullptr;
         tail = nullptr;
         size = 0;
+        ownedArena = nullptr;
+        if (sharedArena == nullptr) {
+            ownedArena = new CityArena();
+            sharedArena = ownedArena;
+        }
+        arena = sharedArena;
     }
     
     // LinkedList::append(value)
@@ -46,7 +57,7 @@ public:
         stringCopy(upperValue, value);
         toUpperCase(upperValue);
         
-        Node* newNode = new Node(upperValue);
+        Node* newNode = makeNode(upperValue);
         if (head == nullptr) {
             head = newNode;
             tail = newNode;
@@ -61,7 +72,7 @@ public:
     // Time: O(1) - insert at head is constant time
     // Space: O(n) where n = value length for string storage
     void prepend(const char* value) {
-        Node* newNode = new Node(value);
+        Node* newNode = makeNode(value);
         newNode->next = head;
         head = newNode;
         if (tail == nullptr) {
@@ -136,7 +147,7 @@ public:
         Node* temp = head;
         while (temp != nullptr) {
             if (stringCompare(temp->data, stopID) == 0) {
-                Node* newNode = new Node(newStopID);
+                Node* newNode = makeNode(newStopID);
                 newNode->next = temp->next;
                 temp->next = newNode;
                 if (temp == tail) {
@@ -167,7 +178,7 @@ public:
             Node* temp = head;
             head = head->next;
             if (head == nullptr) tail = nullptr;
-            delete temp;
+            arena->destroy(temp);   // node slot is reused, the string waits for the arena
             size--; // Changed from count-- to size-- to match existing member variable
             return true;
         }
@@ -179,7 +190,7 @@ public:
                 Node* toDelete = current->next;
                 current->next = current->next->next;
                 if (toDelete == tail) tail = current;
-                delete toDelete;
+                arena->destroy(toDelete);
                 size--; // Changed from count-- to size-- to match existing member variable
                 return true;
             }
@@ -188,12 +199,9 @@ public:
         return false;
     }
     
+    // no walk over the nodes: they go back with the arena in one piece
     ~LinkedList() {
-        while (head != nullptr) {
-            Node* temp = head;
-            head = head->next;
-            delete temp;
-        }
+        delete ownedArena;
     }
 };
 
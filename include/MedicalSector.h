@@ -1,8 +1,9 @@
 #ifndef MEDICALSECTOR_H
 #define MEDICALSECTOR_H
 
-#include "HashTable.h"
-#include "MaxHeap.h"  // Changed to MaxHeap for emergency bed ranking (highest first)
+#include "HashMap.h"
+#include "SectorRegistry.h"
+#include "IndexedHeap.h"  // emergency bed ranking (most beds first, updatable)
 
 // Forward declaration for global access
 class PopulationSystem;
@@ -64,40 +65,42 @@ struct Medicine {
 struct Hospital {
     char hospitalID[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     int emergencyBeds;
     char specialization[200];
+    HeapHandle bedHandle;   // entry in the emergency bed ranking
     
     Hospital() {
         hospitalID[0] = '\0';
         name[0] = '\0';
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
         emergencyBeds = 0;
         specialization[0] = '\0';
+        bedHandle = NO_HEAP_HANDLE;
     }
 };
 
 struct Pharmacy {
     char pharmacyID[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     
     Pharmacy() {
         pharmacyID[0] = '\0';
         name[0] = '\0';
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
     }
 };
 
 // medical system class
 class MedicalSystem {
 private:
-    HashTable* hospitalTable;
-    HashTable* doctorTable;
-    HashTable* patientTable;
-    HashTable* medicineTable;
-    HashTable* pharmacyTable;
-    MaxHeap* emergencyBedHeap;  // MaxHeap for highest bed count priority
+    HashMap<StringView, Hospital>* hospitalTable;
+    HashMap<StringView, Doctor>* doctorTable;
+    HashMap<StringView, Patient>* patientTable;
+    HashMap<StringView, Medicine>* medicineTable;
+    HashMap<StringView, Pharmacy>* pharmacyTable;
+    IndexedHeap<Hospital*, int, HigherFirst<int> >* emergencyBedHeap;  // highest bed count first
     
     // Counters
     int hospitalCount;
@@ -109,12 +112,12 @@ private:
 
 public:
     MedicalSystem() {
-        hospitalTable = new HashTable(50);
-        doctorTable = new HashTable(100);
-        patientTable = new HashTable(500);
-        medicineTable = new HashTable(200);
-        pharmacyTable = new HashTable(50);
-        emergencyBedHeap = new MaxHeap(50);  // Use MaxHeap
+        hospitalTable = new HashMap<StringView, Hospital>(50);
+        doctorTable = new HashMap<StringView, Doctor>(100);
+        patientTable = new HashMap<StringView, Patient>(500);
+        medicineTable = new HashMap<StringView, Medicine>(200);
+        pharmacyTable = new HashMap<StringView, Pharmacy>(50);
+        emergencyBedHeap = new IndexedHeap<Hospital*, int, HigherFirst<int> >(50);
         hospitalCount = 0;
         doctorCount = 0;
         patientCount = 0;
@@ -126,15 +129,24 @@ public:
     // register hospital
     void registerHospital(const char* hospitalID, const char* name, const char* sector,
                          int beds, const char* specialization) {
-        Hospital* hospital = new Hospital();
-        stringCopyN(hospital->hospitalID, hospitalID, 50);
-        stringCopyN(hospital->name, name, 100);
-        stringCopyN(hospital->sector, sector, 50);
-        hospital->emergencyBeds = beds;
-        stringCopyN(hospital->specialization, specialization, 200);
-        
-        hospitalTable->insert(hospitalID, hospital);
-        emergencyBedHeap->insert(hospital, beds);  // Positive value for MaxHeap
+        Hospital hospital;
+        stringCopyN(hospital.hospitalID, hospitalID, 50);
+        stringCopyN(hospital.name, name, 100);
+        hospital.sectorId = internSector(sector);
+        hospital.emergencyBeds = beds;
+        stringCopyN(hospital.specialization, specialization, 200);
+        
+        // re-registering an ID replaces the record, so reuse its ranking entry
+        Hospital* existing = hospitalTable->search(hospitalID);
+        HeapHandle handle = existing != nullptr ? existing->bedHandle : NO_HEAP_HANDLE;
+        
+        Hospital* stored = hospitalTable->insert(hospitalID, std::move(hospital));
+        if (handle != NO_HEAP_HANDLE) {
+            stored->bedHandle = handle;
+            emergencyBedHeap->update(handle, beds);
+            return;
+        }
+        stored->bedHandle = emergencyBedHeap->push(stored, beds);
         hospitalCount++;
         
         // Hospital registered (quiet mode)
@@ -142,36 +154,36 @@ public:
     
     // register doctor
     void registerDoctor(const char* doctorID, const char* name, const char* specialization) {
-        Doctor* doctor = new Doctor();
-        stringCopyN(doctor->doctorID, doctorID, 50);
-        stringCopyN(doctor->name, name, 100);
-        stringCopyN(doctor->specialization, specialization, 100);
+        Doctor doctor;
+        stringCopyN(doctor.doctorID, doctorID, 50);
+        stringCopyN(doctor.name, name, 100);
+        stringCopyN(doctor.specialization, specialization, 100);
         
-        doctorTable->insert(doctorID, doctor);
+        doctorTable->insert(doctorID, std::move(doctor));
         doctorCount++;
         // cout << "Registered doctor: " << name << " (" << specialization << ")" << endl;
     }
     
     // add patient
     void addPatient(const char* patientID, const char* name, const char* condition) {
-        Patient* patient = new Patient();
-        stringCopyN(patient->patientID, patientID, 50);
-        stringCopyN(patient->name, name, 100);
-        stringCopyN(patient->condition, condition, 200);
+        Patient patient;
+        stringCopyN(patient.patientID, patientID, 50);
+        stringCopyN(patient.name, name, 100);
+        stringCopyN(patient.condition, condition, 200);
         
-        patientTable->insert(patientID, patient);
+        patientTable->insert(patientID, std::move(patient));
         patientCount++;
         // cout << "Added patient: " << name << endl;
     }
     
     // registering pharmacy
     void registerPharmacy(const char* pharmacyID, const char* name, const char* sector) {
-        Pharmacy* pharmacy = new Pharmacy();
-        stringCopyN(pharmacy->pharmacyID, pharmacyID, 50);
-        stringCopyN(pharmacy->name, name, 100);
-        stringCopyN(pharmacy->sector, sector, 50);
+        Pharmacy pharmacy;
+        stringCopyN(pharmacy.pharmacyID, pharmacyID, 50);
+        stringCopyN(pharmacy.name, name, 100);
+        pharmacy.sectorId = internSector(sector);
         
-        pharmacyTable->insert(pharmacyID, pharmacy);
+        pharmacyTable->insert(pharmacyID, std::move(pharmacy));
         pharmacyCount++;
         
         // Pharmacy registered (quiet mode)
@@ -180,13 +192,13 @@ public:
     // adding medicine
     void addMedicine(const char* medicineName, const char* formula, 
                     double price, const char* pharmacyID) {
-        Medicine* medicine = new Medicine();
-        stringCopyN(medicine->medicineName, medicineName, 100);
-        stringCopyN(medicine->formula, formula, 100);
-        medicine->price = price;
-        stringCopyN(medicine->pharmacyID, pharmacyID, 50);
+        Medicine medicine;
+        stringCopyN(medicine.medicineName, medicineName, 100);
+        stringCopyN(medicine.formula, formula, 100);
+        medicine.price = price;
+        stringCopyN(medicine.pharmacyID, pharmacyID, 50);
         
-        medicineTable->insert(medicineName, medicine);
+        medicineTable->insert(medicineName, std::move(medicine));
         medicineCount++;
         
         // Medicine added (quiet mode)
@@ -194,7 +206,7 @@ public:
     
     // searching for medicine
     void searchMedicine(const char* medicineName) {
-        Medicine* med = (Medicine*)medicineTable->search(medicineName);
+        Medicine* med = medicineTable->search(medicineName);
         if (med == nullptr) {
             cout << "Medicine not found!" << endl;
             return;
@@ -209,7 +221,7 @@ public:
     
     // displaying hospital
     void displayHospital(const char* hospitalID) {
-        Hospital* hosp = (Hospital*)hospitalTable->search(hospitalID);
+        Hospital* hosp = hospitalTable->search(hospitalID);
         if (hosp == nullptr) {
             cout << "Hospital not found!" << endl;
             return;
@@ -218,7 +230,7 @@ public:
         cout << "\n--- Hospital Details ---" << endl;
         cout << "Hospital ID: " << hosp->hospitalID << endl;
         cout << "Name: " << hosp->name << endl;
-        cout << "Sector: " << hosp->sector << endl;
+        cout << "Sector: " << sectorName(hosp->sectorId) << endl;
         cout << "Emergency Beds: " << hosp->emergencyBeds << endl;
         cout << "Specialization: " << hosp->specialization << endl;
     }
@@ -230,12 +242,50 @@ public:
             return;
         }
         
-        Hospital* topHospital = (Hospital*)emergencyBedHeap->getMax();  // getMax for MaxHeap
+        Hospital* topHospital = emergencyBedHeap->top();
         cout << "\n--- Hospital with Most Emergency Beds ---" << endl;
         cout << "Name: " << topHospital->name << endl;
         cout << "Emergency Beds: " << topHospital->emergencyBeds << endl;
     }
     
+    // MedicalSystem::updateHospitalBeds(hospitalID, beds)
+    // Time: O(log n) - the hospital's heap entry is moved in place via its handle
+    // Space: O(1)
+    bool updateHospitalBeds(const char* hospitalID, int beds) {
+        Hospital* hosp = hospitalTable->search(hospitalID);
+        if (hosp == nullptr) {
+            return false;
+        }
+        hosp->emergencyBeds = beds;
+        emergencyBedHeap->update(hosp->bedHandle, beds);
+        return true;
+    }
+    
+    // update bed count from user input
+    void updateHospitalBedsManual() {
+        char hospitalID[50];
+        int beds;
+        
+        cout << "\n=== Update Emergency Beds ===" << endl;
+        cout << "Enter hospital ID: ";
+        cin >> hospitalID;
+        cout << "Enter available emergency beds: ";
+        cin >> beds;
+        
+        if (cin.fail() || beds < 0) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            cout << "[ERROR] Invalid bed count!" << endl;
+            return;
+        }
+        
+        if (updateHospitalBeds(hospitalID, beds)) {
+            cout << "[SUCCESS] Emergency beds updated to " << beds << endl;
+        } else {
+            cout << "[ERROR] Hospital not found!" << endl;
+        }
+    }
+    
     // grabbing stats
     int getHospitalCount() { return hospitalCount; }
     int getPharmacyCount() { return pharmacyCount; }
@@ -260,28 +310,24 @@ public:
     void displayAllHospitals() {
         cout << "\n========== ALL HOSPITALS ==========" << endl;
         
-        char** hospKeys = new char*[100];
-        int count;
-        hospitalTable->getAllKeys(hospKeys, &count);
+        int count = hospitalTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No hospitals registered yet." << endl;
-            delete[] hospKeys;
             return;
         }
         
-        for (int i = 0; i < count; i++) {
-            Hospital* hosp = (Hospital*)hospitalTable->search(hospKeys[i]);
-            if (hosp != nullptr) {
-                cout << "\n[" << (i+1) << "] " << hosp->name << endl;
-                cout << "    ID: " << hosp->hospitalID << endl;
-                cout << "    Sector: " << hosp->sector << endl;
-                cout << "    Emergency Beds: " << hosp->emergencyBeds << endl;
-                cout << "    Specializations: " << hosp->specialization << endl;
-            }
+        int i = 0;
+        for (auto& entry : *hospitalTable) {
+            Hospital* hosp = &entry.value;
+            cout << "\n[" << (i+1) << "] " << hosp->name << endl;
+            cout << "    ID: " << hosp->hospitalID << endl;
+            cout << "    Sector: " << sectorName(hosp->sectorId) << endl;
+            cout << "    Emergency Beds: " << hosp->emergencyBeds << endl;
+            cout << "    Specializations: " << hosp->specialization << endl;
+            i++;
         }
         
-        delete[] hospKeys;
         cout << "\n==================================" << endl;
     }
     
@@ -289,26 +335,22 @@ public:
     void displayAllPharmacies() {
         cout << "\n========== ALL PHARMACIES ==========" << endl;
         
-        char** pharmKeys = new char*[100];
-        int count;
-        pharmacyTable->getAllKeys(pharmKeys, &count);
+        int count = pharmacyTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No pharmacies registered yet." << endl;
-            delete[] pharmKeys;
             return;
         }
         
-        for (int i = 0; i < count; i++) {
-            Pharmacy* pharm = (Pharmacy*)pharmacyTable->search(pharmKeys[i]);
-            if (pharm != nullptr) {
-                cout << "\n[" << (i+1) << "] " << pharm->name << endl;
-                cout << "    ID: " << pharm->pharmacyID << endl;
-                cout << "    Sector: " << pharm->sector << endl;
-            }
+        int i = 0;
+        for (auto& entry : *pharmacyTable) {
+            Pharmacy* pharm = &entry.value;
+            cout << "\n[" << (i+1) << "] " << pharm->name << endl;
+            cout << "    ID: " << pharm->pharmacyID << endl;
+            cout << "    Sector: " << sectorName(pharm->sectorId) << endl;
+            i++;
         }
         
-        delete[] pharmKeys;
         cout << "\n====================================" << endl;
     }
     
@@ -316,27 +358,23 @@ public:
     void displayAllMedicines() {
         cout << "\n========== ALL MEDICINES ==========" << endl;
         
-        char** medKeys = new char*[500];
-        int count;
-        medicineTable->getAllKeys(medKeys, &count);
+        int count = medicineTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No medicines registered yet." << endl;
-            delete[] medKeys;
             return;
         }
         
-        for (int i = 0; i < count; i++) {
-            Medicine* med = (Medicine*)medicineTable->search(medKeys[i]);
-            if (med != nullptr) {
-                cout << "\n[" << (i+1) << "] " << med->medicineName << endl;
-                cout << "    Formula: " << med->formula << endl;
-                cout << "    Price: $" << med->price << endl;
-                cout << "    Pharmacy: " << med->pharmacyID << endl;
-            }
+        int i = 0;
+        for (auto& entry : *medicineTable) {
+            Medicine* med = &entry.value;
+            cout << "\n[" << (i+1) << "] " << med->medicineName << endl;
+            cout << "    Formula: " << med->formula << endl;
+            cout << "    Price: $" << med->price << endl;
+            cout << "    Pharmacy: " << med->pharmacyID << endl;
+            i++;
         }
         
-        delete[] medKeys;
         cout << "\n===================================" << endl;
     }
     
@@ -419,7 +457,7 @@ public:
         normalizeInput(pharmacyID);
         
         // making sure Check if pharmacy exists
-        Pharmacy* pharm = (Pharmacy*)pharmacyTable->search(pharmacyID);
+        Pharmacy* pharm = pharmacyTable->search(pharmacyID);
         if (pharm == nullptr) {
             cout << "\n[ERROR] Pharmacy " << pharmacyID << " does not exist!" << endl;
             cout << "[TIP] Register the pharmacy first, or check available pharmacies." << endl;
@@ -491,14 +529,14 @@ public:
         
         // Then add to medical system
         generateUniqueID("DOC", doctorID);
-        Doctor* doctor = new Doctor();
-        stringCopyN(doctor->doctorID, doctorID, 50);
-        stringCopyN(doctor->name, name, 100);
-        stringCopyN(doctor->cnic, cnic, 20);
-        stringCopyN(doctor->hospitalID, hospitalID, 50);
-        stringCopyN(doctor->specialization, specialization, 100);
+        Doctor doctor;
+        stringCopyN(doctor.doctorID, doctorID, 50);
+        stringCopyN(doctor.name, name, 100);
+        stringCopyN(doctor.cnic, cnic, 20);
+        stringCopyN(doctor.hospitalID, hospitalID, 50);
+        stringCopyN(doctor.specialization, specialization, 100);
         
-        doctorTable->insert(doctorID, doctor);
+        doctorTable->insert(doctorID, std::move(doctor));
         
         cout << "\n[OK] Doctor registered successfully!" << endl;
         cout << "Doctor ID: " << doctorID << endl;
@@ -508,32 +546,28 @@ public:
     void displayAllDoctors() {
         cout << "\n========== ALL DOCTORS ==========" << endl;
         
-        char** keys = new char*[1000];
-        int count;
-        doctorTable->getAllKeys(keys, &count);
+        int count = doctorTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No doctors registered yet." << endl;
             cout << "====================================" << endl;
-            delete[] keys;
             return;
         }
         
         cout << "Total Doctors: " << count << endl << endl;
         
-        for (int i = 0; i < count; i++) {
-            Doctor* doctor = (Doctor*)doctorTable->search(keys[i]);
-            if (doctor != nullptr) {
-                cout << "[" << (i+1) << "] " << doctor->name << endl;
-                cout << "    ID: " << doctor->doctorID << endl;
-                cout << "    CNIC: " << doctor->cnic << endl;
-                cout << "    Hospital: " << doctor->hospitalID << endl;
-                cout << "    Specialization: " << doctor->specialization << endl;
-                cout << endl;
-            }
+        int i = 0;
+        for (auto& entry : *doctorTable) {
+            Doctor* doctor = &entry.value;
+            cout << "[" << (i+1) << "] " << doctor->name << endl;
+            cout << "    ID: " << doctor->doctorID << endl;
+            cout << "    CNIC: " << doctor->cnic << endl;
+            cout << "    Hospital: " << doctor->hospitalID << endl;
+            cout << "    Specialization: " << doctor->specialization << endl;
+            cout << endl;
+            i++;
         }
         
-        delete[] keys;
         cout << "====================================" << endl;
     }
     
@@ -614,15 +648,15 @@ public:
         
         // Then add to medical system
         generateUniqueID("PAT", patientID);
-        Patient* patient = new Patient();
-        stringCopyN(patient->patientID, patientID, 50);
-        stringCopyN(patient->name, name, 100);
-        stringCopyN(patient->cnic, cnic, 20);
-        stringCopyN(patient->hospitalID, hospitalID, 50);
-        patient->age = age;
-        stringCopyN(patient->condition, condition, 200);
+        Patient patient;
+        stringCopyN(patient.patientID, patientID, 50);
+        stringCopyN(patient.name, name, 100);
+        stringCopyN(patient.cnic, cnic, 20);
+        stringCopyN(patient.hospitalID, hospitalID, 50);
+        patient.age = age;
+        stringCopyN(patient.condition, condition, 200);
         
-        patientTable->insert(patientID, patient);
+        patientTable->insert(patientID, std::move(patient));
         
         cout << "\n[OK] Patient registered successfully!" << endl;
         cout << "Patient ID: " << patientID << endl;
@@ -632,33 +666,29 @@ public:
     void displayAllPatients() {
         cout << "\n========== ALL PATIENTS ==========" << endl;
         
-        char** keys = new char*[1000];
-        int count;
-        patientTable->getAllKeys(keys, &count);
+        int count = patientTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No patients registered yet." << endl;
             cout << "=====================================" << endl;
-            delete[] keys;
             return;
         }
         
         cout << "Total Patients: " << count << endl << endl;
         
-        for (int i = 0; i < count; i++) {
-            Patient* patient = (Patient*)patientTable->search(keys[i]);
-            if (patient != nullptr) {
-                cout << "[" << (i+1) << "] " << patient->name << endl;
-                cout << "    ID: " << patient->patientID << endl;
-                cout << "    CNIC: " << patient->cnic << endl;
-                cout << "    Hospital: " << patient->hospitalID << endl;
-                cout << "    Age: " << patient->age << endl;
-                cout << "    Condition: " << patient->condition << endl;
-                cout << endl;
-            }
+        int i = 0;
+        for (auto& entry : *patientTable) {
+            Patient* patient = &entry.value;
+            cout << "[" << (i+1) << "] " << patient->name << endl;
+            cout << "    ID: " << patient->patientID << endl;
+            cout << "    CNIC: " << patient->cnic << endl;
+            cout << "    Hospital: " << patient->hospitalID << endl;
+            cout << "    Age: " << patient->age << endl;
+            cout << "    Condition: " << patient->condition << endl;
+            cout << endl;
+            i++;
         }
         
-        delete[] keys;
         cout << "=====================================" << endl;
     }
     
@@ -671,32 +701,23 @@ public:
         cin.getline(formula, 100);
         toUpperCase(formula);
         
-        // Get all medicine keys
-        char** medKeys = new char*[500];
-        int count;
-        medicineTable->getAllKeys(medKeys, &count);
-        
         bool found = false;
         cout << "\n--- Medicines with Formula " << formula << " ---" << endl;
         
-        for (int i = 0; i < count; i++) {
-            Medicine* med = (Medicine*)medicineTable->search(medKeys[i]);
-            if (med != nullptr) {
-                char upperFormula[100];
-                stringCopy(upperFormula, med->formula);
-                toUpperCase(upperFormula);
-                
-                if (stringCompare(upperFormula, formula) == 0) {
-                    cout << "  - " << med->medicineName << endl;
-                    cout << "    Price: $" << med->price << endl;
-                    cout << "    Pharmacy: " << med->pharmacyID << endl;
-                    found = true;
-                }
+        for (auto& entry : *medicineTable) {
+            Medicine* med = &entry.value;
+            char upperFormula[100];
+            stringCopy(upperFormula, med->formula);
+            toUpperCase(upperFormula);
+            
+            if (stringCompare(upperFormula, formula) == 0) {
+                cout << "  - " << med->medicineName << endl;
+                cout << "    Price: $" << med->price << endl;
+                cout << "    Pharmacy: " << med->pharmacyID << endl;
+                found = true;
             }
         }
         
-        delete[] medKeys;
-        
         if (!found) {
             cout << "[INFO] No medicines found with this formula." << endl;
         }
@@ -710,31 +731,20 @@ public:
         cout << "Enter your sector (e.g., G-10): ";
         cin >> userSector;
         normalizeInput(userSector);
-        
-        char** keys = new char*[100];
-        int count;
-        hospitalTable->getAllKeys(keys, &count);
+        SectorId userSectorId = findSector(userSector);   // resolved once, loop compares ints
         
         bool found = false;
         cout << "\n--- Hospitals in Your Sector ---" << endl;
         
-        for (int i = 0; i < count; i++) {
-            Hospital* hospital = (Hospital*)hospitalTable->search(keys[i]);
-            if (hospital != nullptr) {
-                char hospitalSector[50];
-                stringCopy(hospitalSector, hospital->sector);
-                normalizeInput(hospitalSector);
-                
-                if (stringCompare(hospitalSector, userSector) == 0) {
-                    cout << "  - " << hospital->name << endl;
-                    cout << "    Emergency Beds: " << hospital->emergencyBeds << endl;
-                    found = true;
-                }
+        for (auto& entry : *hospitalTable) {
+            Hospital* hospital = &entry.value;
+            if (userSectorId != NO_SECTOR && hospital->sectorId == userSectorId) {
+                cout << "  - " << hospital->name << endl;
+                cout << "    Emergency Beds: " << hospital->emergencyBeds << endl;
+                found = true;
             }
         }
         
-        delete[] keys;
-        
         if (!found) {
             cout << "[INFO] No hospitals found in your sector." << endl;
             cout << "Try the Top Emergency Hospital option." << endl;
@@ -749,30 +759,19 @@ public:
         cout << "Enter your sector (e.g., G-10): ";
         cin >> userSector;
         normalizeInput(userSector);
-        
-        char** keys = new char*[100];
-        int count;
-        pharmacyTable->getAllKeys(keys, &count);
+        SectorId userSectorId = findSector(userSector);   // resolved once, loop compares ints
         
         bool found = false;
         cout << "\n--- Pharmacies in Your Sector ---" << endl;
         
-        for (int i = 0; i < count; i++) {
-            Pharmacy* pharmacy = (Pharmacy*)pharmacyTable->search(keys[i]);
-            if (pharmacy != nullptr) {
-                char pharmacySector[50];
-                stringCopy(pharmacySector, pharmacy->sector);
-                normalizeInput(pharmacySector);
-                
-                if (stringCompare(pharmacySector, userSector) == 0) {
-                    cout << "  - " << pharmacy->name << endl;
-                    found = true;
-                }
+        for (auto& entry : *pharmacyTable) {
+            Pharmacy* pharmacy = &entry.value;
+            if (userSectorId != NO_SECTOR && pharmacy->sectorId == userSectorId) {
+                cout << "  - " << pharmacy->name << endl;
+                found = true;
             }
         }
         
-        delete[] keys;
-        
         if (!found) {
             cout << "[INFO] No pharmacies found in your sector." << endl;
         }
@@ -781,22 +780,26 @@ public:
     // ========== VISUALIZATION HELPER METHODS ==========
     
     // Get all hospital keys for visualization
-    void getHospitalKeys(char** keys, int* count) {
-        hospitalTable->getAllKeys(keys, count);
+    // visit(Hospital&) for every hospital, straight from the table storage
+    template <typename Visitor>
+    void forEachHospital(Visitor visit) {
+        hospitalTable->forEach([&visit](const StringView&, Hospital& hospital) { visit(hospital); });
     }
     
     // Get hospital by ID
     Hospital* getHospital(const char* hospitalID) {
-        return (Hospital*)hospitalTable->search(hospitalID);
+        return hospitalTable->search(hospitalID);
     }
     
     // Pharmacy visualization helpers
-    void getPharmacyKeys(char** keys, int* count) {
-        pharmacyTable->getAllKeys(keys, count);
+    // visit(Pharmacy&) for every pharmacy, straight from the table storage
+    template <typename Visitor>
+    void forEachPharmacy(Visitor visit) {
+        pharmacyTable->forEach([&visit](const StringView&, Pharmacy& pharmacy) { visit(pharmacy); });
     }
     
     Pharmacy* getPharmacy(const char* pharmacyID) {
-        return (Pharmacy*)pharmacyTable->search(pharmacyID);
+        return pharmacyTable->search(pharmacyID);
     }
     
     ~MedicalSystem() {
@@ -0,0 +1,495 @@
+#ifndef MULTIMODALNETWORK_H
+#define MULTIMODALNETWORK_H
+
+#include "Graph.h"
+#include "TransportSector.h"
+#include "AirportSector.h"
+#include "RailwaySector.h"
+#include "SectorRegistry.h"
+#include <iostream>
+using namespace std;
+
+// ========== MULTIMODAL NETWORK ==========
+// the bus, rail and air graphs live in their own systems and never share a vertex,
+// so a trip like "bus to the airport, then fly" used to need three searches stitched
+// together by hand. this network copies the three graphs into one layered graph:
+//  - one layer per mode, vertex "BUS:Stop1", "RAIL:STN001", "AIR:ISB"
+//  - ride edges cost km * costPerKm[mode] (minutes per km, so faster modes are cheaper)
+//  - transfer edges join places of different modes: everything that shares a sector
+//    gets one automatically (DEFAULT_WALK_KM apart), addTransfer adds explicit links.
+//    a transfer costs the walk plus the boarding time of the mode being boarded
+// one findRoute over the layered graph then returns a mixed-mode itinerary. the
+// layered graph is rebuilt lazily whenever a source graph or the links change
+
+enum TravelMode {
+    MODE_BUS = 0,
+    MODE_RAIL = 1,
+    MODE_AIR = 2,
+    MODE_COUNT = 3
+};
+
+// travelModeName(mode)
+// Time: O(1)
+// Space: O(1)
+const char* travelModeName(int mode) {
+    if (mode == MODE_BUS) return "Bus";
+    if (mode == MODE_RAIL) return "Rail";
+    if (mode == MODE_AIR) return "Air";
+    return "Walk";
+}
+
+// explicit transfer between two places (ids as used by their own systems)
+struct TransferLink {
+    int fromMode;
+    char fromId[50];
+    int toMode;
+    char toId[50];
+    double walkKm;
+};
+
+class MultimodalNetwork {
+private:
+    static const char* const MODE_PREFIX[MODE_COUNT];
+
+    TransportSystem* buses;
+    RailwaySystem* rails;
+    AirportSystem* flights;
+
+    Graph* graph;                       // layered graph, nullptr until first use
+    CityArena* arena;                   // its edges and names; reset on every rebuild
+    int layerStart[MODE_COUNT + 1];     // layer m owns vertices [layerStart[m], layerStart[m + 1])
+    unsigned int builtRevision[MODE_COUNT];
+    bool dirty;                         // links or costs changed since the last build
+    unsigned int buildCount;            // rebuilds so far, lets dependants notice a new layout
+
+    double costPerKm[MODE_COUNT];
+    double boardingMinutes[MODE_COUNT];
+    double walkMinutesPerKm;
+
+    TransferLink* links;
+    int linkCount;
+    int linkCapacity;
+    int transferEdgeCount;
+
+    MultimodalNetwork(const MultimodalNetwork&);
+    MultimodalNetwork& operator=(const MultimodalNetwork&);
+
+    Graph* layer(int mode) {
+        if (mode == MODE_BUS) return buses->getStopGraph();
+        if (mode == MODE_RAIL) return rails->getStationGraph();
+        return flights->getAirportGraph();
+    }
+
+    // "BUS:" + id, cut to fit
+    static void layeredName(int mode, const char* id, char* out) {
+        stringCopy(out, MODE_PREFIX[mode]);
+        int used = stringLength(out);
+        stringCopyN(out + used, id, 100 - used);
+    }
+
+    // MultimodalNetwork::addTransferEdges(fromMode, fromIndex, toMode, toIndex, walkKm)
+    // Time: O(1) amortized
+    // Space: O(1) amortized
+    // both directions; the boarding time depends on the mode being boarded
+    void addTransferEdges(int fromMode, int fromIndex, int toMode, int toIndex, double walkKm) {
+        int a = layerStart[fromMode] + fromIndex;
+        int b = layerStart[toMode] + toIndex;
+        double walk = walkKm * walkMinutesPerKm;
+        graph->addEdge(a, b, walk + boardingMinutes[toMode]);
+        graph->addEdge(b, a, walk + boardingMinutes[fromMode]);
+        transferEdgeCount += 2;
+    }
+
+    // MultimodalNetwork::needsRebuild()
+    // Time: O(1)
+    // Space: O(1)
+    bool needsRebuild() {
+        if (graph == nullptr || dirty) {
+            return true;
+        }
+        for (int m = 0; m < MODE_COUNT; m++) {
+            if (layer(m)->getRevision() != builtRevision[m]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // MultimodalNetwork::rebuild()
+    // Time: O(V + E) for the layers + O(S * (A + R) + A * R) for the sector transfers
+    //       (S, A, R = stops, airports, stations; small city networks)
+    // Space: O(V + E) - the previous build's slabs are reused, not freed and re-allocated
+    void rebuild() {
+        delete graph;       // frees no edges or names: they all sit in the arena
+        arena->reset();
+        int total = 0;
+        for (int m = 0; m < MODE_COUNT; m++) {
+            layerStart[m] = total;
+            total += layer(m)->getVertexCount();
+        }
+        layerStart[MODE_COUNT] = total;
+        graph = new Graph(total > 0 ? total : 1, arena);
+
+        // vertices go in layer order, so layered index = layerStart[mode] + layer index.
+        // coordinates are left at 0: airports and stations have none, so routing uses
+        // landmarks (ALT) rather than a straight-line bound that would mix both
+        char name[100];
+        for (int m = 0; m < MODE_COUNT; m++) {
+            Graph* source = layer(m);
+            int n = source->getVertexCount();
+            for (int v = 0; v < n; v++) {
+                layeredName(m, source->getVertexName(v), name);
+                graph->addVertex(name, 0, 0);
+            }
+        }
+        for (int m = 0; m < MODE_COUNT; m++) {
+            Graph* source = layer(m);
+            int n = source->getVertexCount();
+            int offset = layerStart[m];
+            double rate = costPerKm[m];
+            for (int v = 0; v < n; v++) {
+                source->forEachEdge(v, [this, offset, rate, v](int dest, double km) {
+                    graph->addEdge(offset + v, offset + dest, km * rate);
+                });
+            }
+        }
+
+        // same sector = walking distance apart
+        transferEdgeCount = 0;
+        int stopCount = layer(MODE_BUS)->getVertexCount();
+        int stationCount = layer(MODE_RAIL)->getVertexCount();
+        int airportCount = layer(MODE_AIR)->getVertexCount();
+        SectorId* stopSector = new SectorId[stopCount > 0 ? stopCount : 1];
+        SectorId* stationSector = new SectorId[stationCount > 0 ? stationCount : 1];
+        SectorId* airportSector = new SectorId[airportCount > 0 ? airportCount : 1];
+        for (int i = 0; i < stopCount; i++) stopSector[i] = NO_SECTOR;
+        for (int i = 0; i < stationCount; i++) stationSector[i] = NO_SECTOR;
+        for (int i = 0; i < airportCount; i++) airportSector[i] = NO_SECTOR;
+
+        Graph* stopGraph = layer(MODE_BUS);
+        Graph* stationGraph = layer(MODE_RAIL);
+        Graph* airportGraph = layer(MODE_AIR);
+        buses->forEachStop([stopGraph, stopSector](BusStop& stop) {
+            int v = stopGraph->indexOf(stop.stopID);
+            if (v != -1) stopSector[v] = stop.sectorId;
+        });
+        rails->forEachStation([stationGraph, stationSector](RailStation& station) {
+            int v = stationGraph->indexOf(station.stationID);
+            if (v != -1) stationSector[v] = station.sectorId;
+        });
+        flights->forEachAirport([airportGraph, airportSector](Airport& airport) {
+            int v = airportGraph->indexOf(airport.code);
+            if (v != -1) airportSector[v] = airport.sectorId;
+        });
+
+        for (int s = 0; s < stopCount; s++) {
+            if (stopSector[s] == NO_SECTOR) continue;
+            for (int r = 0; r < stationCount; r++) {
+                if (stationSector[r] == stopSector[s]) {
+                    addTransferEdges(MODE_BUS, s, MODE_RAIL, r, DEFAULT_WALK_KM);
+                }
+            }
+            for (int a = 0; a < airportCount; a++) {
+                if (airportSector[a] == stopSector[s]) {
+                    addTransferEdges(MODE_BUS, s, MODE_AIR, a, DEFAULT_WALK_KM);
+                }
+            }
+        }
+        for (int r = 0; r < stationCount; r++) {
+            if (stationSector[r] == NO_SECTOR) continue;
+            for (int a = 0; a < airportCount; a++) {
+                if (airportSector[a] == stationSector[r]) {
+                    addTransferEdges(MODE_RAIL, r, MODE_AIR, a, DEFAULT_WALK_KM);
+                }
+            }
+        }
+        delete[] stopSector;
+        delete[] stationSector;
+        delete[] airportSector;
+
+        for (int i = 0; i < linkCount; i++) {
+            int from = layer(links[i].fromMode)->indexOf(links[i].fromId);
+            int to = layer(links[i].toMode)->indexOf(links[i].toId);
+            if (from != -1 && to != -1) {
+                addTransferEdges(links[i].fromMode, from, links[i].toMode, to, links[i].walkKm);
+            }
+        }
+
+        for (int m = 0; m < MODE_COUNT; m++) {
+            builtRevision[m] = layer(m)->getRevision();
+        }
+        dirty = false;
+        buildCount++;
+    }
+
+public:
+    static constexpr double DEFAULT_WALK_KM = 1.0;
+
+    MultimodalNetwork(TransportSystem* transport, RailwaySystem* railway, AirportSystem* airports) {
+        buses = transport;
+        rails = railway;
+        flights = airports;
+        graph = nullptr;
+        arena = new CityArena();
+        dirty = true;
+        buildCount = 0;
+        for (int m = 0; m <= MODE_COUNT; m++) {
+            layerStart[m] = 0;
+        }
+        for (int m = 0; m < MODE_COUNT; m++) {
+            builtRevision[m] = 0;
+        }
+        // minutes per km: ~30 km/h city bus, ~80 km/h train, ~500 km/h flight
+        costPerKm[MODE_BUS] = 2.0;
+        costPerKm[MODE_RAIL] = 0.75;
+        costPerKm[MODE_AIR] = 0.12;
+        // waiting / check-in before each boarding
+        boardingMinutes[MODE_BUS] = 5.0;
+        boardingMinutes[MODE_RAIL] = 10.0;
+        boardingMinutes[MODE_AIR] = 90.0;
+        walkMinutesPerKm = 12.0;
+        linkCapacity = 8;
+        linkCount = 0;
+        links = new TransferLink[linkCapacity];
+        transferEdgeCount = 0;
+    }
+
+    // MultimodalNetwork::setModeCost(mode, minutesPerKm, boarding)
+    // Time: O(1) - the layered graph is rebuilt on the next query
+    // Space: O(1)
+    void setModeCost(int mode, double minutesPerKm, double boarding) {
+        if (mode < 0 || mode >= MODE_COUNT || minutesPerKm <= 0 || boarding < 0) {
+            cout << "[ERROR] Invalid mode cost!" << endl;
+            return;
+        }
+        costPerKm[mode] = minutesPerKm;
+        boardingMinutes[mode] = boarding;
+        dirty = true;
+    }
+
+    // MultimodalNetwork::addTransfer(fromMode, fromId, toMode, toId, walkKm)
+    // Time: O(1) amortized + two name lookups
+    // Space: O(1) amortized
+    // explicit walking link between two places of different modes (both directions);
+    // false if either place does not exist
+    bool addTransfer(int fromMode, const char* fromId, int toMode, const char* toId, double walkKm) {
+        if (fromMode < 0 || fromMode >= MODE_COUNT || toMode < 0 || toMode >= MODE_COUNT ||
+            fromMode == toMode || walkKm < 0) {
+            cout << "[ERROR] A transfer joins two different modes!" << endl;
+            return false;
+        }
+        if (layer(fromMode)->indexOf(fromId) == -1 || layer(toMode)->indexOf(toId) == -1) {
+            cout << "[ERROR] " << travelModeName(fromMode) << " " << fromId << " or "
+                 << travelModeName(toMode) << " " << toId << " not found!" << endl;
+            return false;
+        }
+        if (linkCount == linkCapacity) {
+            int newCapacity = linkCapacity * 2;
+            TransferLink* newLinks = new TransferLink[newCapacity];
+            for (int i = 0; i < linkCount; i++) {
+                newLinks[i] = links[i];
+            }
+            delete[] links;
+            links = newLinks;
+            linkCapacity = newCapacity;
+        }
+        TransferLink& link = links[linkCount++];
+        link.fromMode = fromMode;
+        stringCopyN(link.fromId, fromId, 50);
+        link.toMode = toMode;
+        stringCopyN(link.toId, toId, 50);
+        link.walkKm = walkKm;
+        dirty = true;
+        return true;
+    }
+
+    // MultimodalNetwork::findPlace(id)
+    // Time: O(MODE_COUNT * k) - one name lookup per layer
+    // Space: O(1)
+    // layered vertex for an id from any system; "AIR:ISB" style prefixes pick the
+    // layer explicitly, otherwise bus stops win over stations over airports. -1 = unknown
+    int findPlace(const char* id) {
+        if (needsRebuild()) {
+            rebuild();
+        }
+        for (int m = 0; m < MODE_COUNT; m++) {
+            int prefixLength = stringLength(MODE_PREFIX[m]);
+            bool prefixed = true;
+            for (int i = 0; i < prefixLength; i++) {
+                char c = id[i];
+                if (c >= 'a' && c <= 'z') c = c - 'a' + 'A';
+                if (c != MODE_PREFIX[m][i]) {
+                    prefixed = false;
+                    break;
+                }
+            }
+            if (prefixed) {
+                int v = layer(m)->indexOf(id + prefixLength);
+                return v == -1 ? -1 : layerStart[m] + v;
+            }
+        }
+        for (int m = 0; m < MODE_COUNT; m++) {
+            int v = layer(m)->indexOf(id);
+            if (v != -1) {
+                return layerStart[m] + v;
+            }
+        }
+        return -1;
+    }
+
+    // MultimodalNetwork::route(from, to, path, length)
+    // Time: O(V + E) rebuild when something changed, then one findRoute on the
+    //       layered graph
+    // Space: O(1) per query - path points into the graph's per-thread workspace
+    // travel time in minutes, GRAPH_MAX_DISTANCE (length 0) if there is no route
+    double route(int from, int to, const int*& path, int& length) {
+        path = nullptr;
+        length = 0;
+        if (needsRebuild()) {
+            rebuild();
+        }
+        double minutes = graph->findRoute(from, to);
+        if (minutes < GRAPH_MAX_DISTANCE) {
+            path = graph->pathTo(to, length);
+        }
+        return minutes;
+    }
+
+    // MultimodalNetwork::planJourney(fromId, toId)
+    // Time: see route
+    // Space: O(1)
+    // prints the itinerary leg by leg: rides grouped per mode, transfers in between
+    void planJourney(const char* fromId, const char* toId) {
+        int from = findPlace(fromId);
+        int to = findPlace(toId);
+        if (from == -1 || to == -1) {
+            cout << "\n[ERROR] Unknown stop, station or airport!" << endl;
+            cout << "[TIP] Use a bus stop ID, station ID or airport code (e.g. Stop1, AIR:ISB)." << endl;
+            return;
+        }
+        const int* path = nullptr;
+        int length = 0;
+        double minutes = route(from, to, path, length);
+        if (minutes >= GRAPH_MAX_DISTANCE) {
+            cout << "\n[ERROR] No route between these places across bus, rail and air!" << endl;
+            cout << "[TIP] Places are linked when they share a sector, or via 'Add Transfer Link'." << endl;
+            return;
+        }
+
+        cout << "\n--- Multimodal Itinerary ---" << endl;
+        cout << "From: " << placeId(from) << " (" << travelModeName(modeOf(from)) << ")"
+             << "  To: " << placeId(to) << " (" << travelModeName(modeOf(to)) << ")" << endl;
+        double totalKm = 0;
+        int legs = 0;
+        int i = 0;
+        while (i < length - 1) {
+            int mode = modeOf(path[i]);
+            if (modeOf(path[i + 1]) != mode) {
+                cout << "  [Transfer] " << placeId(path[i]) << " -> " << placeId(path[i + 1])
+                     << " (board " << travelModeName(modeOf(path[i + 1])) << ")" << endl;
+                i++;
+                continue;
+            }
+            // ride: follow the path while it stays on this mode's layer
+            Graph* source = layer(mode);
+            double legKm = 0;
+            cout << "  [" << travelModeName(mode) << "] " << placeId(path[i]);
+            while (i < length - 1 && modeOf(path[i + 1]) == mode) {
+                int a = path[i] - layerStart[mode];
+                int b = path[i + 1] - layerStart[mode];
+                double best = GRAPH_MAX_DISTANCE;
+                source->forEachEdge(a, [b, &best](int dest, double km) {
+                    if (dest == b && km < best) best = km;
+                });
+                legKm += best;
+                i++;
+                cout << " -> " << placeId(path[i]);
+            }
+            cout << "  (" << legKm << " km)" << endl;
+            totalKm += legKm;
+            legs++;
+        }
+        if (length == 1) {
+            cout << "  Already there!" << endl;
+        }
+        cout << "Legs: " << legs << " | Distance travelled: " << totalKm << " km" << endl;
+        cout << "Estimated travel time: " << minutes << " min (incl. boarding and walking)" << endl;
+    }
+
+    // MultimodalNetwork::displaySummary()
+    // Time: O(V + E) if a rebuild is due
+    // Space: O(1)
+    void displaySummary() {
+        if (needsRebuild()) {
+            rebuild();
+        }
+        cout << "\n========== MULTIMODAL NETWORK ==========" << endl;
+        for (int m = 0; m < MODE_COUNT; m++) {
+            cout << "  " << travelModeName(m) << " layer: " << layerStart[m + 1] - layerStart[m]
+                 << " places, " << costPerKm[m] << " min/km, " << boardingMinutes[m]
+                 << " min boarding" << endl;
+        }
+        cout << "  Transfer edges: " << transferEdgeCount << " (" << linkCount << " explicit links)" << endl;
+        cout << "  Total: " << graph->getVertexCount() << " vertices, " << graph->getEdgeCount()
+             << " directed edges" << endl;
+        cout << "========================================" << endl;
+    }
+
+    // MultimodalNetwork::modeOf(v)
+    // Time: O(MODE_COUNT)
+    // Space: O(1)
+    int modeOf(int v) {
+        for (int m = 0; m < MODE_COUNT; m++) {
+            if (v < layerStart[m + 1]) {
+                return m;
+            }
+        }
+        return -1;
+    }
+
+    // id of a layered vertex in its own system (prefix stripped)
+    const char* placeId(int v) {
+        int mode = modeOf(v);
+        return layer(mode)->getVertexName(v - layerStart[mode]);
+    }
+
+    // layered vertex of a place given by its mode and its index in that mode's graph
+    int placeOf(int mode, int layerIndex) {
+        return layerStart[mode] + layerIndex;
+    }
+
+    // MultimodalNetwork::forEachTransfer(v, visit)
+    // Time: O(deg(v))
+    // Space: O(1)
+    // visit(place, minutes) for every transfer link out of v (walk + boarding time)
+    template <typename Visitor>
+    void forEachTransfer(int v, Visitor visit) {
+        int mode = modeOf(v);
+        graph->forEachEdge(v, [&](int dest, double minutes) {
+            if (modeOf(dest) != mode) {
+                visit(dest, minutes);
+            }
+        });
+    }
+
+    // rebuilds the layered graph now if a layer, a link or a cost changed
+    void refresh() {
+        if (needsRebuild()) {
+            rebuild();
+        }
+    }
+
+    int getPlaceCount() { return layerStart[MODE_COUNT]; }
+    unsigned int getBuildCount() { return buildCount; }
+    double getMinutesPerKm(int mode) { return costPerKm[mode]; }
+
+    ~MultimodalNetwork() {
+        delete graph;
+        delete arena;
+        delete[] links;
+    }
+};
+
+const char* const MultimodalNetwork::MODE_PREFIX[MODE_COUNT] = { "BUS:", "RAIL:", "AIR:" };
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <thread>
+using namespace std;
+
+// ========== THREAD HELPERS ==========
+// the web build is compiled without pthreads, so there everything just runs serially
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define ISB_NO_THREADS 1
+#endif
+
+// hardwareThreads()
+// Time: O(1)
+// Space: O(1)
+// how many threads are worth running at once (always at least 1)
+int hardwareThreads() {
+#ifdef ISB_NO_THREADS
+    return 1;
+#else
+    int count = (int)std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+#endif
+}
+
+// runParallel(parts, task)
+// Time: O(work / parts) wall clock when enough cores are free
+// Space: O(parts) - one thread per extra part
+// calls task(part) once for every part in [0, parts); part 0 runs on the calling thread
+// if a thread cannot be started its part simply runs on the caller instead
+template <typename Task>
+void runParallel(int parts, Task task) {
+    if (parts <= 1) {
+        task(0);
+        return;
+    }
+#ifdef ISB_NO_THREADS
+    for (int part = 0; part < parts; part++) {
+        task(part);
+    }
+#else
+    std::thread* workers = new std::thread[parts - 1];
+    for (int part = 1; part < parts; part++) {
+        try {
+            workers[part - 1] = std::thread([&task, part]() { task(part); });
+        } catch (...) {
+            task(part);
+        }
+    }
+    task(0);
+    for (int i = 0; i < parts - 1; i++) {
+        if (workers[i].joinable()) {
+            workers[i].join();
+        }
+    }
+    delete[] workers;
+#endif
+}
+
+// ========== THREAD BARRIER ==========
+// parts started together by runTogether meet here between phases: nobody
+// leaves wait() until all parties have arrived. waiting threads spin with a
+// yield, which suits short phases better than sleeping on a condition variable
+class ThreadBarrier {
+private:
+    std::atomic<int> arrived;
+    std::atomic<int> generation;
+    int parties;
+
+    ThreadBarrier(const ThreadBarrier&);
+    ThreadBarrier& operator=(const ThreadBarrier&);
+
+public:
+    ThreadBarrier(int partyCount) : arrived(0), generation(0) {
+        parties = partyCount > 0 ? partyCount : 1;
+    }
+
+    // ThreadBarrier::wait()
+    // Time: O(1) once the last party arrives
+    // Space: O(1)
+    // everything written before wait() is visible to every party after it
+    void wait() {
+        int round = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == parties) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        while (generation.load(std::memory_order_acquire) == round) {
+#ifndef ISB_NO_THREADS
+            std::this_thread::yield();
+#endif
+        }
+    }
+};
+
+// runTogether(parts, task)
+// Time: O(work / parts) wall clock when enough cores are free
+// Space: O(parts) - one thread per extra part
+// like runParallel, but the parts really run at the same time so they can wait
+// for each other: task(part, running, barrier) is called for every part in
+// [0, running) with a ThreadBarrier for exactly running parties. running is
+// parts unless threads could not be started (or there are no threads at all),
+// then the work has to be split over fewer parts
+template <typename Task>
+void runTogether(int parts, Task task) {
+#ifdef ISB_NO_THREADS
+    parts = 1;
+#endif
+    if (parts <= 1) {
+        ThreadBarrier alone(1);
+        task(0, 1, alone);
+        return;
+    }
+#ifndef ISB_NO_THREADS
+    // workers hold until the number that actually started is known
+    std::atomic<int> running(0);
+    ThreadBarrier* barrier = nullptr;
+    std::thread* workers = new std::thread[parts - 1];
+    int started = 0;
+    for (int part = 1; part < parts; part++) {
+        try {
+            workers[started] = std::thread([&task, &running, &barrier, part]() {
+                int count;
+                while ((count = running.load(std::memory_order_acquire)) == 0) {
+                    std::this_thread::yield();
+                }
+                task(part, count, *barrier);
+            });
+            started++;
+        } catch (...) {
+            break;
+        }
+    }
+    ThreadBarrier together(started + 1);
+    barrier = &together;
+    running.store(started + 1, std::memory_order_release);
+    task(0, started + 1, together);
+    for (int i = 0; i < started; i++) {
+        workers[i].join();
+    }
+    delete[] workers;
+#endif
+}
+
+#endif
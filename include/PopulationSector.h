@@ -2,7 +2,8 @@
 #define POPULATIONSECTOR_H
 
 #include "Tree.h"
-#include "HashTable.h"
+#include "ConcurrentHashMap.h"
+#include "SectorRegistry.h"
 #include "Utils.h"
 #include <iostream>
 using namespace std;
@@ -11,7 +12,7 @@ struct Citizen {
     char cnic[20];
     char name[100];
     int age;
-    char sector[50];
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     char street[50];
     char houseNo[20];
     char occupation[100];
@@ -21,7 +22,7 @@ struct Citizen {
         cnic[0] = '\0';
         name[0] = '\0';
         age = 0;
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
         street[0] = '\0';
         houseNo[0] = '\0';
         occupation[0] = '\0';
@@ -32,7 +33,7 @@ struct Citizen {
 class PopulationSystem {
 private:
     Tree* sectorHierarchy;
-    HashTable* citizenTable;
+    ConcurrentHashMap<StringView, Citizen>* citizenTable;   // citizens stored inline, keyed by CNIC (shared with other threads)
     int totalPopulation;
     
     // keeping count of stuff
@@ -54,7 +55,7 @@ private:
 public:
     PopulationSystem() {
         sectorHierarchy = new Tree();
-        citizenTable = new HashTable(1000);
+        citizenTable = new ConcurrentHashMap<StringView, Citizen>(1000);
         totalPopulation = 0;
         
         engineerCount = 0;
@@ -87,6 +88,7 @@ public:
         // Parse sector notation if it contains '/'
         char sector[50], subsector[50];
         parseSectorNotation(sectorName, sector, subsector);
+        internSector(sector);   // give the sector its id now so every system shares it
         
         // Add main sector
         bool added = sectorHierarchy->addNode("Islamabad", 0, sector);
@@ -113,25 +115,32 @@ public:
         return citizenTable->contains(cnic);
     }
     
-    Citizen* getCitizenByCNIC(const char* cnic) {
-        return (Citizen*)citizenTable->search(cnic);
+    // PopulationSystem::getCitizenByCNIC(cnic, copy)
+    // Time: Average O(1)
+    // Space: O(1)
+    // copies the record out under the table's shared lock, so an update from
+    // another thread can never be seen half written; false if the CNIC is unknown
+    bool getCitizenByCNIC(const char* cnic, Citizen& copy) {
+        return citizenTable->read(cnic, [&copy](const Citizen& citizen) { copy = citizen; });
     }
     
     // Update citizen address
     void updateCitizenAddress(const char* cnic, const char* sector, 
                              const char* street, const char* house) {
-        Citizen* citizen = getCitizenByCNIC(cnic);
-        if (citizen != nullptr) {
-            stringCopyN(citizen->sector, sector, 50);
-            stringCopyN(citizen->street, street, 50);
-            stringCopyN(citizen->houseNo, house, 20);
-            
+        SectorId sectorId = internSector(sector);
+        bool found = citizenTable->update(cnic, [&](Citizen& citizen) {
+            citizen.sectorId = sectorId;
+            stringCopyN(citizen.street, street, 50);
+            stringCopyN(citizen.houseNo, house, 20);
+        });
+        if (found) {
             // Auto-register new sector
             autoRegisterSector(sector);
         }
     }
     
     void addSector(const char* sectorName) {
+        internSector(sectorName);
         bool added = sectorHierarchy->addNode("Islamabad", 0, sectorName);
         if (added) {
             // cout << "Added sector: " << sectorName << endl;
@@ -145,19 +154,19 @@ public:
     
     // Add citizen to population (keeping it simple version for manual family registration)
     void addCitizen(const char* cnic, const char* name, int age, const char* occupation) {
-        Citizen* citizen = new Citizen();
-        stringCopyN(citizen->cnic, cnic, 20);
-        stringCopyN(citizen->name, name, 100);
-        citizen->age = age;
-        stringCopyN(citizen->occupation, occupation, 100); // Use 100 for occupation
+        Citizen citizen;
+        stringCopyN(citizen.cnic, cnic, 20);
+        stringCopyN(citizen.name, name, 100);
+        citizen.age = age;
+        stringCopyN(citizen.occupation, occupation, 100); // Use 100 for occupation
         
         // Default other fields for this keeping it simple addCitizen
-        stringCopyN(citizen->sector, "N/A", 50);
-        stringCopyN(citizen->street, "N/A", 50);
-        stringCopyN(citizen->houseNo, "N/A", 20);
-        stringCopyN(citizen->gender, "N/A", 10);
+        citizen.sectorId = internSector("N/A");
+        stringCopyN(citizen.street, "N/A", 50);
+        stringCopyN(citizen.houseNo, "N/A", 20);
+        stringCopyN(citizen.gender, "N/A", 10);
         
-        citizenTable->insert(cnic, citizen); // Use citizenTable
+        citizenTable->insert(cnic, std::move(citizen)); // stored inline in citizenTable
         totalPopulation++;
         
         // Update occupation counters (keeping it simple)
@@ -259,21 +268,21 @@ public:
         cout << "Enter CNIC: ";
         cin >> cnic;
         
-        Citizen* citizen = (Citizen*)citizenTable->search(cnic); // Use citizenTable
-        if (citizen == nullptr) {
+        Citizen citizen;
+        if (!getCitizenByCNIC(cnic, citizen)) {
             cout << "[INFO] Citizen not found." << endl;
             return;
         }
         
         cout << "\n--- Citizen Details ---" << endl;
-        cout << "CNIC: " << citizen->cnic << endl;
-        cout << "Name: " << citizen->name << endl;
-        cout << "Age: " << citizen->age << endl;
-        cout << "Occupation: " << citizen->occupation << endl;
+        cout << "CNIC: " << citizen.cnic << endl;
+        cout << "Name: " << citizen.name << endl;
+        cout << "Age: " << citizen.age << endl;
+        cout << "Occupation: " << citizen.occupation << endl;
         // Display other fields if available from addCitizen (N/A if not set)
-        cout << "Gender: " << citizen->gender << endl;
-        cout << "Address: House " << citizen->houseNo << ", Street " 
-             << citizen->street << ", " << citizen->sector << endl;
+        cout << "Gender: " << citizen.gender << endl;
+        cout << "Address: House " << citizen.houseNo << ", Street " 
+             << citizen.street << ", " << sectorName(citizen.sectorId) << endl;
     }
     
     // Update citizen address
@@ -336,17 +345,17 @@ public:
     void registerCitizen(const char* cnic, const char* name, int age, 
                         const char* sector, const char* street, const char* houseNo,
                         const char* occupation, const char* gender) {
-        Citizen* citizen = new Citizen();
-        stringCopyN(citizen->cnic, cnic, 20);
-        stringCopyN(citizen->name, name, 100);
-        citizen->age = age;
-        stringCopyN(citizen->sector, sector, 50);
-        stringCopyN(citizen->street, street, 50);
-        stringCopyN(citizen->houseNo, houseNo, 20);
-        stringCopyN(citizen->occupation, occupation, 100);
-        stringCopyN(citizen->gender, gender, 10);
-        
-        citizenTable->insert(cnic, citizen);
+        Citizen citizen;
+        stringCopyN(citizen.cnic, cnic, 20);
+        stringCopyN(citizen.name, name, 100);
+        citizen.age = age;
+        citizen.sectorId = internSector(sector);
+        stringCopyN(citizen.street, street, 50);
+        stringCopyN(citizen.houseNo, houseNo, 20);
+        stringCopyN(citizen.occupation, occupation, 100);
+        stringCopyN(citizen.gender, gender, 10);
+        
+        citizenTable->insert(cnic, std::move(citizen));
         totalPopulation++;
         
         // update occupation counters
@@ -381,20 +390,20 @@ public:
             return;
         }
         
-        Citizen* citizen = (Citizen*)citizenTable->search(cnic);
-        if (citizen == nullptr) {
+        Citizen citizen;
+        if (!getCitizenByCNIC(cnic, citizen)) {
             cout << "Citizen not found!" << endl;
             return;
         }
         
         cout << "\n--- Citizen Details ---" << endl;
-        cout << "CNIC: " << citizen->cnic << endl;
-        cout << "Name: " << citizen->name << endl;
-        cout << "Age: " << citizen->age << endl;
-        cout << "Gender: " << citizen->gender << endl;
-        cout << "Address: House " << citizen->houseNo << ", Street " 
-             << citizen->street << ", " << citizen->sector << endl;
-        cout << "Occupation: " << citizen->occupation << endl;
+        cout << "CNIC: " << citizen.cnic << endl;
+        cout << "Name: " << citizen.name << endl;
+        cout << "Age: " << citizen.age << endl;
+        cout << "Gender: " << citizen.gender << endl;
+        cout << "Address: House " << citizen.houseNo << ", Street " 
+             << citizen.street << ", " << sectorName(citizen.sectorId) << endl;
+        cout << "Occupation: " << citizen.occupation << endl;
     }
     
     void displaySectorHierarchy() {
@@ -430,26 +439,21 @@ public:
             return;
         }
         
-        // Get all citizen keys from hash table
-        char** citizenKeys = new char*[1000];
-        int count;
-        citizenTable->getAllKeys(citizenKeys, &count);
-        
+        // walk the table in place (no key array, no re-search)
         cout << "\n--- Citizen List ---" << endl;
-        for (int i = 0; i < count; i++) {
-            Citizen* citizen = (Citizen*)citizenTable->search(citizenKeys[i]);
-            if (citizen != nullptr) {
-                cout << "\n[" << (i+1) << "] CNIC: " << citizen->cnic << endl;
-                cout << "    Name: " << citizen->name << endl;
-                cout << "    Age: " << citizen->age << endl;
-                cout << "    Gender: " << citizen->gender << endl;
-                cout << "    Occupation: " << citizen->occupation << endl;
-                cout << "    Address: House " << citizen->houseNo << ", " 
-                     << citizen->street << ", " << citizen->sector << endl;
-            }
-        }
+        int i = 0;
+        citizenTable->forEach([&i](const StringView&, Citizen& entry) {
+            Citizen* citizen = &entry;
+            cout << "\n[" << (i+1) << "] CNIC: " << citizen->cnic << endl;
+            cout << "    Name: " << citizen->name << endl;
+            cout << "    Age: " << citizen->age << endl;
+            cout << "    Gender: " << citizen->gender << endl;
+            cout << "    Occupation: " << citizen->occupation << endl;
+            cout << "    Address: House " << citizen->houseNo << ", " 
+                 << citizen->street << ", " << sectorName(citizen->sectorId) << endl;
+            i++;
+        });
         
-        delete[] citizenKeys;
         cout << "\n=============================================" << endl;
     }
     
@@ -539,8 +543,8 @@ public:
             return;
         }
         
-        Citizen* searchedPerson = (Citizen*)citizenTable->search(searchCNIC);
-        if (searchedPerson == nullptr) {
+        Citizen searchedPerson;
+        if (!getCitizenByCNIC(searchCNIC, searchedPerson)) {
             cout << "[ERROR] Citizen with CNIC " << searchCNIC << " not found!" << endl;
             cout << "[TIP] Use 'Lookup Citizen by CNIC' to verify CNIC exists" << endl;
             return;
@@ -549,30 +553,42 @@ public:
         cout << "\n========================================" << endl;
         cout << "   FAMILY TREE VISUALIZATION" << endl;
         cout << "========================================" << endl;
-        cout << "Searched Person: " << searchedPerson->name << endl;
-        cout << "Address: " << searchedPerson->sector << ", " 
-             << searchedPerson->street << ", House " << searchedPerson->houseNo << endl;
+        cout << "Searched Person: " << searchedPerson.name << endl;
+        cout << "Address: " << sectorName(searchedPerson.sectorId) << ", " 
+             << searchedPerson.street << ", House " << searchedPerson.houseNo << endl;
         cout << "----------------------------------------\n" << endl;
         
         // Find ALL family members at same address
-        char** allKeys = new char*[1000];
-        int count;
-        citizenTable->getAllKeys(allKeys, &count);
+        // the whole citizen table is scanned, so split it across threads;
+        // each part keeps copies of its own matches (taken while the shard is
+        // locked) and they are merged back in table order
+        int parts = citizenTable->suggestParallelParts();
+        Citizen** partMembers = new Citizen*[parts];
+        int* partCounts = new int[parts];
+        for (int p = 0; p < parts; p++) {
+            partMembers[p] = new Citizen[50];
+            partCounts[p] = 0;
+        }
+        
+        citizenTable->parallelForEach(parts, [&](const StringView&, Citizen& citizen, int part) {
+            // Check if same address (sector is an int compare, so it goes first)
+            if (partCounts[part] < 50 &&
+                citizen.sectorId == searchedPerson.sectorId &&
+                stringCompare(citizen.houseNo, searchedPerson.houseNo) == 0 &&
+                stringCompare(citizen.street, searchedPerson.street) == 0) {
+                partMembers[part][partCounts[part]] = citizen;
+                partCounts[part]++;
+            }
+        });
         
         // Store all family members
-        Citizen* familyMembers[50];
+        const Citizen* familyMembers[50];
         int familyCount = 0;
         
-        for (int i = 0; i < count && familyCount < 50; i++) {
-            Citizen* citizen = (Citizen*)citizenTable->search(allKeys[i]);
-            if (citizen != nullptr) {
-                // Check if same address
-                if (stringCompare(citizen->sector, searchedPerson->sector) == 0 &&
-                    stringCompare(citizen->street, searchedPerson->street) == 0 &&
-                    stringCompare(citizen->houseNo, searchedPerson->houseNo) == 0) {
-                    familyMembers[familyCount] = citizen;
-                    familyCount++;
-                }
+        for (int p = 0; p < parts; p++) {
+            for (int i = 0; i < partCounts[p] && familyCount < 50; i++) {
+                familyMembers[familyCount] = &partMembers[p][i];
+                familyCount++;
             }
         }
         
@@ -581,7 +597,7 @@ public:
         
         // Display all family members with complete details
         for (int i = 0; i < familyCount; i++) {
-            Citizen* member = familyMembers[i];
+            const Citizen* member = familyMembers[i];
             
             if (i == 0) {
                 // First member shown as root
@@ -603,14 +619,18 @@ public:
             }
         }
         
-        delete[] allKeys;
-        
         cout << "\n========================================" << endl;
         cout << "Total Family Size: " << familyCount << " member(s)" << endl;
         cout << "========================================" << endl;
         cout << "[DEMO] Tree structure used for hierarchical display!" << endl;
         cout << "[NOTE] Search works with ANY family member's CNIC!" << endl;
         cout << "========================================" << endl;
+        
+        for (int p = 0; p < parts; p++) {
+            delete[] partMembers[p];
+        }
+        delete[] partMembers;
+        delete[] partCounts;
     }
     
     // ========== VISUALIZATION HELPER METHODS ==========
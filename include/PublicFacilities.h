@@ -1,7 +1,8 @@
 #ifndef PUBLICFACILITIES_H
 #define PUBLICFACILITIES_H
 
-#include "HashTable.h"
+#include "HashMap.h"
+#include "SectorRegistry.h"
 #include "Utils.h"
 #include <iostream>
 using namespace std;
@@ -14,26 +15,26 @@ struct Facility {
     char facilityID[50];
     char name[100];
     char type[50];
-    char sector[50];
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     
     Facility() {
         facilityID[0] = '\0';
         name[0] = '\0';
         type[0] = '\0';
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
     }
 };
 
 // public facility system class
 class PublicFacilitySystem {
 private:
-    HashTable* facilityTable;
+    HashMap<StringView, Facility>* facilityTable;
     int facilityCount;
     char lastRegisteredSector[50];
 
 public:
     PublicFacilitySystem() {
-        facilityTable = new HashTable(100);
+        facilityTable = new HashMap<StringView, Facility>(100);
         facilityCount = 0;
         lastRegisteredSector[0] = '\0';
     }
@@ -41,13 +42,13 @@ public:
     // register facility
     void registerFacility(const char* facilityID, const char* name, 
                          const char* type, const char* sector) {
-        Facility* facility = new Facility();
-        stringCopyN(facility->facilityID, facilityID, 50);
-        stringCopyN(facility->name, name, 100);
-        stringCopyN(facility->type, type, 50);
-        stringCopyN(facility->sector, sector, 50);
+        Facility facility;
+        stringCopyN(facility.facilityID, facilityID, 50);
+        stringCopyN(facility.name, name, 100);
+        stringCopyN(facility.type, type, 50);
+        facility.sectorId = internSector(sector);
         
-        facilityTable->insert(facilityID, facility);
+        facilityTable->insert(facilityID, std::move(facility));
         facilityCount++;
         cout << "Registered facility: " << name << " (" << type << ")" << endl;
     }
@@ -91,38 +92,32 @@ public:
         cout << "Enter your sector (e.g., G-10): ";
         cin >> userSector;
         normalizeInput(userSector);
+        SectorId userSectorId = findSector(userSector);   // resolved once, loop compares ints
         
-        char** facKeys = new char*[100];
-        int count;
-        facilityTable->getAllKeys(facKeys, &count);
+        int count = facilityTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No facilities registered yet." << endl;
-            delete[] facKeys;
             return;
         }
         
         bool found = false;
         cout << "\n--- " << facilityType << " in Your Sector ---" << endl;
-        for (int i = 0; i < count; i++) {
-            Facility* fac = (Facility*)facilityTable->search(facKeys[i]);
-            if (fac != nullptr) {
-                char facType[50], facSector[50];
-                stringCopy(facType, fac->type);
-                stringCopy(facSector, fac->sector);
-                toUpperCase(facType);
-                toUpperCase(facSector);
-                
-                if (stringCompare(facType, facilityType) == 0 && 
-                    stringCompare(facSector, userSector) == 0) {
-                    cout << "  - " << fac->name << endl;
-                    found = true;
-                }
+        for (auto& entry : *facilityTable) {
+            Facility* fac = &entry.value;
+            if (userSectorId == NO_SECTOR || fac->sectorId != userSectorId) {
+                continue;   // int compare first, the type string only for same-sector facilities
+            }
+            char facType[50];
+            stringCopy(facType, fac->type);
+            toUpperCase(facType);
+            
+            if (stringCompare(facType, facilityType) == 0) {
+                cout << "  - " << fac->name << endl;
+                found = true;
             }
         }
         
-        delete[] facKeys;
-        
         if (!found) {
             cout << "[INFO] No facilities of this type found in your sector." << endl;
         }
@@ -137,28 +132,20 @@ public:
         cin.getline(facilityType, 50);
         toUpperCase(facilityType);
         
-        char** facKeys = new char*[100];
-        int count;
-        facilityTable->getAllKeys(facKeys, &count);
-        
         bool found = false;
         cout << "\n--- All " << facilityType << " Facilities ---" << endl;
-        for (int i = 0; i < count; i++) {
-            Facility* fac = (Facility*)facilityTable->search(facKeys[i]);
-            if (fac != nullptr) {
-                char facType[50];
-                stringCopy(facType, fac->type);
-                toUpperCase(facType);
-                
-                if (stringCompare(facType, facilityType) == 0) {
-                    cout << "  - " << fac->name << " (" << fac->sector << ")" << endl;
-                    found = true;
-                }
+        for (auto& entry : *facilityTable) {
+            Facility* fac = &entry.value;
+            char facType[50];
+            stringCopy(facType, fac->type);
+            toUpperCase(facType);
+            
+            if (stringCompare(facType, facilityType) == 0) {
+                cout << "  - " << fac->name << " (" << sectorName(fac->sectorId) << ")" << endl;
+                found = true;
             }
         }
         
-        delete[] facKeys;
-        
         if (!found) {
             cout << "[INFO] No facilities of this type found." << endl;
         }
@@ -179,32 +166,28 @@ public:
     void displayAllFacilities() {
         cout << "\n========== ALL PUBLIC FACILITIES ==========" << endl;
         
-        char** facKeys = new char*[100];
-        int count;
-        facilityTable->getAllKeys(facKeys, &count);
+        int count = facilityTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No facilities registered yet." << endl;
-            delete[] facKeys;
             return;
         }
         
-        for (int i = 0; i < count; i++) {
-            Facility* fac = (Facility*)facilityTable->search(facKeys[i]);
-            if (fac != nullptr) {
-                cout << "\n[" << (i+1) << "] " << fac->name << endl;
-                cout << "    ID: " << fac->facilityID << endl;
-                cout << "    Type: " << fac->type << endl;
-                cout << "    Sector: " << fac->sector << endl;
-            }
+        int i = 0;
+        for (auto& entry : *facilityTable) {
+            Facility* fac = &entry.value;
+            cout << "\n[" << (i+1) << "] " << fac->name << endl;
+            cout << "    ID: " << fac->facilityID << endl;
+            cout << "    Type: " << fac->type << endl;
+            cout << "    Sector: " << sectorName(fac->sectorId) << endl;
+            i++;
         }
         
-        delete[] facKeys;
         cout << "\n==========================================" << endl;
     }
     
     void displayFacility(const char* facilityID) {
-        Facility* fac = (Facility*)facilityTable->search(facilityID);
+        Facility* fac = facilityTable->search(facilityID);
         if (fac == nullptr) {
             cout << "Facility not found!" << endl;
             return;
@@ -214,27 +197,22 @@ public:
         cout << "Facility ID: " << fac->facilityID << endl;
         cout << "Name: " << fac->name << endl;
         cout << "Type: " << fac->type << endl;
-        cout << "Sector: " << fac->sector << endl;
+        cout << "Sector: " << sectorName(fac->sectorId) << endl;
     }
     
     // Park visualization helpers
-    void getParkKeys(char** keys, int* count) {
-        char** allKeys = new char*[100];
-        int totalCount = 0;
-        facilityTable->getAllKeys(allKeys, &totalCount);
-        
-        *count = 0;
-        for (int i = 0; i < totalCount && *count < 100; i++) {
-            Facility* fac = (Facility*)facilityTable->search(allKeys[i]);
-            if (fac && stringCompareIgnoreCase(fac->type, "Park") == 0) {
-                keys[*count] = allKeys[i];
-                (*count)++;
+    // visit(Facility&) for every facility of type Park
+    template <typename Visitor>
+    void forEachPark(Visitor visit) {
+        facilityTable->forEach([&visit](const StringView&, Facility& fac) {
+            if (stringCompareIgnoreCase(fac.type, "Park") == 0) {
+                visit(fac);
             }
-        }
+        });
     }
     
     Facility* getPark(const char* parkID) {
-        Facility* fac = (Facility*)facilityTable->search(parkID);
+        Facility* fac = facilityTable->search(parkID);
         if (fac && stringCompareIgnoreCase(fac->type, "Park") == 0) {
             return fac;
         }
@@ -242,23 +220,18 @@ public:
     }
     
     // Mosque visualization helpers
-    void getMosqueKeys(char** keys, int* count) {
-        char** allKeys = new char*[100];
-        int totalCount = 0;
-        facilityTable->getAllKeys(allKeys, &totalCount);
-        
-        *count = 0;
-        for (int i = 0; i < totalCount && *count < 100; i++) {
-            Facility* fac = (Facility*)facilityTable->search(allKeys[i]);
-            if (fac && stringCompareIgnoreCase(fac->type, "Mosque") == 0) {
-                keys[*count] = allKeys[i];
-                (*count)++;
+    // visit(Facility&) for every facility of type Mosque
+    template <typename Visitor>
+    void forEachMosque(Visitor visit) {
+        facilityTable->forEach([&visit](const StringView&, Facility& fac) {
+            if (stringCompareIgnoreCase(fac.type, "Mosque") == 0) {
+                visit(fac);
             }
-        }
+        });
     }
     
     Facility* getMosque(const char* mosqueID) {
-        Facility* fac = (Facility*)facilityTable->search(mosqueID);
+        Facility* fac = facilityTable->search(mosqueID);
         if (fac && stringCompareIgnoreCase(fac->type, "Mosque") == 0) {
             return fac;
         }
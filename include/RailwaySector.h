@@ -2,9 +2,11 @@
 #define RAILWAYSECTOR_H
 
 #include "Graph.h"
-#include "HashTable.h"
+#include "ShortestPathTreeCache.h"
+#include "HashMap.h"
+#include "SectorRegistry.h"
 #include "LinkedList.h"
-#include "Queue.h"
+#include "RingBuffer.h"
 #include "Utils.h"
 #include <iostream>
 using namespace std;
@@ -17,13 +19,13 @@ extern PopulationSystem* populationSystem;
 struct RailStation {
     char stationID[20];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     int platforms;
     
     RailStation() {
         stationID[0] = '\0';
         name[0] = '\0';
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
         platforms = 1;
     }
 };
@@ -53,18 +55,22 @@ struct Train {
 class RailwaySystem {
 private:
     Graph* stationGraph;
-    HashTable* stationTable;
-    HashTable* trainTable;
+    ShortestPathTreeCache* routeCache;      // recent route sources, dropped on any network change
+    HashMap<StringView, RailStation>* stationTable;
+    HashMap<StringView, Train>* trainTable;
     
     int stationCount;
     int trainCount;
     int routeEdgeCount;
 
 public:
+    static const int CRITICAL_SHOWN = 5;       // most central stations listed in the network summary
+    
     RailwaySystem() {
         stationGraph = new Graph(50);
-        stationTable = new HashTable(30);
-        trainTable = new HashTable(100);
+        routeCache = new ShortestPathTreeCache(stationGraph);
+        stationTable = new HashMap<StringView, RailStation>(30);
+        trainTable = new HashMap<StringView, Train>(100);
         stationCount = 0;
         trainCount = 0;
         routeEdgeCount = 0;
@@ -72,13 +78,13 @@ public:
     
     // 1. Register station
     void registerStation(const char* stationID, const char* name, const char* sector, int platforms) {
-        RailStation* station = new RailStation();
-        stringCopyN(station->stationID, stationID, 20);
-        stringCopyN(station->name, name, 100);
-        stringCopyN(station->sector, sector, 50);
-        station->platforms = platforms;
+        RailStation station;
+        stringCopyN(station.stationID, stationID, 20);
+        stringCopyN(station.name, name, 100);
+        station.sectorId = internSector(sector);
+        station.platforms = platforms;
         
-        stationTable->insert(stationID, station);
+        stationTable->insert(stationID, std::move(station));
         stationGraph->addVertex(stationID, 0, 0);
         stationCount++;
         
@@ -113,40 +119,34 @@ public:
     void displayAllStations() {
         cout << "\n========== ALL RAILWAY STATIONS ==========" << endl;
         
-        char** keys = new char*[100];
-        int count;
-        stationTable->getAllKeys(keys, &count);
+        int count = stationTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No stations registered yet." << endl;
-            delete[] keys;
             return;
         }
         
-        for (int i = 0; i < count; i++) {
-            RailStation* station = (RailStation*)stationTable->search(keys[i]);
-            if (station != nullptr) {
-                cout << station->stationID << " - " << station->name << " [" << station->sector << "]" << endl;
-            }
+        for (auto& entry : *stationTable) {
+            RailStation* station = &entry.value;
+            cout << station->stationID << " - " << station->name << " [" << sectorName(station->sectorId) << "]" << endl;
         }
         
-        delete[] keys;
         cout << "==========================================" << endl;
     }
     
     // 3. Add train
     void addTrain(const char* trainNo, const char* name, const char* departure, 
                   const char* arrival, const char* depTime, const char* arrTime) {
-        Train* train = new Train();
-        stringCopyN(train->trainNo, trainNo, 20);
-        stringCopyN(train->name, name, 100);
-        stringCopyN(train->departureStation, departure, 20);
-        stringCopyN(train->arrivalStation, arrival, 20);
-        stringCopyN(train->currentLocation, departure, 20);
-        stringCopyN(train->departureTime, depTime, 20);
-        stringCopyN(train->arrivalTime, arrTime, 20);
-        
-        trainTable->insert(trainNo, train);
+        Train train;
+        stringCopyN(train.trainNo, trainNo, 20);
+        stringCopyN(train.name, name, 100);
+        stringCopyN(train.departureStation, departure, 20);
+        stringCopyN(train.arrivalStation, arrival, 20);
+        stringCopyN(train.currentLocation, departure, 20);
+        stringCopyN(train.departureTime, depTime, 20);
+        stringCopyN(train.arrivalTime, arrTime, 20);
+        
+        trainTable->insert(trainNo, std::move(train));
         trainCount++;
         
         cout << "Added train: " << trainNo << " (" << name << ")" << endl;
@@ -195,27 +195,21 @@ public:
     void displayAllTrains() {
         cout << "\n========== ALL TRAINS ==========" << endl;
         
-        char** keys = new char*[200];
-        int count;
-        trainTable->getAllKeys(keys, &count);
+        int count = trainTable->getCount();
         
         if (count == 0) {
             cout << "[INFO] No trains registered yet." << endl;
-            delete[] keys;
             return;
         }
         
         cout << "Total Trains: " << count << endl << endl;
-        for (int i = 0; i < count; i++) {
-            Train* train = (Train*)trainTable->search(keys[i]);
-            if (train != nullptr) {
-                cout << train->trainNo << " - " << train->name << endl;
-                cout << "  " << train->departureStation << " → " << train->arrivalStation;
-                cout << " (" << train->departureTime << " - " << train->arrivalTime << ")" << endl;
-            }
+        for (auto& entry : *trainTable) {
+            Train* train = &entry.value;
+            cout << train->trainNo << " - " << train->name << endl;
+            cout << "  " << train->departureStation << " → " << train->arrivalStation;
+            cout << " (" << train->departureTime << " - " << train->arrivalTime << ")" << endl;
         }
         
-        delete[] keys;
         cout << "================================" << endl;
     }
     
@@ -227,7 +221,7 @@ public:
         cin >> trainNo;
         normalizeInput(trainNo);
         
-        Train* train = (Train*)trainTable->search(trainNo);
+        Train* train = trainTable->search(trainNo);
         if (train == nullptr) {
             cout << "\n[ERROR] Train " << trainNo << " not found!" << endl;
             return;
@@ -249,7 +243,7 @@ public:
         cin >> trainNo;
         normalizeInput(trainNo);
         
-        Train* train = (Train*)trainTable->search(trainNo);
+        Train* train = trainTable->search(trainNo);
         if (train == nullptr) {
             cout << "\n[ERROR] Train not found!" << endl;
             return;
@@ -278,7 +272,7 @@ public:
         cin >> trainNo;
         normalizeInput(trainNo);
         
-        Train* train = (Train*)trainTable->search(trainNo);
+        Train* train = trainTable->search(trainNo);
         if (train == nullptr) {
             cout << "\n[ERROR] Train not found!" << endl;
             return;
@@ -298,30 +292,19 @@ public:
         cout << "Enter your sector: ";
         cin >> userSector;
         normalizeInput(userSector);
-        
-        char** keys = new char*[100];
-        int count;
-        stationTable->getAllKeys(keys, &count);
+        SectorId userSectorId = findSector(userSector);   // resolved once, loop compares ints
         
         bool found = false;
         cout << "\n--- Stations in Your Sector ---" << endl;
         
-        for (int i = 0; i < count; i++) {
-            RailStation* station = (RailStation*)stationTable->search(keys[i]);
-            if (station != nullptr) {
-                char stationSector[50];
-                stringCopy(stationSector, station->sector);
-                normalizeInput(stationSector);
-                
-                if (stringCompare(stationSector, userSector) == 0) {
-                    cout << "  - " << station->name << " (" << station->stationID << ")" << endl;
-                    found = true;
-                }
+        for (auto& entry : *stationTable) {
+            RailStation* station = &entry.value;
+            if (userSectorId != NO_SECTOR && station->sectorId == userSectorId) {
+                cout << "  - " << station->name << " (" << station->stationID << ")" << endl;
+                found = true;
             }
         }
         
-        delete[] keys;
-        
         if (!found) {
             cout << "[INFO] No railway stations found in your sector." << endl;
         }
@@ -372,59 +355,23 @@ public:
             return;
         }
         
-        int vertexCount = stationGraph->getVertexCount();
-        double* distances = new double[vertexCount];
-        int* previous = new int[vertexCount];
-        
-        stationGraph->dijkstra(from, distances, previous);
-        
-        int destIndex = -1;
-        for (int i = 0; i < vertexCount; i++) {
-            char vertexName[50];
-            stringCopy(vertexName, stationGraph->getVertexName(i));
-            toUpperCase(vertexName);
-            
-            char toUpper[50];
-            stringCopy(toUpper, to);
-            toUpperCase(toUpper);
-            
-            if (stringCompare(vertexName, toUpper) == 0) {
-                destIndex = i;
-                break;
-            }
-        }
+        const int* path = nullptr;
+        int pathLength = 0;
+        double distance = routeCache->route(stationGraph->indexOf(from), stationGraph->indexOf(to), path, pathLength);
         
-        if (destIndex == -1 || distances[destIndex] >= GRAPH_MAX_DISTANCE) {
+        if (distance >= GRAPH_MAX_DISTANCE) {
             cout << "\n[ERROR] No path exists between these stations!" << endl;
-            delete[] distances;
-            delete[] previous;
             return;
         }
         
-        cout << "\nShortest distance: " << distances[destIndex] << " km" << endl;
+        cout << "\nShortest distance: " << distance << " km" << endl;
         cout << "Path: ";
         
-        int pathSize = 0;
-        char** path = new char*[vertexCount];
-        int current = destIndex;
-        
-        while (current != -1) {
-            path[pathSize] = new char[50];
-            stringCopy(path[pathSize], stationGraph->getVertexName(current));
-            pathSize++;
-            current = previous[current];
-        }
-        
-        for (int i = pathSize - 1; i >= 0; i--) {
-            cout << path[i];
-            if (i > 0) cout << " → ";
-            delete[] path[i];
+        for (int i = 0; i < pathLength; i++) {
+            cout << stationGraph->getVertexName(path[i]);
+            if (i < pathLength - 1) cout << " → ";
         }
         cout << endl;
-        
-        delete[] path;
-        delete[] distances;
-        delete[] previous;
     }
     
     // 11. Display route network summary
@@ -432,7 +379,10 @@ public:
         cout << "\n========== RAILWAY NETWORK SUMMARY ==========" << endl;
         cout << "Total Stations: " << stationCount << endl;
         cout << "Total Connections: " << routeEdgeCount << endl;
-        cout << "Total Trains: " << trainCount << endl << endl;
+        cout << "Total Trains: " << trainCount << endl;
+        stationGraph->displayComponents();
+        stationGraph->displayCriticalVertices(CRITICAL_SHOWN);
+        cout << endl;
         
         cout << "Station connections:" << endl;
         stationGraph->display();
@@ -452,20 +402,20 @@ public:
             return;
         }
         
-        RailStation* station = (RailStation*)stationTable->search(stationID);
+        RailStation* station = stationTable->search(stationID);
         cout << "Station: " << station->name << " (" << stationID << ")" << endl;
         
-        Queue passengerQueue(15);
+        RingBuffer<int> passengerQueue(15);
         
         cout << "\nPassengers joining queue..." << endl;
         for (int i = 1; i <= 8; i++) {
-            passengerQueue.enqueue(i);
+            passengerQueue.push(i);
             cout << "  Passenger " << i << " joined queue" << endl;
         }
         
         cout << "\nBoarding passengers onto trains..." << endl;
-        while (!passengerQueue.isEmpty()) {
-            int passenger = passengerQueue.dequeue();
+        int passenger;
+        while (passengerQueue.pop(passenger)) {
             cout << "  Passenger " << passenger << " boarded" << endl;
         }
         
@@ -478,21 +428,25 @@ public:
     int getRouteEdgeCount() { return routeEdgeCount; }
     
     // Railway station visualization helpers
-    void getStationKeys(char** keys, int* count) {
-        stationTable->getAllKeys(keys, count);
+    // visit(RailStation&) for every station, straight from the table storage
+    template <typename Visitor>
+    void forEachStation(Visitor visit) {
+        stationTable->forEach([&visit](const StringView&, RailStation& station) { visit(station); });
     }
     
     RailStation* getStation(const char* stationID) {
-        return (RailStation*)stationTable->search(stationID);
+        return stationTable->search(stationID);
     }
     
     // Train visualization helpers
-    void getTrainKeys(char** keys, int* count) {
-        trainTable->getAllKeys(keys, count);
+    // visit(Train&) for every train, straight from the table storage
+    template <typename Visitor>
+    void forEachTrain(Visitor visit) {
+        trainTable->forEach([&visit](const StringView&, Train& train) { visit(train); });
     }
     
     Train* getTrain(const char* trainNo) {
-        return (Train*)trainTable->search(trainNo);
+        return trainTable->search(trainNo);
     }
     
     // Get distance between two railway stations
@@ -505,46 +459,41 @@ public:
         return stationGraph;
     }
     
+    // RailwaySystem::getStationCentrality(stationID)
+    // Time: Average O(k) lookup, plus a betweenness run the first time after a change
+    // Space: O(1)
+    // share of all station-to-station shortest paths running through the station (0..1)
+    double getStationCentrality(const char* stationID) {
+        int station = stationGraph->indexOf(stationID);
+        int n = stationGraph->getVertexCount();
+        if (station == -1 || n < 3) {
+            return 0;
+        }
+        return stationGraph->getBetweenness()[station] / ((double)(n - 1) * (n - 2));
+    }
+    
     // Get visual path between two stations (for visualization)
     int getVisualPath(const char* from, const char* to, char pathIds[][50], double& distance) {
-        int vertexCount = stationGraph->getVertexCount();
-        double* distances = new double[vertexCount];
-        int* previous = new int[vertexCount];
-        
-        stationGraph->dijkstra(from, distances, previous);
-        
-        // Find destination index
-        int destIndex = -1;
-        for (int i = 0; i < vertexCount; i++) {
-            if (strcmp(stationGraph->getVertexName(i), to) == 0) {
-                destIndex = i;
-                break;
-            }
-        }
+        // Repeated clicks from the same source are a path trace in the route cache
+        const int* path = nullptr;
+        int pathLength = 0;
+        distance = routeCache->route(stationGraph->indexOf(from), stationGraph->indexOf(to), path, pathLength);
         
-        if (destIndex == -1 || distances[destIndex] >= 999999) {
-            delete[] distances;
-            delete[] previous;
+        if (distance >= GRAPH_MAX_DISTANCE) {
             distance = 0;
-            return 0;
+            return 0;  // No path found
         }
         
-        int path[100];
-        int pathLength = 0;
-        stationGraph->getPath(previous, destIndex, path, pathLength);
-        
+        // Copy station IDs to output
         for (int i = 0; i < pathLength && i < 50; i++) {
             strcpy(pathIds[i], stationGraph->getVertexName(path[i]));
         }
         
-        distance = distances[destIndex];
-        
-        delete[] distances;
-        delete[] previous;
-        return pathLength;
+        return pathLength < 50 ? pathLength : 50;
     }
     
     ~RailwaySystem() {
+        delete routeCache;
         delete stationGraph;
         delete stationTable;
         delete trainTable;
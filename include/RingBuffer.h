@@ -0,0 +1,341 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+using namespace std;
+
+// ========== RING BUFFERS ==========
+// event queues for passengers, GPS updates and simulation events:
+//  - RingBuffer: one thread, grows on demand, so nothing is ever dropped
+//  - SpscRingBuffer: one producer thread + one consumer thread, lock-free
+//  - MpmcRingBuffer: any number of producers and consumers, lock-free
+// capacities are always a power of two, so wrapping is (index & mask), never %.
+// values are moved in and out; T needs a default constructor and move assignment
+
+// roundUpRingCapacity(size)
+// Time: O(log n)
+// Space: O(1)
+int roundUpRingCapacity(int size) {
+    int capacity = 2;
+    while (capacity < size) {
+        capacity = capacity * 2;
+    }
+    return capacity;
+}
+
+// ========== RING BUFFER (single thread) ==========
+template <typename T>
+class RingBuffer {
+private:
+    T* slots;
+    int capacity;       // always a power of two
+    int mask;           // capacity - 1
+    int head;           // next slot to pop
+    int count;
+
+    RingBuffer(const RingBuffer&);
+    RingBuffer& operator=(const RingBuffer&);
+
+    // RingBuffer::grow()
+    // Time: O(n) - amortized O(1) per push
+    // Space: O(n)
+    // the queued values are unrolled to the front of the new array
+    void grow() {
+        int newCapacity = capacity * 2;
+        T* newSlots = new T[newCapacity];
+        for (int i = 0; i < count; i++) {
+            newSlots[i] = std::move(slots[(head + i) & mask]);
+        }
+        delete[] slots;
+        slots = newSlots;
+        capacity = newCapacity;
+        mask = newCapacity - 1;
+        head = 0;
+    }
+
+public:
+    // size is only a hint, the buffer grows on demand
+    RingBuffer(int size = 16) {
+        capacity = roundUpRingCapacity(size);
+        mask = capacity - 1;
+        slots = new T[capacity];
+        head = 0;
+        count = 0;
+    }
+
+    // RingBuffer::push(value)
+    // Time: O(1) amortized
+    // Space: O(1) amortized
+    void push(T value) {
+        if (count == capacity) {
+            grow();
+        }
+        slots[(head + count) & mask] = std::move(value);
+        count++;
+    }
+
+    // RingBuffer::pop(out)
+    // Time: O(1)
+    // Space: O(1)
+    // moves the oldest value into out; false if the buffer is empty
+    bool pop(T& out) {
+        if (count == 0) {
+            return false;
+        }
+        out = std::move(slots[head]);
+        head = (head + 1) & mask;
+        count--;
+        return true;
+    }
+
+    // oldest value (buffer must not be empty)
+    T& front() {
+        return slots[head];
+    }
+
+    // drop everything, storage is kept
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    bool isEmpty() {
+        return count == 0;
+    }
+
+    int size() {
+        return count;
+    }
+
+    int getCapacity() {
+        return capacity;
+    }
+
+    ~RingBuffer() {
+        delete[] slots;
+    }
+};
+
+// ========== SPSC RING BUFFER ==========
+// exactly one thread calls tryPush and exactly one thread calls tryPop.
+// each side owns one index and only reads the other's; the indices sit on
+// separate cache lines and each side keeps a cached copy of the other index,
+// so the shared lines are only touched when the buffer looks full / empty
+template <typename T>
+class SpscRingBuffer {
+private:
+    T* slots;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> tail;   // written by the producer only
+    size_t cachedHead;                      // producer's last view of head
+    alignas(64) std::atomic<size_t> head;   // written by the consumer only
+    size_t cachedTail;                      // consumer's last view of tail
+
+    SpscRingBuffer(const SpscRingBuffer&);
+    SpscRingBuffer& operator=(const SpscRingBuffer&);
+
+public:
+    // capacity is fixed (rounded up to a power of two)
+    SpscRingBuffer(int size = 1024) {
+        int capacity = roundUpRingCapacity(size);
+        mask = (size_t)capacity - 1;
+        slots = new T[capacity];
+        tail = 0;
+        head = 0;
+        cachedHead = 0;
+        cachedTail = 0;
+    }
+
+    // SpscRingBuffer::tryPush(value)
+    // Time: O(1) - no lock, no CAS
+    // Space: O(1)
+    // producer side; false (value untouched) if the buffer is full
+    bool tryPush(T&& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead > mask) {
+                return false;
+            }
+        }
+        slots[t & mask] = std::move(value);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value) {
+        T copy = value;
+        return tryPush(std::move(copy));
+    }
+
+    // SpscRingBuffer::push(value)
+    // Time: O(1) while there is room, otherwise waits for the consumer
+    // Space: O(1)
+    // producer side; never drops the value
+    void push(T value) {
+        while (!tryPush(std::move(value))) {
+            std::this_thread::yield();
+        }
+    }
+
+    // SpscRingBuffer::tryPop(out)
+    // Time: O(1) - no lock, no CAS
+    // Space: O(1)
+    // consumer side; false if the buffer is empty
+    bool tryPop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) {
+                return false;
+            }
+        }
+        out = std::move(slots[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // approximate while the other side is running
+    int size() {
+        return (int)(tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire));
+    }
+
+    bool isEmpty() {
+        return size() == 0;
+    }
+
+    int getCapacity() {
+        return (int)mask + 1;
+    }
+
+    ~SpscRingBuffer() {
+        delete[] slots;
+    }
+};
+
+// ========== MPMC RING BUFFER ==========
+// bounded queue after Dmitry Vyukov: every cell carries a sequence number that
+// says whose turn it is, so producers and consumers only race on one CAS of
+// their own position counter and never take a lock
+template <typename T>
+class MpmcRingBuffer {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    Cell* cells;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) std::atomic<size_t> dequeuePos;
+
+    MpmcRingBuffer(const MpmcRingBuffer&);
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&);
+
+public:
+    // capacity is fixed (rounded up to a power of two)
+    MpmcRingBuffer(int size = 1024) {
+        int capacity = roundUpRingCapacity(size);
+        mask = (size_t)capacity - 1;
+        cells = new Cell[capacity];
+        for (int i = 0; i < capacity; i++) {
+            cells[i].sequence.store((size_t)i, std::memory_order_relaxed);
+        }
+        enqueuePos = 0;
+        dequeuePos = 0;
+    }
+
+    // MpmcRingBuffer::tryPush(value)
+    // Time: O(1) expected - retries only when another producer won the same cell
+    // Space: O(1)
+    // false (value untouched) if the buffer is full
+    bool tryPush(T&& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            long long diff = (long long)seq - (long long)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // the cell still holds a value from one lap ago
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value) {
+        T copy = value;
+        return tryPush(std::move(copy));
+    }
+
+    // MpmcRingBuffer::push(value)
+    // Time: O(1) while there is room, otherwise waits for a consumer
+    // Space: O(1)
+    // never drops the value
+    void push(T value) {
+        while (!tryPush(std::move(value))) {
+            std::this_thread::yield();
+        }
+    }
+
+    // MpmcRingBuffer::tryPop(out)
+    // Time: O(1) expected
+    // Space: O(1)
+    // false if the buffer is empty
+    bool tryPop(T& out) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            long long diff = (long long)seq - (long long)(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // nothing published in this cell yet
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->value);
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // approximate while other threads are running
+    int size() {
+        long long n = (long long)enqueuePos.load(std::memory_order_acquire) -
+                      (long long)dequeuePos.load(std::memory_order_acquire);
+        return n > 0 ? (int)n : 0;
+    }
+
+    bool isEmpty() {
+        return size() == 0;
+    }
+
+    int getCapacity() {
+        return (int)mask + 1;
+    }
+
+    ~MpmcRingBuffer() {
+        delete[] cells;
+    }
+};
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef SECTORREGISTRY_H
+#define SECTORREGISTRY_H
+
+#include "String.h"
+#include "HashMap.h"
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+using namespace std;
+
+// ========== SECTOR INTERN TABLE ==========
+// every sector name ("G-10", " g-10 ", "F-8") is trimmed and case-folded once, when a
+// record is loaded, and turned into a small integer SectorId. records keep the id
+// instead of a char[50] copy, so "same sector?" is an int compare and nothing is
+// re-normalized inside query loops. the first spelling seen is kept for display.
+
+typedef int SectorId;
+const SectorId NO_SECTOR = -1;
+
+class SectorRegistry {
+private:
+    static const int CHUNK_SIZE = 64;
+    static const int MAX_CHUNKS = 256;      // room for 16384 sectors
+
+    HashMap<StringView, SectorId>* index;   // case-insensitive name -> id
+    const char** chunks[MAX_CHUNKS];        // id -> display name; chunks never move
+    std::atomic<int> count;
+    KeyArena names;
+    std::shared_mutex lock;                 // interning may happen on a loader thread
+
+    // SectorRegistry::trimmed(raw)
+    // Time: O(k)
+    // Space: O(1) - a view into raw, no copy
+    // strips the same whitespace as trim(), so "G-10\r" and "G-10" are one sector
+    static StringView trimmed(const char* raw) {
+        if (raw == nullptr) {
+            return StringView();
+        }
+        int start = 0;
+        while (isTrimSpace(raw[start])) start++;
+        int length = stringLength(raw + start);
+        while (length > 0 && isTrimSpace(raw[start + length - 1])) length--;
+        return StringView(raw + start, length);
+    }
+
+    SectorRegistry(const SectorRegistry&);
+    SectorRegistry& operator=(const SectorRegistry&);
+
+public:
+    SectorRegistry() {
+        index = new HashMap<StringView, SectorId>(64);
+        for (int i = 0; i < MAX_CHUNKS; i++) {
+            chunks[i] = nullptr;
+        }
+        count = 0;
+    }
+
+    // SectorRegistry::intern(raw)
+    // Time: Average O(k) - one trim + one hash lookup, insert only for a new sector
+    // Space: O(k) for a new name
+    // returns NO_SECTOR for an empty name
+    SectorId intern(const char* raw) {
+        StringView name = trimmed(raw);
+        if (name.length == 0) {
+            return NO_SECTOR;
+        }
+
+        {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            SectorId* existing = index->search(name);
+            if (existing != nullptr) {
+                return *existing;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> guard(lock);
+        SectorId* existing = index->search(name);   // another thread may have won
+        if (existing != nullptr) {
+            return *existing;
+        }
+
+        int id = count.load();
+        if (id >= CHUNK_SIZE * MAX_CHUNKS) {
+            cout << "[ERROR] Sector registry is full!" << endl;
+            return NO_SECTOR;
+        }
+        if (chunks[id / CHUNK_SIZE] == nullptr) {
+            chunks[id / CHUNK_SIZE] = new const char*[CHUNK_SIZE];
+        }
+        char* stored = names.allocate(name.length + 1);
+        for (int i = 0; i < name.length; i++) {
+            stored[i] = name.data[i];
+        }
+        stored[name.length] = '\0';
+        chunks[id / CHUNK_SIZE][id % CHUNK_SIZE] = stored;
+
+        index->insert(name, (SectorId)id);
+        count.store(id + 1);
+        return id;
+    }
+
+    // SectorRegistry::find(raw)
+    // Time: Average O(k)
+    // Space: O(1)
+    // like intern but never adds: NO_SECTOR if the sector was never seen
+    // (so user input cannot grow the table)
+    SectorId find(const char* raw) {
+        StringView name = trimmed(raw);
+        if (name.length == 0) {
+            return NO_SECTOR;
+        }
+        std::shared_lock<std::shared_mutex> guard(lock);
+        SectorId* existing = index->search(name);
+        return existing != nullptr ? *existing : NO_SECTOR;
+    }
+
+    // SectorRegistry::name(id)
+    // Time: O(1) - two array reads, no lock
+    // Space: O(1)
+    // "" for NO_SECTOR or an unknown id
+    const char* name(SectorId id) {
+        if (id < 0 || id >= count.load()) {
+            return "";
+        }
+        return chunks[id / CHUNK_SIZE][id % CHUNK_SIZE];
+    }
+
+    // number of distinct sectors (ids are 0 .. getCount() - 1)
+    int getCount() { return count.load(); }
+
+    ~SectorRegistry() {
+        for (int i = 0; i < MAX_CHUNKS; i++) {
+            delete[] chunks[i];
+        }
+        delete index;
+    }
+};
+
+// the one city-wide table
+SectorRegistry sectorRegistry;
+
+// internSector(raw)
+// Time: Average O(k)
+// Space: O(k) for a new name
+SectorId internSector(const char* raw) {
+    return sectorRegistry.intern(raw);
+}
+
+// findSector(raw)
+// Time: Average O(k)
+// Space: O(1)
+SectorId findSector(const char* raw) {
+    return sectorRegistry.find(raw);
+}
+
+// sectorName(id)
+// Time: O(1)
+// Space: O(1)
+const char* sectorName(SectorId id) {
+    return sectorRegistry.name(id);
+}
+
+#endif
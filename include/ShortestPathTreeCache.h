@@ -0,0 +1,419 @@
+#ifndef SHORTESTPATHTREECACHE_H
+#define SHORTESTPATHTREECACHE_H
+
+#include "Graph.h"
+#include <iostream>
+using namespace std;
+
+// ========== SHORTEST PATH TREE CACHE ==========
+// route lookups tend to start from the same few places (hospitals, big stops, the
+// stop a user just clicked), so instead of a point-to-point search per request the
+// cache keeps whole shortest path trees for the most recently used sources:
+//  - a miss settles every vertex from the source once and keeps distance + previous
+//  - a hit is one path trace back through previous, no search at all
+//  - at most maxTrees trees are kept; the least recently used one is recycled
+//  - every tree belongs to one graph revision. edge changes the graph still has in
+//    its change log (traffic updates, closures, new roads) are repaired in place:
+//    a longer or removed tree edge re-settles only the subtree hanging below it, a
+//    shorter or new edge only the vertices it actually improves. anything else
+//    (a new vertex, a long burst of changes) drops the cache on the next lookup
+// results point into the cache's own path buffer (valid until the next lookup), so
+// one cache serves one thread at a time - the CLI menus and the visualization loop
+class ShortestPathTreeCache {
+private:
+    struct Tree {
+        int source;
+        int size;           // vertices covered by distance / previous
+        int capacity;       // entries allocated in distance / previous (>= size)
+        double* distance;
+        int* previous;
+        int newer;          // LRU links (slot indices, -1 = end)
+        int older;
+    };
+
+    Graph* graph;
+    Tree* trees;
+    int maxTrees;
+    int treeCount;
+    int newest;
+    int oldest;
+    unsigned int revision;  // graph revision the trees were built for
+
+    int* slotOf;            // source vertex -> slot, -1 = not cached
+    int slotRange;
+
+    int* path;
+    int pathCapacity;
+
+    long long hits;
+    long long misses;
+
+    // repair scratch, sized to slotRange and shared by all trees
+    EdgeChange pending[GRAPH_EDGE_LOG_SIZE];    // changes since revision, oldest first
+    int pendingCount;
+    int* firstChild;        // tree children of a vertex (built only when a tree edge got longer)
+    int* nextSibling;
+    int* affected;          // vertices whose tree path used a longer or removed edge
+    unsigned int* mark;     // == markEpoch: vertex is in affected
+    unsigned int markEpoch;
+    HeapHandle* handle;     // frontier entry, NO_HEAP_HANDLE between repairs
+    IndexedHeap<int, double> frontier;
+    long long repairs;
+    long long resettled;
+
+    ShortestPathTreeCache(const ShortestPathTreeCache&);
+    ShortestPathTreeCache& operator=(const ShortestPathTreeCache&);
+
+    // ShortestPathTreeCache::unlink(slot)
+    // Time: O(1)
+    // Space: O(1)
+    void unlink(int slot) {
+        Tree& tree = trees[slot];
+        if (tree.newer != -1) trees[tree.newer].older = tree.older; else newest = tree.older;
+        if (tree.older != -1) trees[tree.older].newer = tree.newer; else oldest = tree.newer;
+        tree.newer = -1;
+        tree.older = -1;
+    }
+
+    // ShortestPathTreeCache::pushNewest(slot)
+    // Time: O(1)
+    // Space: O(1)
+    void pushNewest(int slot) {
+        trees[slot].newer = -1;
+        trees[slot].older = newest;
+        if (newest != -1) trees[newest].newer = slot;
+        newest = slot;
+        if (oldest == -1) oldest = slot;
+    }
+
+    // ShortestPathTreeCache::relax(tree, from, to, candidate)
+    // Time: O(log V)
+    // Space: O(1)
+    void relax(Tree& tree, int from, int to, double candidate) {
+        if (candidate >= tree.distance[to]) {
+            return;
+        }
+        tree.distance[to] = candidate;
+        tree.previous[to] = from;
+        if (handle[to] != NO_HEAP_HANDLE) {
+            frontier.update(handle[to], candidate);     // decrease-key
+        } else {
+            handle[to] = frontier.push(to, candidate);
+        }
+    }
+
+    // ShortestPathTreeCache::repairTree(tree)
+    // Time: O(A log A) where A = vertices (and their edges) whose distance changes,
+    //       plus one O(V) pass over previous when a tree edge got longer
+    // Space: O(1) - scratch is shared
+    // brings one tree up to date with the pending edge changes. vertices outside the
+    // cut subtrees keep a valid path that is never longer than their stored distance,
+    // so seeding the cut vertices from them and relaxing every shortened edge, then
+    // running Dijkstra from those seeds, leaves every edge tight again
+    void repairTree(Tree& tree) {
+        double* distance = tree.distance;
+        int* previous = tree.previous;
+        int n = tree.size;
+        markEpoch++;
+        if (markEpoch == 0) {   // wrapped: old marks could look current again
+            for (int i = 0; i < slotRange; i++) {
+                mark[i] = 0;
+            }
+            markEpoch = 1;
+        }
+
+        // longer or removed tree edges: the subtree below them lost its path
+        int affectedCount = 0;
+        for (int c = 0; c < pendingCount; c++) {
+            const EdgeChange& change = pending[c];
+            if (change.newWeight > change.oldWeight && previous[change.dest] == change.source &&
+                mark[change.dest] != markEpoch) {
+                mark[change.dest] = markEpoch;
+                affected[affectedCount++] = change.dest;
+            }
+        }
+        if (affectedCount > 0) {
+            for (int v = 0; v < n; v++) {
+                firstChild[v] = -1;
+            }
+            for (int v = 0; v < n; v++) {
+                if (previous[v] != -1) {
+                    nextSibling[v] = firstChild[previous[v]];
+                    firstChild[previous[v]] = v;
+                }
+            }
+            // affected doubles as the breadth-first queue over the subtrees
+            for (int i = 0; i < affectedCount; i++) {
+                for (int child = firstChild[affected[i]]; child != -1; child = nextSibling[child]) {
+                    if (mark[child] != markEpoch) {
+                        mark[child] = markEpoch;
+                        affected[affectedCount++] = child;
+                    }
+                }
+            }
+            for (int i = 0; i < affectedCount; i++) {
+                distance[affected[i]] = GRAPH_MAX_DISTANCE;
+                previous[affected[i]] = -1;
+            }
+            // best way back in from the part of the tree that kept its paths
+            for (int i = 0; i < affectedCount; i++) {
+                int v = affected[i];
+                graph->forEachIncomingEdge(v, [&](int from, double weight) {
+                    if (mark[from] != markEpoch && distance[from] < GRAPH_MAX_DISTANCE) {
+                        relax(tree, from, v, distance[from] + weight);
+                    }
+                });
+            }
+        }
+
+        // shorter or new edges (current weights, a pair may have changed twice)
+        for (int c = 0; c < pendingCount; c++) {
+            const EdgeChange& change = pending[c];
+            if (change.newWeight < change.oldWeight && distance[change.source] < GRAPH_MAX_DISTANCE) {
+                double base = distance[change.source];
+                graph->forEachEdge(change.source, [&](int dest, double weight) {
+                    if (dest == change.dest) {
+                        relax(tree, change.source, dest, base + weight);
+                    }
+                });
+            }
+        }
+
+        while (!frontier.isEmpty()) {
+            int v = frontier.pop();
+            handle[v] = NO_HEAP_HANDLE;
+            resettled++;
+            double base = distance[v];
+            graph->forEachEdge(v, [&](int dest, double weight) {
+                relax(tree, v, dest, base + weight);
+            });
+        }
+        repairs++;
+    }
+
+    // ShortestPathTreeCache::syncWithGraph()
+    // Time: O(1) while the graph is unchanged, one repairTree per tree after logged
+    //       edge changes, O(maxTrees + V) otherwise
+    // Space: O(V) when the vertex range grows
+    void syncWithGraph() {
+        int n = graph->getVertexCount();
+        if (revision == graph->getRevision() && n <= slotRange) {
+            return;
+        }
+        if (treeCount > 0 && n <= slotRange) {
+            pendingCount = 0;
+            bool logged = graph->edgeChangesSince(revision, [this](const EdgeChange& change) {
+                pending[pendingCount++] = change;
+            });
+            if (logged) {
+                for (int i = 0; i < treeCount; i++) {
+                    repairTree(trees[i]);
+                }
+                revision = graph->getRevision();
+                return;
+            }
+        }
+        invalidate();
+        if (n > slotRange) {
+            int newRange = slotRange > 0 ? slotRange : 16;
+            while (newRange < n) {
+                newRange = newRange * 2;
+            }
+            delete[] slotOf;
+            delete[] firstChild;
+            delete[] nextSibling;
+            delete[] affected;
+            delete[] mark;
+            delete[] handle;
+            slotOf = new int[newRange];
+            firstChild = new int[newRange];
+            nextSibling = new int[newRange];
+            affected = new int[newRange];
+            mark = new unsigned int[newRange];
+            handle = new HeapHandle[newRange];
+            for (int i = 0; i < newRange; i++) {
+                slotOf[i] = -1;
+                mark[i] = 0;
+                handle[i] = NO_HEAP_HANDLE;
+            }
+            markEpoch = 0;
+            slotRange = newRange;
+        }
+        revision = graph->getRevision();
+    }
+
+    // ShortestPathTreeCache::treeFor(source)
+    // Time: O(1) on a hit, one full shortestPath run on a miss
+    // Space: O(V) for a new tree, recycled once maxTrees are in use
+    Tree& treeFor(int source) {
+        int slot = slotOf[source];
+        if (slot != -1) {
+            hits++;
+            if (newest != slot) {
+                unlink(slot);
+                pushNewest(slot);
+            }
+            return trees[slot];
+        }
+
+        misses++;
+        if (treeCount < maxTrees) {
+            slot = treeCount++;     // arrays left over from before an invalidate are reused
+        } else {
+            slot = oldest;
+            unlink(slot);
+            slotOf[trees[slot].source] = -1;
+        }
+
+        Tree& tree = trees[slot];
+        int n = graph->getVertexCount();
+        if (tree.capacity < n) {
+            delete[] tree.distance;
+            delete[] tree.previous;
+            tree.distance = new double[n];
+            tree.previous = new int[n];
+            tree.capacity = n;
+        }
+        tree.size = n;      // a smaller graph keeps the bigger arrays for later
+        tree.source = source;
+        graph->dijkstra(source, tree.distance, tree.previous);
+
+        slotOf[source] = slot;
+        pushNewest(slot);
+        return tree;
+    }
+
+public:
+    static const int DEFAULT_TREES = 16;
+
+    ShortestPathTreeCache(Graph* g, int capacity = DEFAULT_TREES) {
+        graph = g;
+        maxTrees = capacity > 0 ? capacity : 1;
+        trees = new Tree[maxTrees];
+        for (int i = 0; i < maxTrees; i++) {
+            trees[i].source = -1;
+            trees[i].size = 0;
+            trees[i].capacity = 0;
+            trees[i].distance = nullptr;
+            trees[i].previous = nullptr;
+            trees[i].newer = -1;
+            trees[i].older = -1;
+        }
+        treeCount = 0;
+        newest = -1;
+        oldest = -1;
+        revision = g->getRevision();
+        slotOf = nullptr;
+        slotRange = 0;
+        path = nullptr;
+        pathCapacity = 0;
+        hits = 0;
+        misses = 0;
+        pendingCount = 0;
+        firstChild = nullptr;
+        nextSibling = nullptr;
+        affected = nullptr;
+        mark = nullptr;
+        markEpoch = 0;
+        handle = nullptr;
+        repairs = 0;
+        resettled = 0;
+    }
+
+    // ShortestPathTreeCache::route(source, target, pathOut, length)
+    // Time: O(L) on a hit (L = vertices on the path), O((V + E) log V) on a miss,
+    //       O(alpha(V)) when source and target are in different components
+    // Space: O(1) on a hit
+    // distance from source to target, GRAPH_MAX_DISTANCE (length 0) if either is
+    // invalid or target is unreachable. pathOut lists the vertices in travel order
+    double route(int source, int target, const int*& pathOut, int& length) {
+        pathOut = nullptr;
+        length = 0;
+        syncWithGraph();
+        int n = graph->getVertexCount();
+        if (source < 0 || source >= n || target < 0 || target >= n) {
+            return GRAPH_MAX_DISTANCE;
+        }
+        if (!graph->connected(source, target)) {
+            return GRAPH_MAX_DISTANCE;      // no tree built for a hopeless query
+        }
+
+        Tree& tree = treeFor(source);
+        double distance = tree.distance[target];
+        if (distance >= GRAPH_MAX_DISTANCE) {
+            return GRAPH_MAX_DISTANCE;
+        }
+
+        for (int v = target; v != -1; v = tree.previous[v]) {
+            length++;
+        }
+        if (length > pathCapacity) {
+            delete[] path;
+            pathCapacity = length > 16 ? length : 16;
+            path = new int[pathCapacity];
+        }
+        int position = length - 1;
+        for (int v = target; v != -1; v = tree.previous[v]) {
+            path[position--] = v;
+        }
+        pathOut = path;
+        return distance;
+    }
+
+    // ShortestPathTreeCache::distance(source, target)
+    // Time: O(1) on a hit
+    // Space: O(1) on a hit
+    double distance(int source, int target) {
+        syncWithGraph();
+        int n = graph->getVertexCount();
+        if (source < 0 || source >= n || target < 0 || target >= n) {
+            return GRAPH_MAX_DISTANCE;
+        }
+        return treeFor(source).distance[target];
+    }
+
+    // ShortestPathTreeCache::refresh()
+    // Time: same as syncWithGraph
+    // Space: same as syncWithGraph
+    // brings the cached trees up to date now instead of on the next lookup
+    void refresh() {
+        syncWithGraph();
+    }
+
+    // ShortestPathTreeCache::invalidate()
+    // Time: O(maxTrees) - tree arrays are kept and refilled by later misses
+    // Space: O(1)
+    void invalidate() {
+        for (int i = 0; i < treeCount; i++) {
+            if (trees[i].source < slotRange) {
+                slotOf[trees[i].source] = -1;
+            }
+        }
+        treeCount = 0;
+        newest = -1;
+        oldest = -1;
+    }
+
+    long long getHits() { return hits; }
+    long long getMisses() { return misses; }
+    int getTreeCount() { return treeCount; }
+    long long getRepairs() { return repairs; }          // trees repaired in place
+    long long getResettled() { return resettled; }      // vertices re-settled by repairs
+
+    ~ShortestPathTreeCache() {
+        for (int i = 0; i < maxTrees; i++) {
+            delete[] trees[i].distance;
+            delete[] trees[i].previous;
+        }
+        delete[] trees;
+        delete[] slotOf;
+        delete[] firstChild;
+        delete[] nextSibling;
+        delete[] affected;
+        delete[] mark;
+        delete[] handle;
+        delete[] path;
+    }
+};
+
+#endif
@@ -55,6 +55,11 @@ void stringConcat(char* dest, const char* src) {
     dest[destLen + i] = '\0';
 }
 
+// the whitespace trim() strips: spaces, tabs and line endings (CSV lines end in \r\n)
+bool isTrimSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
 // trim whitespace from string
 void trim(char* str) {
     int start = 0;
@@ -66,13 +71,13 @@ void trim(char* str) {
     if (len == 0) return;
     
     // find first non-space character
-    while (str[start] == ' ' || str[start] == '\t' || str[start] == '\n' || str[start] == '\r') {
+    while (isTrimSpace(str[start])) {
         start++;
     }
     
     // find last non-space character
     end = len - 1;
-    while (end >= start && (str[end] == ' ' || str[end] == '\t' || str[end] == '\n' || str[end] == '\r')) {
+    while (end >= start && isTrimSpace(str[end])) {
         end--;
     }
     
@@ -137,4 +142,28 @@ void normalizeInput(char* str) {
     toUpperCase(str);
 }
 
+// ========== STRING VIEW (LENGTH-DELIMITED KEY) ==========
+// non-owning pointer + length, so lookups never copy the key and have no length limit
+// (data does not need to be null-terminated)
+struct StringView {
+    const char* data;
+    int length;
+
+    StringView() {
+        data = "";
+        length = 0;
+    }
+
+    // lets every existing const char* call site pass straight through
+    StringView(const char* str) {
+        data = str;
+        length = stringLength(str);
+    }
+
+    StringView(const char* str, int len) {
+        data = str;
+        length = len;
+    }
+};
+
 #endif
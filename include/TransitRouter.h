@@ -0,0 +1,1021 @@
+#ifndef TRANSITROUTER_H
+#define TRANSITROUTER_H
+
+#include "MultimodalNetwork.h"
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+// ========== TRANSIT ROUTER ==========
+// timetable routing over bus lines, trains and flights, round by round (RAPTOR):
+// round k finds the earliest arrival everywhere using k vehicles, so one query gives
+// both the earliest arrival and the journey with the fewest transfers.
+// everything is compiled once into flat arrays:
+//  - a route is a stop sequence plus its trips, sorted by departure and never
+//    overtaking one another; the stop times of a route are one block, trip after
+//    trip, so scanning a route walks memory front to back
+//  - stops are the multimodal network's places, footpaths its transfer links
+//    (walk + boarding minutes, which double as the minimum connection time)
+//  - every flight and train is a trip of its own (HH:MM departure / arrival).
+//    bus lines carry no timetable, so each Bus::route runs both ways on a fixed
+//    headway with run times from the stop graph
+// the timetable recompiles by itself when the network or the vehicle counts change
+
+const int TRANSIT_NEVER = 1 << 30;     // "not reached" arrival time
+
+// "HH:MM" -> minutes after midnight, -1 if it is not a valid clock time
+// parseClockMinutes(text)
+// Time: O(1)
+// Space: O(1)
+int parseClockMinutes(const char* text) {
+    int hours = 0;
+    int minutes = 0;
+    int i = 0;
+    if (text[i] < '0' || text[i] > '9') {
+        return -1;
+    }
+    while (text[i] >= '0' && text[i] <= '9') {
+        hours = hours * 10 + (text[i] - '0');
+        i++;
+    }
+    if (text[i] != ':' || text[i + 1] < '0' || text[i + 1] > '9' ||
+        text[i + 2] < '0' || text[i + 2] > '9' || text[i + 3] != '\0') {
+        return -1;
+    }
+    minutes = (text[i + 1] - '0') * 10 + (text[i + 2] - '0');
+    if (hours > 23 || minutes > 59) {
+        return -1;
+    }
+    return hours * 60 + minutes;
+}
+
+// minutes after midnight -> "HH:MM" ("+1d" appended past midnight); out needs 12 chars
+void formatClock(int minutes, char* out) {
+    int day = minutes / 1440;
+    int hours = (minutes % 1440) / 60;
+    int mins = minutes % 60;
+    out[0] = (char)('0' + hours / 10);
+    out[1] = (char)('0' + hours % 10);
+    out[2] = ':';
+    out[3] = (char)('0' + mins / 10);
+    out[4] = (char)('0' + mins % 10);
+    out[5] = '\0';
+    if (day > 0) {
+        out[5] = '+';
+        out[6] = (char)('0' + (day > 9 ? 9 : day));
+        out[7] = 'd';
+        out[8] = '\0';
+    }
+}
+
+// one leg of a timetable journey
+struct TransitLeg {
+    int mode;           // TravelMode of the vehicle, -1 = walk / transfer
+    int trip;           // trip index (-1 for walks)
+    int fromPlace;      // multimodal network places
+    int toPlace;
+    int departure;      // minutes after midnight
+    int arrival;
+};
+
+class TransitRouter {
+private:
+    // a vehicle run while the timetable is being collected
+    struct RawTrip {
+        int start;          // into rawPlaces / rawArrival / rawDeparture
+        int length;
+        int mode;
+        int pattern;        // raw trip that first used this stop sequence
+        char label[20];
+    };
+
+    static const int CARRIED = -1;      // parentTrip values besides trip indices:
+    static const int ORIGIN = -2;       // same arrival as the round before / the start
+
+    MultimodalNetwork* network;
+    TransportSystem* buses;
+    RailwaySystem* rails;
+    AirportSystem* flights;
+
+    // bus service used to turn lines into trips
+    int firstBus;
+    int lastBus;
+    int busHeadway;
+
+    // compiled timetable
+    bool compiled;
+    unsigned int compiledBuild;         // network build it belongs to
+    unsigned long long compiledFingerprint; // vehicles and line lengths it was made from
+    double compileMillis;
+    int placeCount;
+    int routeCount;
+    int tripCount;
+    int stopTimeCount;
+    int* routeStopStart;    // route r stops at routeStops[routeStopStart[r] .. routeStopStart[r + 1])
+    int* routeStops;
+    int* routeTripStart;    // route r owns trips routeTripStart[r] .. routeTripStart[r + 1] - 1
+    int* routeTimeStart;    // local trip t at position p: routeTimeStart[r] + t * length + p
+    int* routeMode;
+    int* arrivals;          // stop times, one block per route
+    int* departures;
+    int* tripRoute;
+    char (*tripLabel)[20];
+    int* stopRouteStart;    // routes through place s: [stopRouteStart[s], stopRouteStart[s + 1])
+    int* stopRoutes;
+    int* stopRoutePosition; // position of s on that route
+    int* footStart;         // transfers out of place s: [footStart[s], footStart[s + 1])
+    int* footTarget;
+    int* footMinutes;
+
+    // query state: (rounds + 1) x placeCount, reused between queries
+    int roundsAllocated;
+    int placesAllocated;
+    int routesAllocated;
+    // a round keeps two labels per place: the vehicle arrival and the best arrival
+    // after walking, so a walk always starts where a vehicle stopped
+    int* roundArrival;      // [k * placeCount + s], best arrival in round k
+    int* rideArrival;       // vehicle arrival in round k (valid where parentTrip is a trip / ORIGIN)
+    int* parentTrip;        // trip that reached s in round k, or CARRIED / ORIGIN
+    int* parentFrom;        // boarding place of that trip
+    int* parentBoard;       // boarding position on the trip's route
+    int* walkFrom;          // place the round k walk to s started from, -1 = not walked
+    int* bestArrival;       // earliest arrival at s over all rounds so far
+    bool* isMarked;
+    int* marked;
+    int markedCount;
+    int* routeQueuePosition;    // earliest marked position per route, -1 = not queued
+    int* routeQueue;
+    int queuedCount;
+
+    // last query
+    int optionCount;
+    int* optionRound;
+    int* optionArrival;
+    int lastTarget;
+    double lastQueryMicros;
+
+    TransitRouter(const TransitRouter&);
+    TransitRouter& operator=(const TransitRouter&);
+
+    // TransitRouter::grow(data, count, capacity)
+    // Time: O(count)
+    // Space: O(capacity)
+    template <typename T>
+    static void grow(T*& data, int count, int capacity) {
+        T* newData = new T[capacity];
+        for (int i = 0; i < count; i++) {
+            newData[i] = data[i];
+        }
+        delete[] data;
+        data = newData;
+    }
+
+    // TransitRouter::append(data, count, capacity, value)
+    // Time: O(1) amortized
+    // Space: O(1) amortized
+    template <typename T>
+    static void append(T*& data, int& count, int& capacity, const T& value) {
+        if (count == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 16;
+            grow(data, count, capacity);
+        }
+        data[count++] = value;
+    }
+
+    // TransitRouter::sortIndices(order, count, before)
+    // Time: O(n log n) - bottom-up merge sort, stable
+    // Space: O(n)
+    template <typename Before>
+    static void sortIndices(int* order, int count, Before before) {
+        int* buffer = new int[count > 0 ? count : 1];
+        for (int width = 1; width < count; width = width * 2) {
+            for (int low = 0; low < count; low += 2 * width) {
+                int middle = low + width < count ? low + width : count;
+                int high = low + 2 * width < count ? low + 2 * width : count;
+                int a = low;
+                int b = middle;
+                int out = low;
+                while (a < middle && b < high) {
+                    buffer[out++] = before(order[b], order[a]) ? order[b++] : order[a++];
+                }
+                while (a < middle) buffer[out++] = order[a++];
+                while (b < high) buffer[out++] = order[b++];
+            }
+            for (int i = 0; i < count; i++) {
+                order[i] = buffer[i];
+            }
+        }
+        delete[] buffer;
+    }
+
+    // TransitRouter::fingerprint()
+    // Time: O(B) where B = buses
+    // Space: O(1)
+    // changes whenever a vehicle is added or a bus line grows; unsigned so the
+    // running hash wraps instead of overflowing
+    unsigned long long fingerprint() {
+        unsigned long long print = (unsigned long long)flights->getFlightCount() * 1000003ULL +
+                                   (unsigned long long)rails->getTrainCount() * 10007ULL;
+        buses->forEachBus([&print](Bus& bus) {
+            print = print * 31 + (unsigned long long)bus.route.getLength() + 1;
+        });
+        return print;
+    }
+
+    void releaseTimetable() {
+        delete[] routeStopStart;
+        delete[] routeStops;
+        delete[] routeTripStart;
+        delete[] routeTimeStart;
+        delete[] routeMode;
+        delete[] arrivals;
+        delete[] departures;
+        delete[] tripRoute;
+        delete[] tripLabel;
+        delete[] stopRouteStart;
+        delete[] stopRoutes;
+        delete[] stopRoutePosition;
+        delete[] footStart;
+        delete[] footTarget;
+        delete[] footMinutes;
+        routeStopStart = nullptr;
+        routeStops = nullptr;
+        routeTripStart = nullptr;
+        routeTimeStart = nullptr;
+        routeMode = nullptr;
+        arrivals = nullptr;
+        departures = nullptr;
+        tripRoute = nullptr;
+        tripLabel = nullptr;
+        stopRouteStart = nullptr;
+        stopRoutes = nullptr;
+        stopRoutePosition = nullptr;
+        footStart = nullptr;
+        footTarget = nullptr;
+        footMinutes = nullptr;
+    }
+
+    // TransitRouter::compile()
+    // Time: O(T L log T) for T trips of L stops, + O(P * R) pattern lookups
+    //       (R = distinct stop sequences) + O(V + E) for the footpaths
+    // Space: O(T L + V + E)
+    void compile() {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        network->refresh();
+        releaseTimetable();
+        placeCount = network->getPlaceCount();
+
+        // 1. every vehicle run as a raw trip
+        RawTrip* raw = nullptr;
+        int rawCount = 0, rawCapacity = 0;
+        int* rawPlaces = nullptr;
+        int* rawArrival = nullptr;
+        int* rawDeparture = nullptr;
+        int rawStopCount = 0, stopCapacity = 0;
+        auto addStopTime = [&](int place, int arrival, int departure) {
+            if (rawStopCount == stopCapacity) {
+                stopCapacity = stopCapacity > 0 ? stopCapacity * 2 : 64;
+                grow(rawPlaces, rawStopCount, stopCapacity);
+                grow(rawArrival, rawStopCount, stopCapacity);
+                grow(rawDeparture, rawStopCount, stopCapacity);
+            }
+            rawPlaces[rawStopCount] = place;
+            rawArrival[rawStopCount] = arrival;
+            rawDeparture[rawStopCount] = departure;
+            rawStopCount++;
+        };
+
+        Graph* stopGraph = buses->getStopGraph();
+        double busRate = network->getMinutesPerKm(MODE_BUS);
+        int* runMinutes = nullptr;
+        int runCapacity = 0;
+        buses->forEachBus([&](Bus& bus) {
+            int length = bus.route.getLength();
+            if (length < 2) {
+                return;
+            }
+            if (length > runCapacity) {
+                delete[] runMinutes;
+                runCapacity = length;
+                runMinutes = new int[runCapacity];
+            }
+            for (int direction = 0; direction < 2; direction++) {
+                // run times between consecutive stops; the line ends at the first gap
+                int stops = 1;
+                for (int i = 1; i < length; i++) {
+                    int a = bus.route.stopAt(direction == 0 ? i - 1 : length - i);
+                    int b = bus.route.stopAt(direction == 0 ? i : length - 1 - i);
+                    double km = stopGraph->findRoute(a, b);
+                    if (km >= GRAPH_MAX_DISTANCE) {
+                        break;
+                    }
+                    int minutes = (int)(km * busRate + 0.999);
+                    runMinutes[i] = minutes > 0 ? minutes : 1;
+                    stops++;
+                }
+                if (stops < 2) {
+                    continue;
+                }
+                for (int depart = firstBus; depart <= lastBus; depart += busHeadway) {
+                    RawTrip trip;
+                    trip.start = rawStopCount;
+                    trip.length = stops;
+                    trip.mode = MODE_BUS;
+                    trip.pattern = -1;
+                    stringCopyN(trip.label, bus.busNo, 20);
+                    int clock = depart;
+                    for (int i = 0; i < stops; i++) {
+                        if (i > 0) {
+                            clock += runMinutes[i];
+                        }
+                        int stop = bus.route.stopAt(direction == 0 ? i : length - 1 - i);
+                        addStopTime(network->placeOf(MODE_BUS, stop), clock, clock);
+                    }
+                    append(raw, rawCount, rawCapacity, trip);
+                }
+            }
+        });
+        delete[] runMinutes;
+
+        // flights and trains: one hop each, arriving the next day if the clock wrapped
+        auto addHop = [&](int mode, Graph* layerGraph, const char* label, const char* from,
+                          const char* to, const char* departs, const char* arrives) {
+            int a = layerGraph->indexOf(from);
+            int b = layerGraph->indexOf(to);
+            int departure = parseClockMinutes(departs);
+            int arrival = parseClockMinutes(arrives);
+            if (a == -1 || b == -1 || a == b || departure < 0 || arrival < 0) {
+                return;
+            }
+            if (arrival < departure) {
+                arrival += 1440;
+            }
+            RawTrip trip;
+            trip.start = rawStopCount;
+            trip.length = 2;
+            trip.mode = mode;
+            trip.pattern = -1;
+            stringCopyN(trip.label, label, 20);
+            addStopTime(network->placeOf(mode, a), departure, departure);
+            addStopTime(network->placeOf(mode, b), arrival, arrival);
+            append(raw, rawCount, rawCapacity, trip);
+        };
+        rails->forEachTrain([&](Train& train) {
+            addHop(MODE_RAIL, rails->getStationGraph(), train.trainNo, train.departureStation,
+                   train.arrivalStation, train.departureTime, train.arrivalTime);
+        });
+        flights->forEachFlight([&](Flight& flight) {
+            addHop(MODE_AIR, flights->getAirportGraph(), flight.flightNo, flight.departureAirport,
+                   flight.arrivalAirport, flight.departureTime, flight.arrivalTime);
+        });
+
+        // 2. trips with the same mode and stop sequence share a pattern
+        int* patterns = nullptr;
+        int patternCount = 0, patternCapacity = 0;
+        for (int t = 0; t < rawCount; t++) {
+            RawTrip& trip = raw[t];
+            for (int i = 0; i < patternCount && trip.pattern == -1; i++) {
+                RawTrip& other = raw[patterns[i]];
+                if (other.length != trip.length || other.mode != trip.mode) {
+                    continue;
+                }
+                int p = 0;
+                while (p < trip.length && rawPlaces[other.start + p] == rawPlaces[trip.start + p]) {
+                    p++;
+                }
+                if (p == trip.length) {
+                    trip.pattern = patterns[i];
+                }
+            }
+            if (trip.pattern == -1) {
+                trip.pattern = t;
+                append(patterns, patternCount, patternCapacity, t);
+            }
+        }
+
+        // 3. per pattern by first departure, then split into non-overtaking routes:
+        //    a trip joins the first route whose last trip it never runs ahead of
+        int* order = new int[rawCount > 0 ? rawCount : 1];
+        for (int t = 0; t < rawCount; t++) {
+            order[t] = t;
+        }
+        sortIndices(order, rawCount, [&](int a, int b) {
+            if (raw[a].pattern != raw[b].pattern) {
+                return raw[a].pattern < raw[b].pattern;
+            }
+            return rawDeparture[raw[a].start] < rawDeparture[raw[b].start];
+        });
+        int* rawRoute = new int[rawCount > 0 ? rawCount : 1];
+        int* routeLastTrip = nullptr;
+        int* routeFirstRaw = nullptr;
+        int routeTotal = 0, routeCapacity = 0;
+        int patternRoutesBegin = 0;
+        for (int i = 0; i < rawCount; i++) {
+            int t = order[i];
+            if (i == 0 || raw[order[i - 1]].pattern != raw[t].pattern) {
+                patternRoutesBegin = routeTotal;
+            }
+            int chosen = -1;
+            for (int r = patternRoutesBegin; r < routeTotal && chosen == -1; r++) {
+                int last = routeLastTrip[r];
+                bool behind = true;
+                for (int p = 0; p < raw[t].length && behind; p++) {
+                    behind = rawArrival[raw[t].start + p] >= rawArrival[raw[last].start + p] &&
+                             rawDeparture[raw[t].start + p] >= rawDeparture[raw[last].start + p];
+                }
+                if (behind) {
+                    chosen = r;
+                }
+            }
+            if (chosen == -1) {
+                if (routeTotal == routeCapacity) {
+                    routeCapacity = routeCapacity > 0 ? routeCapacity * 2 : 16;
+                    grow(routeFirstRaw, routeTotal, routeCapacity);
+                    grow(routeLastTrip, routeTotal, routeCapacity);
+                }
+                chosen = routeTotal++;
+                routeFirstRaw[chosen] = t;
+            }
+            routeLastTrip[chosen] = t;
+            rawRoute[t] = chosen;
+        }
+
+        // 4. flat arrays: routes, then their trips in departure order
+        routeCount = routeTotal;
+        tripCount = rawCount;
+        routeStopStart = new int[routeCount + 1];
+        routeTripStart = new int[routeCount + 1];
+        routeTimeStart = new int[routeCount > 0 ? routeCount : 1];
+        routeMode = new int[routeCount > 0 ? routeCount : 1];
+        for (int r = 0; r <= routeCount; r++) {
+            routeTripStart[r] = 0;
+        }
+        for (int t = 0; t < rawCount; t++) {
+            routeTripStart[rawRoute[t] + 1]++;
+        }
+        routeStopStart[0] = 0;
+        stopTimeCount = 0;
+        for (int r = 0; r < routeCount; r++) {
+            RawTrip& first = raw[routeFirstRaw[r]];
+            routeStopStart[r + 1] = routeStopStart[r] + first.length;
+            routeMode[r] = first.mode;
+            routeTimeStart[r] = stopTimeCount;
+            stopTimeCount += routeTripStart[r + 1] * first.length;
+            routeTripStart[r + 1] += routeTripStart[r];
+        }
+        routeStops = new int[routeStopStart[routeCount] > 0 ? routeStopStart[routeCount] : 1];
+        for (int r = 0; r < routeCount; r++) {
+            RawTrip& first = raw[routeFirstRaw[r]];
+            for (int p = 0; p < first.length; p++) {
+                routeStops[routeStopStart[r] + p] = rawPlaces[first.start + p];
+            }
+        }
+        arrivals = new int[stopTimeCount > 0 ? stopTimeCount : 1];
+        departures = new int[stopTimeCount > 0 ? stopTimeCount : 1];
+        tripRoute = new int[tripCount > 0 ? tripCount : 1];
+        tripLabel = new char[tripCount > 0 ? tripCount : 1][20];
+        int* routeFill = new int[routeCount > 0 ? routeCount : 1];
+        for (int r = 0; r < routeCount; r++) {
+            routeFill[r] = 0;
+        }
+        for (int i = 0; i < rawCount; i++) {   // sorted order keeps departures ascending
+            int t = order[i];
+            int r = rawRoute[t];
+            int local = routeFill[r]++;
+            int trip = routeTripStart[r] + local;
+            int length = raw[t].length;
+            tripRoute[trip] = r;
+            stringCopy(tripLabel[trip], raw[t].label);
+            for (int p = 0; p < length; p++) {
+                arrivals[routeTimeStart[r] + local * length + p] = rawArrival[raw[t].start + p];
+                departures[routeTimeStart[r] + local * length + p] = rawDeparture[raw[t].start + p];
+            }
+        }
+        delete[] routeFill;
+
+        // 5. place -> (route, position), and the footpaths
+        stopRouteStart = new int[placeCount + 1];
+        for (int s = 0; s <= placeCount; s++) {
+            stopRouteStart[s] = 0;
+        }
+        int servedTotal = routeStopStart[routeCount];
+        for (int i = 0; i < servedTotal; i++) {
+            stopRouteStart[routeStops[i] + 1]++;
+        }
+        for (int s = 0; s < placeCount; s++) {
+            stopRouteStart[s + 1] += stopRouteStart[s];
+        }
+        stopRoutes = new int[servedTotal > 0 ? servedTotal : 1];
+        stopRoutePosition = new int[servedTotal > 0 ? servedTotal : 1];
+        int* stopFill = new int[placeCount > 0 ? placeCount : 1];
+        for (int s = 0; s < placeCount; s++) {
+            stopFill[s] = stopRouteStart[s];
+        }
+        for (int r = 0; r < routeCount; r++) {
+            for (int p = routeStopStart[r]; p < routeStopStart[r + 1]; p++) {
+                int slot = stopFill[routeStops[p]]++;
+                stopRoutes[slot] = r;
+                stopRoutePosition[slot] = p - routeStopStart[r];
+            }
+        }
+        delete[] stopFill;
+
+        footStart = new int[placeCount + 1];
+        int footCount = 0, footCapacity = 0;
+        for (int s = 0; s < placeCount; s++) {
+            footStart[s] = footCount;
+            network->forEachTransfer(s, [&](int dest, double minutes) {
+                if (footCount == footCapacity) {
+                    footCapacity = footCapacity > 0 ? footCapacity * 2 : 16;
+                    grow(footTarget, footCount, footCapacity);
+                    grow(footMinutes, footCount, footCapacity);
+                }
+                footTarget[footCount] = dest;
+                footMinutes[footCount] = (int)(minutes + 0.999);
+                footCount++;
+            });
+        }
+        footStart[placeCount] = footCount;
+
+        delete[] raw;
+        delete[] rawPlaces;
+        delete[] rawArrival;
+        delete[] rawDeparture;
+        delete[] patterns;
+        delete[] order;
+        delete[] rawRoute;
+        delete[] routeLastTrip;
+        delete[] routeFirstRaw;
+
+        compiled = true;
+        compiledBuild = network->getBuildCount();
+        compiledFingerprint = fingerprint();
+        compileMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // TransitRouter::ensureCompiled()
+    // Time: O(B) fingerprint check, a full compile when something changed
+    // Space: see compile
+    void ensureCompiled() {
+        network->refresh();
+        if (!compiled || compiledBuild != network->getBuildCount() || compiledFingerprint != fingerprint()) {
+            compile();
+        }
+    }
+
+    // TransitRouter::reserveRounds(rounds)
+    // Time: O(rounds * V) when the state grows
+    // Space: O(rounds * V)
+    void reserveRounds(int rounds) {
+        if (rounds <= roundsAllocated && placeCount <= placesAllocated && routeCount <= routesAllocated) {
+            return;
+        }
+        int newRounds = rounds > roundsAllocated ? rounds : roundsAllocated;
+        int newPlaces = placeCount > placesAllocated ? placeCount : placesAllocated;
+        int newRoutes = routeCount > routesAllocated ? routeCount : routesAllocated;
+        delete[] roundArrival;
+        delete[] rideArrival;
+        delete[] parentTrip;
+        delete[] parentFrom;
+        delete[] parentBoard;
+        delete[] walkFrom;
+        delete[] bestArrival;
+        delete[] isMarked;
+        delete[] marked;
+        delete[] routeQueuePosition;
+        delete[] routeQueue;
+        delete[] optionRound;
+        delete[] optionArrival;
+        int cells = (newRounds + 1) * (newPlaces > 0 ? newPlaces : 1);
+        roundArrival = new int[cells];
+        rideArrival = new int[cells];
+        parentTrip = new int[cells];
+        parentFrom = new int[cells];
+        parentBoard = new int[cells];
+        walkFrom = new int[cells];
+        bestArrival = new int[newPlaces > 0 ? newPlaces : 1];
+        isMarked = new bool[newPlaces > 0 ? newPlaces : 1];
+        marked = new int[newPlaces > 0 ? newPlaces : 1];
+        for (int s = 0; s < newPlaces; s++) {
+            isMarked[s] = false;
+        }
+        routeQueuePosition = new int[newRoutes > 0 ? newRoutes : 1];
+        routeQueue = new int[newRoutes > 0 ? newRoutes : 1];
+        for (int r = 0; r < newRoutes; r++) {
+            routeQueuePosition[r] = -1;
+        }
+        optionRound = new int[newRounds + 1];
+        optionArrival = new int[newRounds + 1];
+        roundsAllocated = newRounds;
+        placesAllocated = newPlaces;
+        routesAllocated = newRoutes;
+    }
+
+    void mark(int s) {
+        if (!isMarked[s]) {
+            isMarked[s] = true;
+            marked[markedCount++] = s;
+        }
+    }
+
+    // TransitRouter::relaxFootpaths(round, target)
+    // Time: O(transfers out of the marked places)
+    // Space: O(1)
+    // walks start from the vehicle arrivals of this round only, so they never chain
+    // and the order the marked places are visited in does not matter
+    void relaxFootpaths(int round, int target) {
+        int* arrival = roundArrival + round * placeCount;
+        const int* ride = rideArrival + round * placeCount;
+        int count = markedCount;    // everything marked so far was reached by a vehicle
+        for (int i = 0; i < count; i++) {
+            int s = marked[i];
+            for (int f = footStart[s]; f < footStart[s + 1]; f++) {
+                int dest = footTarget[f];
+                int candidate = ride[s] + footMinutes[f];
+                if (candidate < bestArrival[dest] && candidate < bestArrival[target]) {
+                    arrival[dest] = candidate;
+                    bestArrival[dest] = candidate;
+                    walkFrom[round * placeCount + dest] = s;
+                    mark(dest);
+                }
+            }
+        }
+    }
+
+    // TransitRouter::earliestTrip(route, position, readyAt, limit)
+    // Time: O(log T) - binary search down one column of the route's stop times
+    // Space: O(1)
+    // first local trip below limit departing position at or after readyAt, limit if none
+    int earliestTrip(int route, int position, int readyAt, int limit) {
+        int length = routeStopStart[route + 1] - routeStopStart[route];
+        const int* column = departures + routeTimeStart[route] + position;
+        int low = 0;
+        int high = limit;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (column[middle * length] >= readyAt) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        return low;
+    }
+
+    // TransitRouter::scanRoute(route, from, round, target)
+    // Time: O(L log T) - one pass down the route, catching earlier trips as they appear
+    // Space: O(1)
+    void scanRoute(int route, int from, int round, int target) {
+        int length = routeStopStart[route + 1] - routeStopStart[route];
+        int trips = routeTripStart[route + 1] - routeTripStart[route];
+        const int* stops = routeStops + routeStopStart[route];
+        const int* previous = roundArrival + (round - 1) * placeCount;
+        int* arrival = roundArrival + round * placeCount;
+        int trip = -1;              // local trip being ridden
+        int boardPlace = -1;
+        int boardPosition = -1;
+        const int* tripArrivals = nullptr;
+        const int* tripDepartures = nullptr;
+        for (int p = from; p < length; p++) {
+            int s = stops[p];
+            if (trip != -1) {
+                int reach = tripArrivals[p];
+                int bound = bestArrival[s] < bestArrival[target] ? bestArrival[s] : bestArrival[target];
+                if (reach < bound) {
+                    arrival[s] = reach;
+                    rideArrival[round * placeCount + s] = reach;
+                    bestArrival[s] = reach;
+                    parentTrip[round * placeCount + s] = routeTripStart[route] + trip;
+                    parentFrom[round * placeCount + s] = boardPlace;
+                    parentBoard[round * placeCount + s] = boardPosition;
+                    mark(s);
+                }
+            }
+            // an earlier trip can be caught here if we were at s by the last round
+            if (previous[s] < TRANSIT_NEVER && (trip == -1 || previous[s] <= tripDepartures[p])) {
+                int caught = earliestTrip(route, p, previous[s], trip == -1 ? trips : trip);
+                if (caught < (trip == -1 ? trips : trip)) {
+                    trip = caught;
+                    boardPlace = s;
+                    boardPosition = p;
+                    tripArrivals = arrivals + routeTimeStart[route] + trip * length;
+                    tripDepartures = departures + routeTimeStart[route] + trip * length;
+                }
+            }
+        }
+    }
+
+public:
+    static const int DEFAULT_ROUNDS = 6;            // up to 5 transfers
+    static const int DEFAULT_FIRST_BUS = 6 * 60;
+    static const int DEFAULT_LAST_BUS = 22 * 60;
+    static const int DEFAULT_HEADWAY = 15;
+
+    TransitRouter(MultimodalNetwork* places, TransportSystem* transport, RailwaySystem* railway,
+                  AirportSystem* airports) {
+        network = places;
+        buses = transport;
+        rails = railway;
+        flights = airports;
+        firstBus = DEFAULT_FIRST_BUS;
+        lastBus = DEFAULT_LAST_BUS;
+        busHeadway = DEFAULT_HEADWAY;
+        compiled = false;
+        compiledBuild = 0;
+        compiledFingerprint = 0;
+        compileMillis = 0;
+        placeCount = 0;
+        routeCount = 0;
+        tripCount = 0;
+        stopTimeCount = 0;
+        routeStopStart = nullptr;
+        routeStops = nullptr;
+        routeTripStart = nullptr;
+        routeTimeStart = nullptr;
+        routeMode = nullptr;
+        arrivals = nullptr;
+        departures = nullptr;
+        tripRoute = nullptr;
+        tripLabel = nullptr;
+        stopRouteStart = nullptr;
+        stopRoutes = nullptr;
+        stopRoutePosition = nullptr;
+        footStart = nullptr;
+        footTarget = nullptr;
+        footMinutes = nullptr;
+        roundsAllocated = 0;
+        placesAllocated = 0;
+        routesAllocated = 0;
+        roundArrival = nullptr;
+        rideArrival = nullptr;
+        parentTrip = nullptr;
+        parentFrom = nullptr;
+        parentBoard = nullptr;
+        walkFrom = nullptr;
+        bestArrival = nullptr;
+        isMarked = nullptr;
+        marked = nullptr;
+        markedCount = 0;
+        routeQueuePosition = nullptr;
+        routeQueue = nullptr;
+        queuedCount = 0;
+        optionCount = 0;
+        optionRound = nullptr;
+        optionArrival = nullptr;
+        lastTarget = -1;
+        lastQueryMicros = 0;
+    }
+
+    // TransitRouter::setBusService(first, last, headway)
+    // Time: O(1) - the timetable is recompiled on the next query
+    // Space: O(1)
+    // every bus line leaves its first stop at first, first + headway, ... up to last
+    void setBusService(int first, int last, int headway) {
+        if (first < 0 || last < first || last >= 1440 || headway <= 0) {
+            cout << "[ERROR] Invalid bus service!" << endl;
+            return;
+        }
+        firstBus = first;
+        lastBus = last;
+        busHeadway = headway;
+        compiled = false;
+    }
+
+    // TransitRouter::plan(from, to, departure, rounds)
+    // Time: O(rounds * (R L log T + F)) over the routes R and footpaths F touched,
+    //       a compile first if the network changed
+    // Space: O(rounds * V), reused between queries
+    // earliest arrivals at place to for departing place from at departure (minutes
+    // after midnight), one option per number of vehicles that arrives strictly
+    // earlier than with fewer: option 0 has the fewest transfers, the last one
+    // arrives first. returns the number of options (0 = unreachable)
+    int plan(int from, int to, int departure, int rounds = DEFAULT_ROUNDS) {
+        ensureCompiled();
+        optionCount = 0;
+        lastTarget = to;
+        if (from < 0 || from >= placeCount || to < 0 || to >= placeCount || rounds < 1) {
+            return 0;
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        reserveRounds(rounds);
+
+        for (int s = 0; s < placeCount; s++) {
+            roundArrival[s] = TRANSIT_NEVER;
+            bestArrival[s] = TRANSIT_NEVER;
+            walkFrom[s] = -1;
+        }
+        markedCount = 0;
+        roundArrival[from] = departure;
+        rideArrival[from] = departure;
+        bestArrival[from] = departure;
+        parentTrip[from] = ORIGIN;
+        mark(from);
+        relaxFootpaths(0, to);
+        if (roundArrival[to] < TRANSIT_NEVER) {
+            optionRound[optionCount] = 0;
+            optionArrival[optionCount++] = roundArrival[to];
+        }
+
+        for (int k = 1; k <= rounds && markedCount > 0; k++) {
+            // round k starts from round k - 1's arrivals
+            int* arrival = roundArrival + k * placeCount;
+            const int* previous = roundArrival + (k - 1) * placeCount;
+            for (int s = 0; s < placeCount; s++) {
+                arrival[s] = previous[s];
+                parentTrip[k * placeCount + s] = CARRIED;
+                walkFrom[k * placeCount + s] = -1;
+            }
+
+            // routes through the places improved last round, from the earliest such stop
+            queuedCount = 0;
+            for (int i = 0; i < markedCount; i++) {
+                int s = marked[i];
+                isMarked[s] = false;
+                for (int j = stopRouteStart[s]; j < stopRouteStart[s + 1]; j++) {
+                    int r = stopRoutes[j];
+                    int position = stopRoutePosition[j];
+                    if (routeQueuePosition[r] == -1) {
+                        routeQueue[queuedCount++] = r;
+                        routeQueuePosition[r] = position;
+                    } else if (position < routeQueuePosition[r]) {
+                        routeQueuePosition[r] = position;
+                    }
+                }
+            }
+            markedCount = 0;
+
+            for (int i = 0; i < queuedCount; i++) {
+                int r = routeQueue[i];
+                scanRoute(r, routeQueuePosition[r], k, to);
+                routeQueuePosition[r] = -1;
+            }
+            relaxFootpaths(k, to);
+
+            if (arrival[to] < previous[to]) {
+                optionRound[optionCount] = k;
+                optionArrival[optionCount++] = arrival[to];
+            }
+        }
+        for (int i = 0; i < markedCount; i++) {
+            isMarked[marked[i]] = false;
+        }
+        markedCount = 0;
+        lastQueryMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return optionCount;
+    }
+
+    // TransitRouter::journey(option, legs, maxLegs)
+    // Time: O(rounds + legs)
+    // Space: O(1) - legs is the caller's
+    // legs of one option of the last plan, in travel order; returns the leg count
+    int journey(int option, TransitLeg* legs, int maxLegs) {
+        if (option < 0 || option >= optionCount) {
+            return 0;
+        }
+        int count = 0;
+        int s = lastTarget;
+        int k = optionRound[option];
+        bool walked = false;        // the vehicle label is next once a walk is taken
+        while (count < maxLegs) {
+            int cell = k * placeCount + s;
+            if (!walked && walkFrom[cell] != -1) {
+                TransitLeg& leg = legs[count++];
+                leg.mode = -1;
+                leg.trip = -1;
+                leg.fromPlace = walkFrom[cell];
+                leg.toPlace = s;
+                leg.departure = rideArrival[k * placeCount + leg.fromPlace];
+                leg.arrival = roundArrival[cell];
+                s = leg.fromPlace;
+                walked = true;
+                continue;
+            }
+            walked = false;
+            int kind = parentTrip[cell];
+            if (kind == ORIGIN) {
+                break;
+            }
+            if (kind == CARRIED) {
+                k--;
+                continue;
+            }
+            int r = tripRoute[kind];
+            int length = routeStopStart[r + 1] - routeStopStart[r];
+            int local = kind - routeTripStart[r];
+            TransitLeg& leg = legs[count++];
+            leg.mode = routeMode[r];
+            leg.trip = kind;
+            leg.fromPlace = parentFrom[cell];
+            leg.toPlace = s;
+            leg.departure = departures[routeTimeStart[r] + local * length + parentBoard[cell]];
+            leg.arrival = rideArrival[cell];
+            s = leg.fromPlace;
+            k--;
+        }
+        for (int i = 0; i < count / 2; i++) {
+            TransitLeg swap = legs[i];
+            legs[i] = legs[count - 1 - i];
+            legs[count - 1 - i] = swap;
+        }
+        return count;
+    }
+
+    // TransitRouter::planJourney(fromId, toId, departureClock)
+    // Time: see plan
+    // Space: O(rounds) for the printed legs
+    // prints every option of plan: fewest transfers first, earliest arrival last
+    void planJourney(const char* fromId, const char* toId, const char* departureClock) {
+        int departure = parseClockMinutes(departureClock);
+        if (departure < 0) {
+            cout << "\n[ERROR] Invalid departure time! Use HH:MM (e.g. 08:30)." << endl;
+            return;
+        }
+        int from = network->findPlace(fromId);
+        int to = network->findPlace(toId);
+        if (from == -1 || to == -1) {
+            cout << "\n[ERROR] Unknown stop, station or airport!" << endl;
+            cout << "[TIP] Use a bus stop ID, station ID or airport code (e.g. Stop1, AIR:ISB)." << endl;
+            return;
+        }
+        int options = plan(from, to, departure);
+        char departs[12], arrives[12];
+        if (options == 0) {
+            cout << "\n[ERROR] No timetabled journey from " << network->placeId(from) << " after "
+                 << departureClock << " (within " << DEFAULT_ROUNDS - 1 << " transfers)!" << endl;
+            formatClock(firstBus, departs);
+            formatClock(lastBus, arrives);
+            cout << "[TIP] Buses run " << departs << "-" << arrives
+                 << "; trains and flights only at their scheduled times." << endl;
+            return;
+        }
+
+        const int MAX_LEGS = 2 * DEFAULT_ROUNDS + 2;
+        TransitLeg legs[MAX_LEGS];
+        cout << "\n--- Timetable Journeys from " << network->placeId(from) << " to "
+             << network->placeId(to) << " (depart " << departureClock << ") ---" << endl;
+        for (int o = 0; o < options; o++) {
+            int count = journey(o, legs, MAX_LEGS);
+            int vehicles = 0;
+            for (int i = 0; i < count; i++) {
+                if (legs[i].mode != -1) vehicles++;
+            }
+            formatClock(optionArrival[o], arrives);
+            cout << "Option " << (o + 1) << ": arrive " << arrives << " | " << vehicles << " vehicle(s), "
+                 << (vehicles > 0 ? vehicles - 1 : 0) << " transfer(s)";
+            if (options > 1 && o == 0) cout << "  [fewest transfers]";
+            if (options > 1 && o == options - 1) cout << "  [earliest arrival]";
+            cout << endl;
+            for (int i = 0; i < count; i++) {
+                formatClock(legs[i].departure, departs);
+                formatClock(legs[i].arrival, arrives);
+                if (legs[i].mode == -1) {
+                    cout << "  [Walk] ";
+                } else {
+                    cout << "  [" << travelModeName(legs[i].mode) << " " << tripLabel[legs[i].trip] << "] ";
+                }
+                cout << network->placeId(legs[i].fromPlace) << " " << departs << " -> "
+                     << network->placeId(legs[i].toPlace) << " " << arrives << endl;
+            }
+        }
+        cout << "Query time: " << lastQueryMicros << " us" << endl;
+    }
+
+    // TransitRouter::displaySummary()
+    // Time: O(B) plus a compile if one is due
+    // Space: O(1)
+    void displaySummary() {
+        ensureCompiled();
+        cout << "\n========== TIMETABLE ==========" << endl;
+        cout << "  Places: " << placeCount << " | Footpaths: " << footStart[placeCount] << endl;
+        cout << "  Routes: " << routeCount << " | Trips: " << tripCount
+             << " | Stop times: " << stopTimeCount << endl;
+        char first[12], last[12];
+        formatClock(firstBus, first);
+        formatClock(lastBus, last);
+        cout << "  Buses every " << busHeadway << " min, " << first << "-" << last << endl;
+        cout << "  Compiled in " << compileMillis << " ms" << endl;
+        cout << "===============================" << endl;
+    }
+
+    int getRouteCount() { return routeCount; }
+    int getTripCount() { return tripCount; }
+
+    ~TransitRouter() {
+        releaseTimetable();
+        delete[] roundArrival;
+        delete[] rideArrival;
+        delete[] parentTrip;
+        delete[] parentFrom;
+        delete[] parentBoard;
+        delete[] walkFrom;
+        delete[] bestArrival;
+        delete[] isMarked;
+        delete[] marked;
+        delete[] routeQueuePosition;
+        delete[] routeQueue;
+        delete[] optionRound;
+        delete[] optionArrival;
+    }
+};
+
+#endif
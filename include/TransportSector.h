@@ -2,27 +2,35 @@
 #define TRANSPORTSECTOR_H
 
 #include "Graph.h"
-#include "HashTable.h"
+#include "ContractionHierarchy.h"
+#include "ShortestPathTreeCache.h"
+#include "ConcurrentHashMap.h"
+#include "SectorRegistry.h"
 #include "LinkedList.h"
+#include "BusRoute.h"
 #include "Stack.h"
-#include "MinHeap.h"
+#include "IndexedHeap.h"
 #include "Utils.h"
 #include "Queue.h"
+#include "RingBuffer.h"
 #include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
 using namespace std;
 
 // bus stop structure
 struct BusStop {
     char stopID[50];
     char name[100];
-    char sector[50];  // added sector field here
+    SectorId sectorId;   // interned sector name (see SectorRegistry.h)
     double latitude;
     double longitude;
     
     BusStop() {
         stopID[0] = '\0';
         name[0] = '\0';
-        sector[0] = '\0';
+        sectorId = NO_SECTOR;
         latitude = 0;
         longitude = 0;
     }
@@ -33,18 +41,35 @@ struct Bus {
     char busNo[20];
     char company[100];
     char currentStop[50];
-    LinkedList* route; // keeping track of stop IDs
+    BusRoute route;     // stop graph indices in driving order
+    int routePosition;  // which visit of currentStop the bus is on, -1 = not known yet
     
     Bus() {
         busNo[0] = '\0';
         company[0] = '\0';
         currentStop[0] = '\0';
-        route = new LinkedList();
+        routePosition = -1;
     }
     
-    ~Bus() {
-        delete route;
+    // move-only: the route arrays are owned, so they are handed over instead of copied
+    Bus(Bus&& other) : route(std::move(other.route)) {
+        stringCopy(busNo, other.busNo);
+        stringCopy(company, other.company);
+        stringCopy(currentStop, other.currentStop);
+        routePosition = other.routePosition;
     }
+    
+    Bus& operator=(Bus&& other) {
+        stringCopy(busNo, other.busNo);
+        stringCopy(company, other.company);
+        stringCopy(currentStop, other.currentStop);
+        route = std::move(other.route);
+        routePosition = other.routePosition;
+        return *this;
+    }
+    
+    Bus(const Bus&) = delete;
+    Bus& operator=(const Bus&) = delete;
 };
 
 // bonus feature: school bus structure
@@ -57,16 +82,47 @@ struct SchoolBus {
     int studentsOnBoard;
     int maxCapacity;
     
-    SchoolBus() {
+    SchoolBus(CityArena* arena = nullptr) {
         busID[0] = '\0';
         schoolID[0] = '\0';
-        studentStops = new LinkedList();
+        studentStops = new LinkedList(arena);
         visitedStops = new Stack(50);
         currentLocation[0] = '\0';
         studentsOnBoard = 0;
         maxCapacity = 50;
     }
     
+    // move-only: the stop list and history stack are owned
+    SchoolBus(SchoolBus&& other) {
+        stringCopy(busID, other.busID);
+        stringCopy(schoolID, other.schoolID);
+        studentStops = other.studentStops;
+        visitedStops = other.visitedStops;
+        stringCopy(currentLocation, other.currentLocation);
+        studentsOnBoard = other.studentsOnBoard;
+        maxCapacity = other.maxCapacity;
+        other.studentStops = nullptr;
+        other.visitedStops = nullptr;
+    }
+    
+    SchoolBus& operator=(SchoolBus&& other) {
+        stringCopy(busID, other.busID);
+        stringCopy(schoolID, other.schoolID);
+        LinkedList* tempStops = studentStops;
+        Stack* tempVisited = visitedStops;
+        studentStops = other.studentStops;
+        visitedStops = other.visitedStops;
+        other.studentStops = tempStops;
+        other.visitedStops = tempVisited;
+        stringCopy(currentLocation, other.currentLocation);
+        studentsOnBoard = other.studentsOnBoard;
+        maxCapacity = other.maxCapacity;
+        return *this;
+    }
+    
+    SchoolBus(const SchoolBus&) = delete;
+    SchoolBus& operator=(const SchoolBus&) = delete;
+    
     ~SchoolBus() {
         delete studentStops;
         delete visitedStops;
@@ -78,27 +134,48 @@ struct EmergencyVehicle {
     char vehicleID[20];
     char type[50];              // Ambulance, Fire Truck, Police
     char currentLocation[50];
+    int locationIndex;          // stop graph index of currentLocation, -1 = not resolved yet
     char destination[50];
     int priority;               // 1-10, 10 is highest
     bool active;
+    HeapHandle queueHandle;     // entry in the emergency queue while active
     
     EmergencyVehicle() {
         vehicleID[0] = '\0';
         type[0] = '\0';
         currentLocation[0] = '\0';
+        locationIndex = -1;
         destination[0] = '\0';
         priority = 5;
         active = false;
+        queueHandle = NO_HEAP_HANDLE;
+    }
+};
+
+// one GPS position report from a bus, handed from the feed thread(s) to the
+// thread that owns the tables
+struct BusGpsUpdate {
+    char busNo[20];
+    char stopID[50];
+    
+    BusGpsUpdate() {
+        busNo[0] = '\0';
+        stopID[0] = '\0';
     }
 };
 
 // transport system class
 class TransportSystem {
 private:
+    CityArena* arena;   // route edges and stop lists; released in one go
     Graph* stopGraph;
-    HashTable* busTable;
-    HashTable* stopTable;
+    ConcurrentHashMap<StringView, Bus>* busTable;        // shared with feed / visualization threads
+    ConcurrentHashMap<StringView, BusStop>* stopTable;
     Stack* routeHistory;
+    MpmcRingBuffer<BusGpsUpdate>* gpsFeed;  // lock-free inbox for GPS reports
+    ContractionHierarchy* stopHierarchy;    // optional, only used while it matches stopGraph
+    ShortestPathTreeCache* routeCache;      // recent route sources, repaired after road updates
+    PathSet* routeAlternatives;             // k shortest routes of the last findAlternates
     
     // keeping track of the numbers
     int busCount;
@@ -106,11 +183,19 @@ private:
     int routeEdgeCount;
 
 public:
+    static const int ALTERNATE_ROUTES = 3;     // alternates offered next to an emergency route
+    static const int CRITICAL_SHOWN = 5;       // most central stops listed in the route summary
+    
     TransportSystem() {
-        stopGraph = new Graph(100);
-        busTable = new HashTable(50);
-        stopTable = new HashTable(50);
+        arena = new CityArena();
+        stopGraph = new Graph(100, arena);
+        busTable = new ConcurrentHashMap<StringView, Bus>(50);
+        stopTable = new ConcurrentHashMap<StringView, BusStop>(50);
         routeHistory = new Stack(100);
+        gpsFeed = new MpmcRingBuffer<BusGpsUpdate>(1024);
+        stopHierarchy = nullptr;
+        routeCache = new ShortestPathTreeCache(stopGraph);
+        routeAlternatives = new PathSet();
         busCount = 0;
         stopCount = 0;
         routeEdgeCount = 0;
@@ -118,14 +203,14 @@ public:
     
     // adding bus stop
     void addBusStop(const char* stopID, const char* name, const char* sector, double lat, double lon) {
-        BusStop* stop = new BusStop();
-        stringCopyN(stop->stopID, stopID, 50);
-        stringCopyN(stop->name, name, 100);
-        stringCopyN(stop->sector, sector, 50);
-        stop->latitude = lat;
-        stop->longitude = lon;
-        
-        stopTable->insert(stopID, stop);
+        BusStop stop;
+        stringCopyN(stop.stopID, stopID, 50);
+        stringCopyN(stop.name, name, 100);
+        stop.sectorId = internSector(sector);
+        stop.latitude = lat;
+        stop.longitude = lon;
+        
+        stopTable->insert(stopID, std::move(stop));
         stopGraph->addVertex(stopID, lat, lon);
         stopCount++;
         
@@ -154,14 +239,12 @@ public:
         normalizeInput(stop2);
         
         // making sure Check if both stops exist
-        BusStop* stopA = (BusStop*)stopTable->search(stop1);
-        BusStop* stopB = (BusStop*)stopTable->search(stop2);
-        
-        if (stopA == nullptr) {
+        BusStop stopA, stopB;
+        if (!getStop(stop1, stopA)) {
             cout << "\n[ERROR] Stop " << stop1 << " does not exist!" << endl;
             return;
         }
-        if (stopB == nullptr) {
+        if (!getStop(stop2, stopB)) {
             cout << "\n[ERROR] Stop " << stop2 << " does not exist!" << endl;
             return;
         }
@@ -177,107 +260,236 @@ public:
         }
         
         connectStops(stop1, stop2, distance);
-        cout << "\n[OK] Connected " << stopA->name << " <-> " << stopB->name 
+        cout << "\n[OK] Connected " << stopA.name << " <-> " << stopB.name 
              << " (" << distance << " km)" << endl;
     }
     
+    // TransportSystem::updateRoad(stop1, stop2, distance)
+    // Time: Average O(k + deg(stop1) + deg(stop2)); cached route trees are repaired on the next lookup
+    // Space: O(1)
+    // changes the length of an existing two-way road, distance <= 0 closes it.
+    // false if the two stops are not directly connected
+    bool updateRoad(const char* stop1, const char* stop2, double distance) {
+        if (distance <= 0) {
+            bool closed = stopGraph->removeEdge(stop1, stop2);
+            closed = stopGraph->removeEdge(stop2, stop1) || closed;
+            if (closed) {
+                routeEdgeCount--;
+            }
+            return closed;
+        }
+        bool updated = stopGraph->updateEdgeWeight(stop1, stop2, distance);
+        updated = stopGraph->updateEdgeWeight(stop2, stop1, distance) || updated;
+        return updated;
+    }
+    
+    // Update or close a road with user input (traffic, roadworks)
+    void updateRoadManual() {
+        char stop1[50], stop2[50];
+        double distance;
+        
+        cout << "\n=== Update Road Conditions ===" << endl;
+        cout << "Enter first stop ID: ";
+        cin >> stop1;
+        normalizeInput(stop1);
+        
+        cout << "Enter second stop ID: ";
+        cin >> stop2;
+        normalizeInput(stop2);
+        
+        cout << "Enter new effective distance (km, 0 = close road): ";
+        cin >> distance;
+        
+        if (cin.fail() || distance < 0) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            cout << "[ERROR] Invalid distance!" << endl;
+            return;
+        }
+        
+        long long repairsBefore = routeCache->getRepairs();
+        long long resettledBefore = routeCache->getResettled();
+        if (!updateRoad(stop1, stop2, distance)) {
+            cout << "\n[ERROR] No road between " << stop1 << " and " << stop2 << "!" << endl;
+            return;
+        }
+        BusStop stopA, stopB;
+        getStop(stop1, stopA);
+        getStop(stop2, stopB);
+        if (distance > 0) {
+            cout << "\n[OK] " << stopA.name << " <-> " << stopB.name << " is now " << distance << " km" << endl;
+        } else {
+            cout << "\n[OK] Road " << stopA.name << " <-> " << stopB.name << " closed" << endl;
+        }
+        
+        routeCache->refresh();     // repair now so it can be reported
+        long long repaired = routeCache->getRepairs() - repairsBefore;
+        if (repaired > 0) {
+            cout << "Cached routes repaired in place: " << repaired << " source(s), "
+                 << routeCache->getResettled() - resettledBefore << " stop(s) re-settled" << endl;
+        }
+    }
+    
     // register bus
     void registerBus(const char* busNo, const char* company, const char* currentStop) {
-        Bus* bus = new Bus();
-        stringCopyN(bus->busNo, busNo, 20);
-        stringCopyN(bus->company, company, 100);
-        stringCopyN(bus->currentStop, currentStop, 50);
+        Bus bus;
+        stringCopyN(bus.busNo, busNo, 20);
+        stringCopyN(bus.company, company, 100);
+        stringCopyN(bus.currentStop, currentStop, 50);
         
-        busTable->insert(busNo, bus);
+        busTable->insert(busNo, std::move(bus));
         busCount++;
         
         // Bus added (quiet mode)
     }
     
+    // TransportSystem::routePositionOf(bus)
+    // Time: Average O(1)
+    // Space: O(1)
+    // the bus's position on its route: the tracked one while it still matches
+    // currentStop, otherwise the first visit of currentStop (-1 = not on the route)
+    int routePositionOf(const Bus& bus) {
+        int current = stopGraph->indexOf(bus.currentStop);
+        if (bus.routePosition != -1 && bus.route.stopAt(bus.routePosition) == current) {
+            return bus.routePosition;
+        }
+        return bus.route.positionOf(current);
+    }
+    
     // add stop to bus route
+    // TransportSystem::addStopToRoute(busNo, stopID)
+    // Time: Average O(1) - hashed stop lookup, amortized append
+    // Space: O(1) amortized
     void addStopToRoute(const char* busNo, const char* stopID) {
-        Bus* bus = (Bus*)busTable->search(busNo);
-        if (bus == nullptr) {
-            cout << "Bus not found!" << endl;
+        int stop = stopGraph->indexOf(stopID);
+        if (stop == -1) {
+            cout << "[ERROR] Stop " << stopID << " not found!" << endl;
             return;
         }
-        
-        bus->route->append(stopID);
+        if (!busTable->update(busNo, [stop](Bus& bus) { bus.route.append(stop); })) {
+            cout << "Bus not found!" << endl;
+        }
+    }
+    
+    // TransportSystem::isStopOnRoute(busNo, stopID)
+    // Time: O(1) once the stop is resolved
+    // Space: O(1)
+    bool isStopOnRoute(const char* busNo, const char* stopID) {
+        int stop = stopGraph->indexOf(stopID);
+        bool onRoute = false;
+        busTable->read(busNo, [&](const Bus& bus) {
+            onRoute = bus.route.contains(stop);
+        });
+        return onRoute;
+    }
+    
+    // print a route as stop names joined by separator
+    void printRoute(const BusRoute& route, const char* separator) {
+        for (int i = 0; i < route.getLength(); i++) {
+            cout << stopGraph->getVertexName(route.stopAt(i));
+            if (i < route.getLength() - 1) cout << separator;
+        }
+        cout << endl;
     }
     
     // get bus by number
+    // printed under the table's shared lock: a GPS update or route append on
+    // another thread waits until the record has been read
     void getBusDetails(const char* busNo) {
-        Bus* bus = (Bus*)busTable->search(busNo);
-        if (bus == nullptr) {
+        bool found = busTable->read(busNo, [&](const Bus& bus) {
+            cout << "\n--- Bus Details ---" << endl;
+            cout << "Bus Number: " << bus.busNo << endl;
+            cout << "Company: " << bus.company << endl;
+            cout << "Current Stop: " << bus.currentStop << endl;
+            cout << "Route: ";
+            printRoute(bus.route, " > ");
+        });
+        if (!found) {
             cout << "Bus not found!" << endl;
-            return;
+        }
+    }
+    
+    // TransportSystem::routeStops(from, to, path, pathLength)
+    // Time: O(alpha(V)) when the stops are in different components, else a
+    //       contraction hierarchy query while stopHierarchy matches the network,
+    //       otherwise a path trace in routeCache (one full search the first time a
+    //       source is seen)
+    // Space: O(1) - path points into the hierarchy workspace / route cache, valid
+    //        until the next route
+    // distance in km, GRAPH_MAX_DISTANCE (pathLength 0) if either stop is unknown or unreachable
+    double routeStops(const char* from, const char* to, const int*& path, int& pathLength) {
+        int fromIndex = stopGraph->indexOf(from);
+        int destIndex = stopGraph->indexOf(to);
+        path = nullptr;
+        pathLength = 0;
+        if (fromIndex == -1 || destIndex == -1) {
+            return GRAPH_MAX_DISTANCE;
         }
         
-        cout << "\n--- Bus Details ---" << endl;
-        cout << "Bus Number: " << bus->busNo << endl;
-        cout << "Company: " << bus->company << endl;
-        cout << "Current Stop: " << bus->currentStop << endl;
-        cout << "Route: ";
+        if (!stopGraph->connected(fromIndex, destIndex)) {
+            return GRAPH_MAX_DISTANCE;      // different components: nothing to search
+        }
         
-        Node* temp = bus->route->getHead();
-        while (temp != nullptr) {
-            cout << temp->data;
-            if (temp->next != nullptr) cout << " > ";
-            temp = temp->next;
+        double distance;
+        if (stopHierarchy != nullptr && stopHierarchy->isCurrentFor(*stopGraph)) {
+            distance = stopHierarchy->query(fromIndex, destIndex);
+            if (distance < GRAPH_MAX_DISTANCE) {
+                path = stopHierarchy->pathTo(pathLength);
+            }
+        } else {
+            distance = routeCache->route(fromIndex, destIndex, path, pathLength);
         }
-        cout << endl;
+        return distance;
     }
     
-    // find shortest path between two stops
-    void findShortestPath(const char* from, const char* to) {
-        int vertexCount = stopGraph->getVertexCount();
-        double* distances = new double[vertexCount];
-        int* previous = new int[vertexCount];
-        
-        stopGraph->dijkstra(from, distances, previous);
-        
-        // find destination index - CASE INSENSITIVE comparison
-        int destIndex = -1;
-        for (int i = 0; i < vertexCount; i++) {
-            char vertexName[50];
-            stringCopy(vertexName, stopGraph->getVertexName(i));
-            toUpperCase(vertexName);  // Normalize to uppercase for comparison
-            
-            char toUpper[50];
-            stringCopy(toUpper, to);
-            toUpperCase(toUpper);
-            
-            if (stringCompare(vertexName, toUpper) == 0) {
-                destIndex = i;
-                break;
+    // TransportSystem::findAlternates(from, to, primary, primaryLength, indices)
+    // Time: Graph::kShortestPaths for ALTERNATE_ROUTES + 1 routes - about two plain queries
+    // Space: O(1) - routeAlternatives is reused
+    // the next best loopless routes besides primary (what to send a vehicle down when
+    // the road ahead is blocked), cheapest first. indices[] receives their positions
+    // in routeAlternatives; returns how many there are (at most ALTERNATE_ROUTES)
+    int findAlternates(const char* from, const char* to, const int* primary, int primaryLength, int* indices) {
+        int routes = stopGraph->kShortestPaths(from, to, ALTERNATE_ROUTES + 1, *routeAlternatives);
+        int count = 0;
+        for (int i = 0; i < routes && count < ALTERNATE_ROUTES; i++) {
+            int length = 0;
+            const int* route = routeAlternatives->path(i, length);
+            bool same = (length == primaryLength);
+            for (int j = 0; same && j < length; j++) {
+                same = (route[j] == primary[j]);
+            }
+            if (!same) {
+                indices[count++] = i;
             }
         }
+        return count;
+    }
+    
+    // find shortest path between two stops
+    // TransportSystem::findShortestPath(from, to)
+    // Time: see routeStops
+    // Space: O(1) - the path lives in a per-thread workspace
+    void findShortestPath(const char* from, const char* to) {
+        const int* path = nullptr;
+        int pathLength = 0;
+        double distance = routeStops(from, to, path, pathLength);
         
-        if (destIndex == -1 || distances[destIndex] >= GRAPH_MAX_DISTANCE) {
+        if (distance >= GRAPH_MAX_DISTANCE) {
             cout << "\n[ERROR] No path exists between these stops!" << endl;
             cout << "[TIP] The stops might not be connected. Use 'Display Route Network' to see connections." << endl;
-            delete[] distances;
-            delete[] previous;
             return;
         }
         
-        // get path
-        int path[100];
-        int pathLength = 0;
-        stopGraph->getPath(previous, destIndex, path, pathLength);
-        
         // making sure Check if path is valid
         if (pathLength == 0) {
             cout << "\n[ERROR] No path found between these stops!" << endl;
             cout << "[TIP] Make sure both stops are connected to the route network." << endl;
-            delete[] distances;
-            delete[] previous;
             return;
         }
         
         cout << "\n--- Shortest Path ---" << endl;
         cout << "From: " << from << " To: " << to << endl;
-        cout << "Distance: " << distances[destIndex] << " km" << endl;
+        cout << "Distance: " << distance << " km" << endl;
         cout << "Path: ";
         
         for (int i = 0; i < pathLength; i++) {
@@ -285,15 +497,22 @@ public:
             if (i < pathLength - 1) cout << " -> ";
         }
         cout << endl;
-        
-        delete[] distances;
-        delete[] previous;
     }
     
     // update bus location
     void updateBusLocation(const char* busNo, const char* newStop) {
-        Bus* bus = (Bus*)busTable->search(busNo);
-        if (bus == nullptr) {
+        int stop = stopGraph->indexOf(newStop);
+        // swap the stop under the shard's write lock so readers never see half a name
+        char previousStop[50];
+        bool found = busTable->update(busNo, [&](Bus& bus) {
+            // the bus is on the next visit of the new stop from where it was, so a
+            // route that comes back to a stop keeps going instead of restarting
+            int from = routePositionOf(bus);
+            bus.routePosition = bus.route.positionAfter(stop, from != -1 ? from : 0);
+            stringCopy(previousStop, bus.currentStop);
+            stringCopyN(bus.currentStop, newStop, 50);
+        });
+        if (!found) {
             cout << "Bus not found!" << endl;
             return;
         }
@@ -302,14 +521,38 @@ public:
         char historyEntry[100];
         stringCopy(historyEntry, busNo);
         stringConcat(historyEntry, " at ");
-        stringConcat(historyEntry, bus->currentStop);
+        stringConcat(historyEntry, previousStop);
         routeHistory->push(historyEntry);
         
-        // update current stop
-        stringCopyN(bus->currentStop, newStop, 50);
         cout << "Updated bus " << busNo << " location to " << newStop << endl;
     }
     
+    // TransportSystem::postBusLocation(busNo, newStop)
+    // Time: O(1) - lock-free hand-off, no table is touched here
+    // Space: O(1)
+    // safe to call from any number of GPS feed threads; the report waits in the
+    // feed until applyGpsUpdates runs, and is never dropped
+    void postBusLocation(const char* busNo, const char* newStop) {
+        BusGpsUpdate update;
+        stringCopyN(update.busNo, busNo, 20);
+        stringCopyN(update.stopID, newStop, 50);
+        gpsFeed->push(std::move(update));
+    }
+    
+    // TransportSystem::applyGpsUpdates()
+    // Time: O(u) where u = reports waiting in the feed
+    // Space: O(1)
+    // drains the feed in arrival order; returns how many reports were applied
+    int applyGpsUpdates() {
+        BusGpsUpdate update;
+        int applied = 0;
+        while (gpsFeed->tryPop(update)) {
+            updateBusLocation(update.busNo, update.stopID);
+            applied++;
+        }
+        return applied;
+    }
+    
     
     // ========== MANUAL REGISTRATION METHODS ==========
     
@@ -364,8 +607,7 @@ public:
         normalizeInput(currentStop);
         
         // making sure Check if stop exists
-        BusStop* stop = (BusStop*)stopTable->search(currentStop);
-        if (stop == nullptr) {
+        if (!stopTable->contains(currentStop)) {
             cout << "\n[ERROR] Stop " << currentStop << " does not exist!" << endl;
             cout << "[TIP] Register the stop first using option [4], or check available stops." << endl;
             return;
@@ -400,8 +642,7 @@ public:
             normalizeInput(stopID);
             
             // making sure Check if each route stop exists
-            BusStop* routeStop = (BusStop*)stopTable->search(stopID);
-            if (routeStop == nullptr) {
+            if (!stopTable->contains(stopID)) {
                 cout << "[WARNING] Stop " << stopID << " not found - skipping!" << endl;
                 continue;
             }
@@ -420,41 +661,59 @@ public:
         cin >> busNo;
         normalizeInput(busNo);
         
-        Bus* bus = (Bus*)busTable->search(busNo);
-        if (bus == nullptr) {
-            cout << "[ERROR] Bus not found!" << endl;
-            return;
-        }
-        
-        cout << "\n--- Bus Location Info ---" << endl;
-        cout << "Bus: " << bus->busNo << " (" << bus->company << ")" << endl;
-        cout << "Current Stop: " << bus->currentStop << endl;
-        
-        // Show route
-        if (bus->route != nullptr && bus->route->getSize() > 0) {
-            cout << "Full Route: ";
-            bus->route->display();
+        // read under the table's shared lock, like getBusDetails
+        bool found = busTable->read(busNo, [&](const Bus& bus) {
+            cout << "\n--- Bus Location Info ---" << endl;
+            cout << "Bus: " << bus.busNo << " (" << bus.company << ")" << endl;
+            cout << "Current Stop: " << bus.currentStop << endl;
             
-            // Predict next stop - CASE INSENSITIVE
-            Node* current = bus->route->getHead();
-            while (current != nullptr) {
-                char routeStop[50], currentStop[50];
-                stringCopy(routeStop, current->data);
-                stringCopy(currentStop, bus->currentStop);
-                toUpperCase(routeStop);
-                toUpperCase(currentStop);
+            // Show route
+            if (!bus.route.isEmpty()) {
+                cout << "Full Route: ";
+                printRoute(bus.route, " -> ");
                 
-                if (stringCompare(routeStop, currentStop) == 0) {
-                    if (current->next != nullptr) {
-                        cout << "Next Stop: " << current->next->data << endl;
+                // Predict next stop from the bus's position on the route, not from
+                // the stop's first visit (routes may pass a stop more than once)
+                int position = routePositionOf(bus);
+                if (position != -1) {
+                    int next = bus.route.stopAt(position + 1);
+                    if (next != -1) {
+                        cout << "Next Stop: " << stopGraph->getVertexName(next) << endl;
                     } else {
                         cout << "Next Stop: End of route" << endl;
                     }
-                    break;
+                    cout << "Stops Remaining: " << bus.route.stopsRemaining(position) << endl;
                 }
-                current = current->next;
             }
+        });
+        if (!found) {
+            cout << "[ERROR] Bus not found!" << endl;
+        }
+    }
+    
+    // TransportSystem::showStopsWithin(stopID, budgetKm, towardStop)
+    // Time: O((R + E_R) log R) where R = stops within budgetKm - the search stops at the budget
+    // Space: O(1) extra (the graph's per-thread workspace)
+    // isochrone around a stop: every stop within budgetKm of network distance from it,
+    // or with towardStop every stop that can reach it within budgetKm
+    void showStopsWithin(const char* stopID, double budgetKm, bool towardStop) {
+        BusStop center;
+        if (!getStop(stopID, center)) {
+            cout << "\n[ERROR] Stop " << stopID << " does not exist!" << endl;
+            return;
+        }
+        int count = 0;
+        const int* reached = stopGraph->reachableWithin(stopID, budgetKm, count, towardStop);
+        
+        cout << "\n--- Stops " << (towardStop ? "that can reach " : "reachable from ") << center.name
+             << " within " << budgetKm << " km ---" << endl;
+        for (int i = 0; i < count; i++) {
+            const char* id = stopGraph->getVertexName(reached[i]);
+            BusStop stop;
+            cout << "  " << id << " (" << (getStop(id, stop) ? stop.name : "?") << "): "
+                 << stopGraph->distanceTo(reached[i]) << " km" << endl;
         }
+        cout << "Total: " << count << " stop(s) (network has " << stopCount << ")" << endl;
     }
     
     // finding nearest bus to user location
@@ -466,14 +725,8 @@ public:
         cout << "Enter your longitude: ";
         cin >> userLon;
         
-        // Get all buses
-        char** busKeys = new char*[100];
-        int busCount;
-        busTable->getAllKeys(busKeys, &busCount);
-        
-        if (busCount == 0) {
+        if (busTable->isEmpty()) {
             cout << "[INFO] No buses registered yet." << endl;
-            delete[] busKeys;
             return;
         }
         
@@ -481,28 +734,23 @@ public:
         char nearestBus[20] = "";
         char nearestStop[100] = "";
         
-        // finding nearest
-        for (int i = 0; i < busCount; i++) {
-            Bus* bus = (Bus*)busTable->search(busKeys[i]);
-            if (bus != nullptr) {
-                BusStop* stop = (BusStop*)stopTable->search(bus->currentStop);
-                
-                // making sure Skip if stop doesn't exist
-                if (stop == nullptr) {
-                    continue;  // Bus has invalid location
-                }
-                
-                double dist = calculateDistance(userLat, userLon, 
-                                               stop->latitude, stop->longitude);
-                if (dist < minDistance) {
-                    minDistance = dist;
-                    stringCopy(nearestBus, bus->busNo);
-                    stringCopy(nearestStop, stop->name);
-                }
+        // finding nearest (one pass over the bus records, no key array)
+        busTable->forEach([&](const StringView&, Bus& bus) {
+            BusStop stop;
+            
+            // making sure Skip if stop doesn't exist
+            if (!getStop(bus.currentStop, stop)) {
+                return;  // Bus has invalid location
             }
-        }
-        
-        delete[] busKeys;
+            
+            double dist = calculateDistance(userLat, userLon, 
+                                           stop.latitude, stop.longitude);
+            if (dist < minDistance) {
+                minDistance = dist;
+                stringCopy(nearestBus, bus.busNo);
+                stringCopy(nearestStop, stop.name);
+            }
+        });
         
         if (nearestBus[0] != '\0') {
             cout << "\n--- Nearest Bus Found ---" << endl;
@@ -522,15 +770,15 @@ public:
         int vertexCount = stopGraph->getVertexCount();
         for (int i = 0; i < vertexCount; i++) {
             const char* stopID = stopGraph->getVertexName(i);
-            BusStop* stop = (BusStop*)stopTable->search(stopID);
+            BusStop stop;
             
-            if (stop != nullptr) {
+            if (getStop(stopID, stop)) {
                 // Show: ID - Name [Sector] (lat, lon)
-                cout << stopID << " - " << stop->name;
-                if (stop->sector[0] != '\0') {  // Show sector if available
-                    cout << " [" << stop->sector << "]";
+                cout << stopID << " - " << stop.name;
+                if (stop.sectorId != NO_SECTOR) {  // Show sector if available
+                    cout << " [" << sectorName(stop.sectorId) << "]";
                 }
-                cout << " (" << stop->latitude << ", " << stop->longitude << ")";
+                cout << " (" << stop.latitude << ", " << stop.longitude << ")";
             } else {
                 // Fallback
                 cout << stopID;
@@ -550,23 +798,22 @@ public:
         cout << "\n========== ALL REGISTERED BUSES ==========" << endl;
         cout << "Total Buses: " << busCount << endl;
         
-        char** busKeys = new char*[100];
-        int count;
-        busTable->getAllKeys(busKeys, &count);
+        int count = busTable->getCount();
         
         if (count == 0) {
             cout << "\n[INFO] No buses registered yet." << endl;
         } else {
             cout << "\nNote: To see specific bus details, use 'Get Bus Details' option" << endl;
             cout << "Available buses: ";
-            for (int i = 0; i < count; i++) {
-                cout << busKeys[i];
+            int i = 0;
+            busTable->forEach([&](const StringView& id, Bus&) {
+                cout << id.data;
                 if (i < count - 1) cout << ", ";
-            }
+                i++;
+            });
             cout << endl;
         }
         
-        delete[] busKeys;
         cout << "==========================================" << endl;
     }
     
@@ -576,6 +823,8 @@ public:
         cout << "Total Bus Stops: " << stopCount << endl;
         cout << "Total Connections: " << routeEdgeCount << endl;
         cout << "Total Buses: " << busCount << endl;
+        stopGraph->displayComponents();
+        stopGraph->displayCriticalVertices(CRITICAL_SHOWN);
         cout << "\nDetailed stop connections:" << endl;
         stopGraph->display();
         cout << "==========================================" << endl;
@@ -584,18 +833,18 @@ public:
     // ========== BONUS FEATURES ==========
     
     // bonus feature 1: School Bus Tracking
-    HashTable* schoolBusTable = new HashTable(20);
+    HashMap<StringView, SchoolBus>* schoolBusTable = new HashMap<StringView, SchoolBus>(20);
     
     void registerSchoolBus(const char* busID, const char* schoolID) {
-        SchoolBus* sb = new SchoolBus();
-        stringCopyN(sb->busID, busID, 20);
-        stringCopyN(sb->schoolID, schoolID, 50);
-        schoolBusTable->insert(busID, sb);
+        SchoolBus sb(arena);
+        stringCopyN(sb.busID, busID, 20);
+        stringCopyN(sb.schoolID, schoolID, 50);
+        schoolBusTable->insert(busID, std::move(sb));
         cout << "Registered school bus: " << busID << " for school " << schoolID << endl;
     }
     
     void addSchoolBusStop(const char* busID, const char* stopName) {
-        SchoolBus* sb = (SchoolBus*)schoolBusTable->search(busID);
+        SchoolBus* sb = schoolBusTable->search(busID);
         if (sb == nullptr) {
             cout << "School bus not found!" << endl;
             return;
@@ -605,7 +854,7 @@ public:
     }
     
     void trackSchoolBus(const char* busID, const char* currentLocation) {
-        SchoolBus* sb = (SchoolBus*)schoolBusTable->search(busID);
+        SchoolBus* sb = schoolBusTable->search(busID);
         if (sb == nullptr) {
             cout << "School bus not found!" << endl;
             return;
@@ -622,7 +871,7 @@ public:
     }
     
     void pickupStudent(const char* busID) {
-        SchoolBus* sb = (SchoolBus*)schoolBusTable->search(busID);
+        SchoolBus* sb = schoolBusTable->search(busID);
         if (sb == nullptr) {
             cout << "School bus not found!" << endl;
             return;
@@ -636,17 +885,8 @@ public:
     }
     
     // [NOTE] Airport and Railway systems are now in separate header files
-    // AirportSector.h and RailwaySector.h
-    
-    void connectAirportToBusStop(const char* airportCode, const char* stopID, double distance) {
-        stopGraph->addBidirectionalEdge(airportCode, stopID, distance);
-        cout << "Connected airport " << airportCode << " to bus stop " << stopID << endl;
-    }
-    
-    void connectRailToBusStop(const char* stationID, const char* stopID, double distance) {
-        stopGraph->addBidirectionalEdge(stationID, stopID, distance);
-        cout << "Connected rail station " << stationID << " to bus stop " << stopID << endl;
-    }
+    // AirportSector.h and RailwaySector.h; links between bus stops, stations and
+    // airports live in MultimodalNetwork.h
     
     // bonus feature 3: Real-time Route Simulation
     int simulationStep = 0;
@@ -668,9 +908,10 @@ public:
         simulationStep++;
         cout << "\n--- Simulation Step " << simulationStep << " ---" << endl;
         
-        // simulate all buses moving one step
+        // every step applies the GPS reports that arrived since the last one
         cout << "Simulating bus movements..." << endl;
-        cout << "(In full implementation, buses would move to next stop)" << endl;
+        int applied = applyGpsUpdates();
+        cout << "GPS updates applied: " << applied << endl;
         cout << "Current step: " << simulationStep << endl;
     }
     
@@ -691,85 +932,267 @@ public:
     }
     
     // bonus feature 4: Emergency Transport Routing
-    HashTable* emergencyTable = new HashTable(20);
-    MinHeap* emergencyQueue = new MinHeap(20);
+    HashMap<StringView, EmergencyVehicle>* emergencyTable = new HashMap<StringView, EmergencyVehicle>(20);
+    IndexedHeap<EmergencyVehicle*, int, HigherFirst<int> >* emergencyQueue =
+        new IndexedHeap<EmergencyVehicle*, int, HigherFirst<int> >(20);
+    // dispatchNearest scratch: one seed per stop holding an idle vehicle of the type
+    int* dispatchSeeds = nullptr;
+    EmergencyVehicle** seedHolder = nullptr;    // stop index -> idle vehicle standing there
+    int seedCapacity = 0;
     
-    void registerEmergencyVehicle(const char* vehicleID, const char* type,
+    // TransportSystem::registerEmergencyVehicle(vehicleID, type, currentLocation, priority)
+    // Time: Average O(1)
+    // Space: O(1)
+    // a registered ID is rejected rather than overwritten: the record may sit in
+    // the emergency queue, and its handle must keep pointing at a live vehicle
+    bool registerEmergencyVehicle(const char* vehicleID, const char* type,
                                   const char* currentLocation, int priority) {
-        EmergencyVehicle* ev = new EmergencyVehicle();
+        EmergencyVehicle* ev = emergencyTable->emplace(vehicleID);
+        if (ev == nullptr) {
+            cout << "[ERROR] Emergency vehicle " << vehicleID << " is already registered!" << endl;
+            return false;
+        }
         stringCopyN(ev->vehicleID, vehicleID, 20);
         stringCopyN(ev->type, type, 50);
         stringCopyN(ev->currentLocation, currentLocation, 50);
         ev->priority = priority;
         ev->active = false;
         
-        emergencyTable->insert(vehicleID, ev);
         cout << "Registered emergency vehicle: " << vehicleID << " (" << type << ")" << endl;
+        return true;
     }
     
     void dispatchEmergency(const char* vehicleID, const char* destination) {
-        EmergencyVehicle* ev = (EmergencyVehicle*)emergencyTable->search(vehicleID);
+        EmergencyVehicle* ev = emergencyTable->search(vehicleID);
         if (ev == nullptr) {
             cout << "Emergency vehicle not found!" << endl;
             return;
         }
         
+        activateEmergency(ev, destination);
+        
+        // find emergency route
+        findEmergencyRoute(ev->currentLocation, ev->destination, ev->priority);
+    }
+    
+    // TransportSystem::nearestIdle(type, target, distance, seeds)
+    // Time: O(F) to seed the idle fleet + one Graph::nearestSource search. vehicles
+    //       standing at the same stop share a seed, so the search does not grow with
+    //       the fleet - it only reaches out as far as the nearest idle vehicle
+    // Space: O(1) - the seed arrays are reused between calls
+    // the idle vehicle of the given type (case-insensitive) with the shortest road
+    // distance to stop target, nullptr if none reaches it; stopGraph->pathTo(target)
+    // then holds its route. seeds = stops that had an idle vehicle of the type
+    EmergencyVehicle* nearestIdle(const char* type, int target, double& distance, int& seeds) {
+        int vertices = stopGraph->getVertexCount();
+        if (vertices > seedCapacity) {
+            delete[] dispatchSeeds;
+            delete[] seedHolder;
+            seedCapacity = vertices;
+            dispatchSeeds = new int[seedCapacity];
+            seedHolder = new EmergencyVehicle*[seedCapacity];
+            for (int i = 0; i < seedCapacity; i++) {
+                seedHolder[i] = nullptr;
+            }
+        }
+        
+        seeds = 0;
+        for (auto& entry : *emergencyTable) {
+            EmergencyVehicle* ev = &entry.value;
+            if (ev->active || stringCompareIgnoreCase(ev->type, type) != 0) {
+                continue;
+            }
+            if (ev->locationIndex == -1) {
+                ev->locationIndex = stopGraph->indexOf(ev->currentLocation);
+                if (ev->locationIndex == -1) {
+                    continue;
+                }
+            }
+            int stop = ev->locationIndex;
+            // the highest priority vehicle at a stop answers for it
+            if (seedHolder[stop] == nullptr) {
+                dispatchSeeds[seeds++] = stop;
+                seedHolder[stop] = ev;
+            } else if (ev->priority > seedHolder[stop]->priority) {
+                seedHolder[stop] = ev;
+            }
+        }
+        
+        distance = GRAPH_MAX_DISTANCE;
+        int origin = stopGraph->nearestSource(dispatchSeeds, seeds, target, distance);
+        EmergencyVehicle* chosen = origin != -1 ? seedHolder[origin] : nullptr;
+        for (int i = 0; i < seeds; i++) {
+            seedHolder[dispatchSeeds[i]] = nullptr;
+        }
+        return chosen;
+    }
+    
+    // TransportSystem::dispatchNearest(type, destination)
+    // Time: nearestIdle + O(L) to print the route
+    // Space: O(1)
+    // sends the idle vehicle of the given type closest to destination, routed by the
+    // same search that picked it. returns the vehicle, nullptr if none can reach destination
+    EmergencyVehicle* dispatchNearest(const char* type, const char* destination) {
+        int target = stopGraph->indexOf(destination);
+        if (target == -1) {
+            cout << "[ERROR] Destination stop not found!" << endl;
+            return nullptr;
+        }
+        double distance = GRAPH_MAX_DISTANCE;
+        int seeds = 0;
+        EmergencyVehicle* chosen = nearestIdle(type, target, distance, seeds);
+        if (chosen == nullptr) {
+            cout << "[ERROR] No idle " << type << " can reach " << destination << "!" << endl;
+            return nullptr;
+        }
+        
+        int pathLength = 0;
+        const int* path = stopGraph->pathTo(target, pathLength);
+        cout << "\n[OK] Nearest idle " << type << " out of " << seeds << " stop(s) with one: "
+             << chosen->vehicleID << endl;
+        activateEmergency(chosen, destination);
+        cout << "\n--- EMERGENCY ROUTE (Priority " << chosen->priority << ") ---" << endl;
+        printEmergencyRoute(chosen->currentLocation, destination, path, pathLength, distance);
+        return chosen;
+    }
+    
+    // bonus feature: nearest-vehicle dispatch cost as the fleet grows
+    // TransportSystem::benchmarkDispatchNearest()
+    // Time: O(sizes * QUERIES * (F + one search)) for nearestIdle, O(F) searches per
+    //       query for the one-route-per-vehicle baseline
+    // Space: O(F) temporary vehicles, removed again before returning
+    // the test fleet uses its own type, so real vehicles are never picked or moved
+    void benchmarkDispatchNearest() {
+        const int QUERIES = 200;
+        const int FLEET_SIZES[] = { 50, 100, 200, 400, 800 };
+        const int SIZE_COUNT = 5;
+        const int MAX_FLEET = 800;
+        const char* TEST_TYPE = "BenchUnit";
+        int n = stopGraph->getVertexCount();
+        
+        cout << "\n========== NEAREST VEHICLE DISPATCH vs FLEET SIZE ==========" << endl;
+        if (n < 2) {
+            cout << "[ERROR] Need at least two bus stops!" << endl;
+            return;
+        }
+        cout << "Network: " << n << " stops, " << QUERIES << " dispatch queries per fleet size" << endl;
+        cout << "------------------------------------------------------------" << endl;
+        cout << "  fleet   one multi-source search   one route per vehicle" << endl;
+        
+        char vehicleID[20];
+        int* added = new int[MAX_FLEET];     // ID suffixes this run registered
+        int registered = 0;
+        int nextSuffix = 0;
+        unsigned int seed = 4242;
+        bool same = true;
+        for (int s = 0; s < SIZE_COUNT; s++) {
+            // grow the test fleet, parked on pseudo-random stops
+            while (registered < FLEET_SIZES[s]) {
+                snprintf(vehicleID, sizeof(vehicleID), "BENCH-%d", nextSuffix);
+                EmergencyVehicle* ev = emergencyTable->emplace(vehicleID);
+                if (ev == nullptr) {
+                    nextSuffix++;       // a real vehicle already uses this ID
+                    continue;
+                }
+                added[registered] = nextSuffix++;
+                seed = seed * 1103515245u + 12345u;
+                int stop = (int)((seed >> 8) % (unsigned int)n);
+                stringCopyN(ev->vehicleID, vehicleID, 20);
+                stringCopyN(ev->type, TEST_TYPE, 50);
+                stringCopyN(ev->currentLocation, stopGraph->getVertexName(stop), 50);
+                ev->locationIndex = stop;
+                ev->priority = 5;
+                registered++;
+            }
+            
+            double distance = 0;
+            int seeds = 0;
+            double* nearest = new double[QUERIES];
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (int q = 0; q < QUERIES; q++) {
+                nearestIdle(TEST_TYPE, q % n, distance, seeds);
+                nearest[q] = distance;
+            }
+            double searchMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / QUERIES;
+            
+            // baseline: route every idle vehicle to the target and keep the shortest
+            start = std::chrono::steady_clock::now();
+            for (int q = 0; q < QUERIES; q++) {
+                double best = GRAPH_MAX_DISTANCE;
+                for (auto& entry : *emergencyTable) {
+                    EmergencyVehicle& ev = entry.value;
+                    if (ev.active || stringCompareIgnoreCase(ev.type, TEST_TYPE) != 0) {
+                        continue;
+                    }
+                    double d = stopGraph->findRoute(ev.locationIndex, q % n);
+                    if (d < best) best = d;
+                }
+                double gap = best - nearest[q];
+                if (gap > 1e-6 || gap < -1e-6) same = false;
+            }
+            double baselineMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / QUERIES;
+            delete[] nearest;
+            
+            cout << "  " << setw(5) << registered << "   " << setw(14) << searchMicros << " us/query"
+                 << "   " << setw(12) << baselineMicros << " us/query" << endl;
+        }
+        
+        for (int i = 0; i < registered; i++) {
+            snprintf(vehicleID, sizeof(vehicleID), "BENCH-%d", added[i]);
+            emergencyTable->remove(vehicleID);
+        }
+        delete[] added;
+        cout << "------------------------------------------------------------" << endl;
+        cout << (same ? "[OK] Both methods pick the same distance every time"
+                      : "[ERROR] Distance mismatch!") << endl;
+        cout << "(left: one O(F) seeding scan + a single search; right: F searches)" << endl;
+        cout << "Test fleet removed (" << registered << " vehicles)" << endl;
+        cout << "============================================================" << endl;
+    }
+    
+    // TransportSystem::activateEmergency(ev, destination)
+    // Time: O(log n) - queue push or priority update
+    // Space: O(1)
+    void activateEmergency(EmergencyVehicle* ev, const char* destination) {
         stringCopyN(ev->destination, destination, 50);
         ev->active = true;
         
-        // add to priority queue (higher priority = lower value in min-heap)
-        emergencyQueue->insert(ev, -ev->priority);
+        // queue it once; a re-dispatch only refreshes its place in the queue
+        if (emergencyQueue->contains(ev->queueHandle)) {
+            emergencyQueue->update(ev->queueHandle, ev->priority);
+        } else {
+            ev->queueHandle = emergencyQueue->push(ev, ev->priority);
+        }
         
         cout << "\n*** EMERGENCY DISPATCH ***" << endl;
         cout << "Vehicle: " << ev->vehicleID << " (" << ev->type << ")" << endl;
         cout << "Priority: " << ev->priority << "/10" << endl;
         cout << "From: " << ev->currentLocation << endl;
         cout << "To: " << ev->destination << endl;
-        
-        // find emergency route
-        findEmergencyRoute(ev->currentLocation, ev->destination, ev->priority);
     }
     
     void findEmergencyRoute(const char* from, const char* to, int priority) {
         cout << "\n--- EMERGENCY ROUTE (Priority " << priority << ") ---" << endl;
         
-        // use existing dijkstra but mark it as emergency
-        int vertexCount = stopGraph->getVertexCount();
-        double* distances = new double[vertexCount];
-        int* previous = new int[vertexCount];
-        
-        stopGraph->dijkstra(from, distances, previous);
-        
-        // CASE INSENSITIVE destination lookup
-        int destIndex = -1;
-        for (int i = 0; i < vertexCount; i++) {
-            char vertexName[50];
-            stringCopy(vertexName, stopGraph->getVertexName(i));
-            toUpperCase(vertexName);
-            
-            char toUpper[50];
-            stringCopy(toUpper, to);
-            toUpperCase(toUpper);
-            
-            if (stringCompare(vertexName, toUpper) == 0) {
-                destIndex = i;
-                break;
-            }
-        }
+        // same search as regular routing, nothing allocated per dispatch
+        const int* path = nullptr;
+        int pathLength = 0;
+        double distance = routeStops(from, to, path, pathLength);
         
-        if (destIndex == -1 || distances[destIndex] == GRAPH_MAX_DISTANCE) {
+        if (distance >= GRAPH_MAX_DISTANCE) {
             cout << "No route found!" << endl;
-            delete[] distances;
-            delete[] previous;
             return;
         }
-        
-        int path[100];
-        int pathLength = 0;
-        stopGraph->getPath(previous, destIndex, path, pathLength);
-        
+        printEmergencyRoute(from, to, path, pathLength, distance);
+    }
+    
+    // TransportSystem::printEmergencyRoute(from, to, path, pathLength, distance)
+    // Time: O(L) + findAlternates
+    // Space: O(1)
+    void printEmergencyRoute(const char* from, const char* to, const int* path, int pathLength,
+                             double distance) {
         cout << "*** EMERGENCY ROUTE ***" << endl;
-        cout << "Distance: " << distances[destIndex] << " km" << endl;
+        cout << "Distance: " << distance << " km" << endl;
         cout << "Path: ";
         
         for (int i = 0; i < pathLength; i++) {
@@ -777,10 +1200,25 @@ public:
             if (i < pathLength - 1) cout << " -> ";
         }
         cout << endl;
-        cout << "!!! CLEAR THE ROUTE - EMERGENCY VEHICLE APPROACHING !!!" << endl;
         
-        delete[] distances;
-        delete[] previous;
+        // fallbacks in case the route is blocked on the way
+        int alternates[ALTERNATE_ROUTES];
+        int alternateCount = findAlternates(from, to, path, pathLength, alternates);
+        if (alternateCount > 0) {
+            cout << "Alternates if blocked:" << endl;
+            for (int a = 0; a < alternateCount; a++) {
+                int length = 0;
+                const int* route = routeAlternatives->path(alternates[a], length);
+                double cost = routeAlternatives->cost(alternates[a]);
+                cout << "  [" << (a + 1) << "] " << cost << " km (+" << cost - distance << "): ";
+                for (int i = 0; i < length; i++) {
+                    cout << stopGraph->getVertexName(route[i]);
+                    if (i < length - 1) cout << " -> ";
+                }
+                cout << endl;
+            }
+        }
+        cout << "!!! CLEAR THE ROUTE - EMERGENCY VEHICLE APPROACHING !!!" << endl;
     }
     
     void showActiveEmergencies() {
@@ -789,29 +1227,58 @@ public:
             cout << "No active emergencies" << endl;
         } else {
             cout << "Emergency vehicles in queue (by priority)" << endl;
-            cout << "(Full implementation would display all from heap)" << endl;
+            
+            // heap storage is not sorted, so drain a scratch copy in priority order
+            IndexedHeap<EmergencyVehicle*, int, HigherFirst<int> > ordered(emergencyQueue->size());
+            emergencyQueue->forEach([&ordered](EmergencyVehicle* ev, int priority) {
+                ordered.push(ev, priority);
+            });
+            int rank = 1;
+            while (!ordered.isEmpty()) {
+                EmergencyVehicle* ev = ordered.pop();
+                cout << rank << ". " << ev->vehicleID << " (" << ev->type << ")"
+                     << " - Priority " << ev->priority << "/10"
+                     << " - To: " << ev->destination << endl;
+                rank++;
+            }
+        }
+    }
+    
+    // TransportSystem::completeEmergency(vehicleID)
+    // Time: O(log n) - removed from the queue through its handle, no search
+    // Space: O(1)
+    // the vehicle is left standing at its destination, idle again
+    bool completeEmergency(const char* vehicleID) {
+        EmergencyVehicle* ev = emergencyTable->search(vehicleID);
+        if (ev == nullptr || !emergencyQueue->remove(ev->queueHandle)) {
+            return false;
         }
+        ev->queueHandle = NO_HEAP_HANDLE;
+        ev->active = false;
+        stringCopyN(ev->currentLocation, ev->destination, 50);
+        ev->locationIndex = -1;
+        return true;
     }
     
     // bonus feature: Simulate Passenger Queue/Boarding at a stop (using Circular Queue)
     void simulatePassengerBoarding(const char* stopID) {
-        BusStop* stop = (BusStop*)stopTable->search(stopID);
-        if (stop == nullptr) {
+        BusStop stop;
+        if (!getStop(stopID, stop)) {
             cout << "[ERROR] Stop not found!" << endl;
             return;
         }
         
         cout << "\n========== PASSENGER BOARDING SIMULATION ===========" << endl;
-        cout << "Location: " << stop->name << " (" << stopID << ")" << endl;
+        cout << "Location: " << stop.name << " (" << stopID << ")" << endl;
         cout << "====================================================\n" << endl;
         
         // Create a circular queue for passengers (simulated with passenger IDs)
-        Queue passengerQueue(20);
+        RingBuffer<int> passengerQueue(20);
         
         // Simulate passengers arriving at the stop
         cout << "-- Passengers arriving at stop --" << endl;
         for (int i = 1; i <= 8; i++) {
-            passengerQueue.enqueue(i);
+            passengerQueue.push(i);
             cout << "Passenger #" << i << " joined the queue" << endl;
         }
         
@@ -821,8 +1288,8 @@ public:
         int busCapacity = 5;
         int boarded = 0;
         
-        while (!passengerQueue.isEmpty() && boarded < busCapacity) {
-            int passenger = passengerQueue.dequeue();
+        int passenger;
+        while (boarded < busCapacity && passengerQueue.pop(passenger)) {
             cout << "Passenger #" << passenger << " boards the bus" << endl;
             boarded++;
         }
@@ -834,7 +1301,7 @@ public:
         if (!passengerQueue.isEmpty()) {
             cout << "\n[NOTE] " << passengerQueue.size() 
                  << " passenger(s) waiting for next bus" << endl;
-            cout << "Next passenger in queue: #" << passengerQueue.peek() << endl;
+            cout << "Next passenger in queue: #" << passengerQueue.front() << endl;
         }
         
         cout << "\n=====================================================" << endl;
@@ -842,16 +1309,575 @@ public:
         cout << "=====================================================" << endl;
     }
     
+    // TransportSystem::printEventRate(label, events, start)
+    // Time: O(1)
+    // Space: O(1)
+    void printEventRate(const char* label, long long events,
+                        std::chrono::steady_clock::time_point start) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds <= 0.0) {
+            seconds = 1e-9;
+        }
+        cout << "  " << label;
+        for (int k = stringLength(label); k < 34; k++) cout << " ";
+        cout << ": " << (long long)(events / seconds) << " events/sec" << endl;
+    }
+    
+    // one "label : N ms" line of a timing table
+    void printTiming(const char* label, double millis) {
+        cout << "  " << label;
+        for (int k = stringLength(label); k < 34; k++) cout << " ";
+        cout << ": " << millis << " ms" << endl;
+    }
+    
+    // bonus feature: event queue throughput (old Queue vs ring buffers)
+    // TransportSystem::benchmarkEventQueues()
+    // Time: O(EVENTS) per queue
+    // Space: O(1) - every queue is bounded or reused
+    void benchmarkEventQueues() {
+        const int EVENTS = 1000000;
+        const int BATCH = 64;     // events queued before the consumer catches up
+        
+        cout << "\n========== EVENT QUEUE THROUGHPUT ==========" << endl;
+        cout << "Events per run: " << EVENTS << endl;
+        cout << "--------------------------------------------" << endl;
+        
+        // single thread: fill a batch, drain it, repeat
+        long long checksum = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Queue oldQueue(100);
+        for (int i = 0; i < EVENTS; i += BATCH) {
+            for (int j = 0; j < BATCH; j++) oldQueue.enqueue(i + j);
+            while (!oldQueue.isEmpty()) checksum += oldQueue.dequeue();
+        }
+        printEventRate("Queue (int, % wraparound)", EVENTS, start);
+        
+        long long ringChecksum = 0;
+        start = std::chrono::steady_clock::now();
+        RingBuffer<int> ring(100);
+        int value;
+        for (int i = 0; i < EVENTS; i += BATCH) {
+            for (int j = 0; j < BATCH; j++) ring.push(i + j);
+            while (ring.pop(value)) ringChecksum += value;
+        }
+        printEventRate("RingBuffer (single thread)", EVENTS, start);
+        
+        bool allMatch = true;
+#ifdef ISB_NO_THREADS
+        cout << "  (SPSC / MPMC runs need threads, skipped in this build)" << endl;
+#else
+        // one producer thread, the caller consumes
+        long long spscChecksum = 0;
+        start = std::chrono::steady_clock::now();
+        SpscRingBuffer<int> spsc(1024);
+        std::thread producer([&spsc, EVENTS]() {
+            for (int i = 0; i < EVENTS; i++) spsc.push(i);
+        });
+        for (int received = 0; received < EVENTS; ) {
+            if (spsc.tryPop(value)) {
+                spscChecksum += value;
+                received++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        printEventRate("SpscRingBuffer (1 -> 1 threads)", EVENTS, start);
+        
+        // half the threads produce, half consume
+        int side = hardwareThreads() / 2;
+        if (side < 2) side = 2;
+        std::atomic<long long> mpmcChecksum(0);
+        std::atomic<int> consumed(0);
+        start = std::chrono::steady_clock::now();
+        MpmcRingBuffer<int> mpmc(1024);
+        runParallel(side * 2, [&mpmc, &mpmcChecksum, &consumed, side, EVENTS](int part) {
+            if (part < side) {
+                for (int i = EVENTS * part / side; i < EVENTS * (part + 1) / side; i++) mpmc.push(i);
+                return;
+            }
+            long long localSum = 0;
+            int item;
+            while (consumed.load(std::memory_order_relaxed) < EVENTS) {
+                if (mpmc.tryPop(item)) {
+                    localSum += item;
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            mpmcChecksum += localSum;
+        });
+        char mpmcLabel[50];
+        snprintf(mpmcLabel, sizeof(mpmcLabel), "MpmcRingBuffer (%d -> %d threads)", side, side);
+        printEventRate(mpmcLabel, EVENTS, start);
+        
+        allMatch = spscChecksum == checksum && mpmcChecksum.load() == checksum;
+#endif
+        cout << "--------------------------------------------" << endl;
+        if (ringChecksum == checksum && allMatch) {
+            cout << "[OK] Every queue delivered all " << EVENTS << " events" << endl;
+        } else {
+            cout << "[ERROR] Event checksum mismatch!" << endl;
+        }
+        cout << "============================================" << endl;
+    }
+    
+    // bonus feature: contraction hierarchy preprocessing + query timing
+    // TransportSystem::benchmarkRouteHierarchy()
+    // Time: one build (or file load) + O(QUERIES) route queries each way
+    // Space: O(V + E + shortcuts) for the hierarchy, kept for later routing
+    void benchmarkRouteHierarchy() {
+        const int QUERIES = 1000;
+        const char* CACHE_FILE = "SmartCity_dataset/stop_hierarchy.ch";
+        int n = stopGraph->getVertexCount();
+        
+        cout << "\n========== ROUTE PREPROCESSING (CONTRACTION HIERARCHY) ==========" << endl;
+        if (n < 2) {
+            cout << "[ERROR] Need at least two bus stops!" << endl;
+            return;
+        }
+        cout << "Network: " << n << " stops, " << stopGraph->getEdgeCount() << " directed edges" << endl;
+        
+        if (stopHierarchy == nullptr) {
+            stopHierarchy = new ContractionHierarchy();
+        }
+        if (!stopHierarchy->isCurrentFor(*stopGraph)) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            if (stopHierarchy->load(CACHE_FILE, *stopGraph)) {
+                double loadMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                cout << "Loaded saved hierarchy from " << CACHE_FILE << " in " << loadMillis << " ms" << endl;
+            } else {
+                stopHierarchy->build(*stopGraph);
+                cout << "Preprocessing time: " << stopHierarchy->getBuildMillis() << " ms" << endl;
+                if (stopHierarchy->save(CACHE_FILE)) {
+                    cout << "Saved hierarchy to " << CACHE_FILE << endl;
+                } else {
+                    cout << "[WARNING] Could not save hierarchy to " << CACHE_FILE << endl;
+                }
+            }
+        } else {
+            cout << "Hierarchy already up to date (built in " << stopHierarchy->getBuildMillis() << " ms)" << endl;
+        }
+        cout << "Shortcuts added: " << stopHierarchy->getShortcutCount()
+             << " (on top of " << stopHierarchy->getOriginalArcCount() << " edges)" << endl;
+        cout << "Memory overhead: " << stopHierarchy->getMemoryBytes() / 1024.0 << " KB" << endl;
+        
+        // same pseudo-random stop pairs for both searches
+        int* sources = new int[QUERIES];
+        int* targets = new int[QUERIES];
+        unsigned int seed = 12345;
+        for (int i = 0; i < QUERIES; i++) {
+            seed = seed * 1103515245u + 12345u;
+            sources[i] = (int)((seed >> 8) % (unsigned int)n);
+            seed = seed * 1103515245u + 12345u;
+            targets[i] = (int)((seed >> 8) % (unsigned int)n);
+        }
+        double* expected = new double[QUERIES];
+        
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < QUERIES; i++) {
+            expected[i] = stopGraph->findRoute(sources[i], targets[i]);
+        }
+        double plainMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        
+        int mismatches = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < QUERIES; i++) {
+            double distance = stopHierarchy->query(sources[i], targets[i]);
+            double gap = distance - expected[i];
+            if (gap > 1e-6 || gap < -1e-6) {
+                mismatches++;
+            }
+        }
+        double hierarchyMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        
+        cout << "-----------------------------------------------------------------" << endl;
+        cout << "  A* / ALT (findRoute)       : " << plainMicros / QUERIES << " us/query" << endl;
+        cout << "  Contraction hierarchy      : " << hierarchyMicros / QUERIES << " us/query" << endl;
+        cout << "-----------------------------------------------------------------" << endl;
+        if (mismatches == 0) {
+            cout << "[OK] All " << QUERIES << " distances match; routing now uses the hierarchy" << endl;
+        } else {
+            // never route with a hierarchy that disagrees with the graph; drop the
+            // saved copy too so the next run rebuilds instead of reloading it
+            cout << "[ERROR] " << mismatches << " distances differ! Hierarchy discarded, "
+                 << "routing stays on findRoute" << endl;
+            delete stopHierarchy;
+            stopHierarchy = nullptr;
+            std::remove(CACHE_FILE);
+        }
+        cout << "=================================================================" << endl;
+        
+        delete[] sources;
+        delete[] targets;
+        delete[] expected;
+    }
+    
+    // bonus feature: many-to-many distance table, split across threads
+    // TransportSystem::demoDistanceMatrix()
+    // Time: O(SHOWN (V + E) log V) for the printed stop table, plus the synthetic runs
+    // Space: O(SHOWN^2) for the stop table, O(V + E) for the synthetic grid
+    void demoDistanceMatrix() {
+        int n = stopGraph->getVertexCount();
+        cout << "\n========== STOP-TO-STOP DISTANCE MATRIX (km) ==========" << endl;
+        if (n == 0) {
+            cout << "[ERROR] No bus stops loaded!" << endl;
+            return;
+        }
+        const int SHOWN = 12;   // columns that still fit in a terminal
+        int shown = n < SHOWN ? n : SHOWN;
+        // only the printed corner is computed, so the table stays SHOWN x SHOWN
+        // however many stops the city has
+        int* stops = new int[shown];
+        for (int i = 0; i < shown; i++) {
+            stops[i] = i;
+        }
+        double* table = new double[shown * shown];
+        stopGraph->distanceMatrix(stops, shown, stops, shown, table);
+        
+        ios::fmtflags savedFlags = cout.flags();
+        streamsize savedPrecision = cout.precision();
+        char cell[9];
+        cout << "        ";
+        for (int j = 0; j < shown; j++) {
+            stringCopyN(cell, stopGraph->getVertexName(j), 8);
+            cout << right << setw(7) << cell;
+        }
+        cout << endl;
+        cout << fixed << setprecision(1);
+        for (int i = 0; i < shown; i++) {
+            stringCopyN(cell, stopGraph->getVertexName(i), 9);
+            cout << left << setw(8) << cell << right;
+            for (int j = 0; j < shown; j++) {
+                if (table[i * shown + j] >= GRAPH_MAX_DISTANCE) cout << setw(7) << "-";
+                else cout << setw(7) << table[i * shown + j];
+            }
+            cout << endl;
+        }
+        cout.flags(savedFlags);
+        cout.precision(savedPrecision);
+        if (shown < n) {
+            cout << "(first " << shown << " of " << n << " stops shown)" << endl;
+        }
+        delete[] table;
+        delete[] stops;
+        
+        // scaling on a larger synthetic road grid
+        const int SIDE = 200;
+        const int ROWS = 64;
+        const int COLUMNS = 64;
+        Graph grid(SIDE * SIDE);
+        char name[20];
+        for (int i = 0; i < SIDE * SIDE; i++) {
+            snprintf(name, sizeof(name), "G%d", i);
+            grid.addVertex(name, 0, 0);
+        }
+        unsigned int seed = 7;
+        for (int r = 0; r < SIDE; r++) {
+            for (int c = 0; c < SIDE; c++) {
+                int v = r * SIDE + c;
+                seed = seed * 1103515245u + 12345u;
+                if (c + 1 < SIDE) grid.addBidirectionalEdge(v, v + 1, 0.2 + (seed >> 16) % 10 / 10.0);
+                seed = seed * 1103515245u + 12345u;
+                if (r + 1 < SIDE) grid.addBidirectionalEdge(v, v + SIDE, 0.2 + (seed >> 16) % 10 / 10.0);
+            }
+        }
+        grid.freeze();      // not part of any timed run
+        int* origins = new int[ROWS];
+        int* destinations = new int[COLUMNS];
+        for (int i = 0; i < ROWS; i++) {
+            seed = seed * 1103515245u + 12345u;
+            origins[i] = (int)((seed >> 8) % (unsigned int)(SIDE * SIDE));
+        }
+        for (int j = 0; j < COLUMNS; j++) {
+            seed = seed * 1103515245u + 12345u;
+            destinations[j] = (int)((seed >> 8) % (unsigned int)(SIDE * SIDE));
+        }
+        double* serial = new double[ROWS * COLUMNS];
+        double* parallel = new double[ROWS * COLUMNS];
+        double* nearest = new double[ROWS * COLUMNS];
+        int cores = hardwareThreads();
+        
+        cout << "\n--- " << ROWS << " x " << COLUMNS << " matrix on a " << SIDE << " x " << SIDE << " grid ---" << endl;
+        double singleMillis = 0;
+        bool same = true;
+        int threads = 1;
+        while (true) {
+            double* result = threads == 1 ? serial : parallel;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            grid.distanceMatrix(origins, ROWS, destinations, COLUMNS, result, 0, threads);
+            double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (threads == 1) {
+                singleMillis = millis;
+            } else {
+                for (int k = 0; k < ROWS * COLUMNS; k++) {
+                    if (parallel[k] != serial[k]) same = false;
+                }
+            }
+            cout << "  " << setw(3) << threads << (threads == 1 ? " thread " : " threads")
+                 << "               : " << millis << " ms";
+            if (threads > 1 && millis > 0) cout << " (x" << singleMillis / millis << ")";
+            cout << endl;
+            if (threads == cores) {
+                break;
+            }
+            threads = threads * 2 < cores ? threads * 2 : cores;     // 1, 2, 4, ... then all cores
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        grid.distanceMatrix(origins, ROWS, destinations, COLUMNS, nearest, 3, cores);
+        double nearestMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        cout << "  nearest 3 targets only    : " << nearestMillis << " ms" << endl;
+        if (cores == 1) {
+            cout << "  (only one core available here - no parallel speedup to show)" << endl;
+        }
+        
+        for (int k = 0; k < ROWS * COLUMNS; k++) {
+            if (nearest[k] < GRAPH_MAX_DISTANCE && nearest[k] != serial[k]) same = false;
+        }
+        cout << (same ? "[OK] Parallel and capped results match the serial matrix"
+                      : "[ERROR] Matrix mismatch!") << endl;
+        cout << "=======================================================" << endl;
+        
+        delete[] origins;
+        delete[] destinations;
+        delete[] serial;
+        delete[] parallel;
+        delete[] nearest;
+    }
+    
+    // bonus feature: one city-wide shortest path tree from a single search on many cores
+    // TransportSystem::demoCityWideTree()
+    // Time: O((V + E) log V) for the Dijkstra reference, O((V + E) / threads) per
+    //       delta-stepping run
+    // Space: O(V + E) for the synthetic grid
+    void demoCityWideTree() {
+        cout << "\n========== CITY-WIDE SHORTEST PATH TREE (DELTA-STEPPING) ==========" << endl;
+        int n = stopGraph->getVertexCount();
+        if (n > 0) {
+            double* expected = new double[n];
+            double* found = new double[n];
+            int* previous = new int[n];
+            stopGraph->dijkstra(0, expected, previous);
+            stopGraph->deltaStepping(0, found, previous);
+            int mismatches = 0;
+            for (int v = 0; v < n; v++) {
+                if (expected[v] != found[v]) mismatches++;
+            }
+            cout << "Bus network from " << stopGraph->getVertexName(0) << ": " << n << " stops, "
+                 << (mismatches == 0 ? "[OK] same distances as Dijkstra" : "[ERROR] distances differ!") << endl;
+            delete[] expected;
+            delete[] found;
+            delete[] previous;
+        }
+        
+        // scaling on a synthetic road grid with a few million edges
+        const int SIDE = 600;
+        int total = SIDE * SIDE;
+        Graph grid(total);
+        char name[20];
+        for (int i = 0; i < total; i++) {
+            snprintf(name, sizeof(name), "G%d", i);
+            grid.addVertex(name, 0, 0);
+        }
+        unsigned int seed = 11;
+        for (int r = 0; r < SIDE; r++) {
+            for (int c = 0; c < SIDE; c++) {
+                int v = r * SIDE + c;
+                seed = seed * 1103515245u + 12345u;
+                if (c + 1 < SIDE) grid.addBidirectionalEdge(v, v + 1, 0.2 + (seed >> 16) % 10 / 10.0);
+                seed = seed * 1103515245u + 12345u;
+                if (r + 1 < SIDE) grid.addBidirectionalEdge(v, v + SIDE, 0.2 + (seed >> 16) % 10 / 10.0);
+            }
+        }
+        int source = (SIDE / 2) * SIDE + SIDE / 2;
+        double* expected = new double[total];
+        double* found = new double[total];
+        int* previous = new int[total];
+        
+        cout << "\n--- " << SIDE << " x " << SIDE << " grid, " << 4 * SIDE * (SIDE - 1)
+             << " directed roads, bucket width " << grid.deltaWidth() << " km ---" << endl;
+        grid.deltaStepping(source, found, previous, 0, 1);    // freezes the grid first
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        grid.dijkstra(source, expected, previous);
+        double dijkstraMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        ios::fmtflags savedFlags = cout.flags();
+        streamsize savedPrecision = cout.precision();
+        cout << fixed << setprecision(2);
+        cout << "  Dijkstra         1 thread : " << dijkstraMillis << " ms" << endl;
+        
+        int cores = hardwareThreads();
+        double singleMillis = 0;
+        bool same = true;
+        int threads = 1;
+        while (true) {
+            start = std::chrono::steady_clock::now();
+            grid.deltaStepping(source, found, previous, 0, threads);
+            double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (threads == 1) {
+                singleMillis = millis;
+            }
+            cout << "  delta-stepping " << setw(3) << threads << (threads == 1 ? " thread " : " threads")
+                 << ": " << millis << " ms";
+            if (millis > 0) {
+                cout << " (x" << singleMillis / millis << " vs 1 thread, x" << dijkstraMillis / millis
+                     << " vs Dijkstra)";
+            }
+            cout << endl;
+            for (int v = 0; v < total; v++) {
+                if (found[v] != expected[v]) same = false;
+            }
+            if (threads == cores) {
+                break;
+            }
+            threads = threads * 2 < cores ? threads * 2 : cores;     // 1, 2, 4, ... then all cores
+        }
+        cout.flags(savedFlags);
+        cout.precision(savedPrecision);
+        if (cores == 1) {
+            cout << "  (only one core available here - no parallel speedup to show)" << endl;
+        }
+        cout << (same ? "[OK] Every run matches Dijkstra exactly"
+                      : "[ERROR] Distance mismatch!") << endl;
+        cout << "=====================================================================" << endl;
+        
+        delete[] expected;
+        delete[] found;
+        delete[] previous;
+    }
+    
+    // bonus feature: loading and dropping a city with one new/delete per node vs the arena
+    // TransportSystem::benchmarkArenaReload()
+    // Time: O(V + E) per run
+    // Space: O(V + E)
+    void benchmarkArenaReload() {
+        const int VERTICES = 200000;
+        const int DEGREE = 4;
+        
+        cout << "\n========== ARENA LOAD / TEARDOWN ==========" << endl;
+        cout << VERTICES << " named vertices, " << VERTICES * DEGREE << " edges" << endl;
+        cout << "--------------------------------------------" << endl;
+        
+        // the old layout: every name and every edge is its own allocation,
+        // and teardown walks each chain to free them one by one
+        Edge** heads = new Edge*[VERTICES];
+        char** names = new char*[VERTICES];
+        char name[20];
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int v = 0; v < VERTICES; v++) {
+            snprintf(name, sizeof(name), "V%d", v);
+            names[v] = new char[stringLength(name) + 1];
+            stringCopy(names[v], name);
+            heads[v] = nullptr;
+            for (int k = 1; k <= DEGREE; k++) {
+                Edge* edge = new Edge((v + k * 7919) % VERTICES, k);
+                edge->next = heads[v];
+                heads[v] = edge;
+            }
+        }
+        double newLoad = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        for (int v = 0; v < VERTICES; v++) {
+            while (heads[v] != nullptr) {
+                Edge* next = heads[v]->next;
+                delete heads[v];
+                heads[v] = next;
+            }
+            delete[] names[v];
+        }
+        double newTeardown = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        // the same nodes from a CityArena: slab bumps on load, a handful of blocks on teardown
+        auto fill = [&](CityArena& arena) {
+            for (int v = 0; v < VERTICES; v++) {
+                snprintf(name, sizeof(name), "V%d", v);
+                names[v] = arena.copyString(name);
+                heads[v] = nullptr;
+                for (int k = 1; k <= DEGREE; k++) {
+                    Edge* edge = arena.create<Edge>((v + k * 7919) % VERTICES, (double)k);
+                    edge->next = heads[v];
+                    heads[v] = edge;
+                }
+            }
+        };
+        CityArena* arena = new CityArena();
+        start = std::chrono::steady_clock::now();
+        fill(*arena);
+        double arenaLoad = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        delete arena;
+        double arenaTeardown = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        // a reload: reset() keeps the slabs, so the second load allocates nothing new
+        arena = new CityArena();
+        fill(*arena);
+        start = std::chrono::steady_clock::now();
+        arena->reset();
+        double arenaReset = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        fill(*arena);
+        double arenaReload = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        delete arena;
+        delete[] heads;
+        delete[] names;
+        
+        cout << "Raw nodes (name + edges per vertex):" << endl;
+        printTiming("new / delete per node    load", newLoad);
+        printTiming("new / delete per node    teardown", newTeardown);
+        printTiming("CityArena                load", arenaLoad);
+        printTiming("CityArena                teardown", arenaTeardown);
+        printTiming("CityArena after reset()  reload", arenaReload);
+        printTiming("CityArena                reset", arenaReset);
+        
+        // a whole Graph reloaded through one shared arena, as the journey planner's
+        // combined network does on every rebuild
+        CityArena shared;
+        double graphLoad[2];
+        double graphTeardown[2];
+        for (int round = 0; round < 2; round++) {
+            start = std::chrono::steady_clock::now();
+            Graph* graph = new Graph(VERTICES, &shared);
+            for (int v = 0; v < VERTICES; v++) {
+                snprintf(name, sizeof(name), "V%d", v);
+                graph->addVertex(name, 0, 0);
+            }
+            for (int v = 0; v < VERTICES; v++) {
+                for (int k = 1; k <= DEGREE; k++) {
+                    graph->addEdge(v, (v + k * 7919) % VERTICES, k);
+                }
+            }
+            graphLoad[round] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            start = std::chrono::steady_clock::now();
+            delete graph;
+            shared.reset();
+            graphTeardown[round] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        cout << "Graph on a shared arena:" << endl;
+        printTiming("first load", graphLoad[0]);
+        printTiming("teardown + reset()", graphTeardown[0]);
+        printTiming("reload into the reset arena", graphLoad[1]);
+        printTiming("teardown + reset()", graphTeardown[1]);
+        cout << "============================================" << endl;
+    }
+
+
+    
     // ========== VISUALIZATION HELPER METHODS ==========
     
     // Get all stop keys for visualization
-    void getStopKeys(char** keys, int* count) {
-        stopTable->getAllKeys(keys, count);
+    // visit(BusStop&) for every bus stop, straight from the table storage
+    template <typename Visitor>
+    void forEachStop(Visitor visit) {
+        stopTable->forEach([&visit](const StringView&, BusStop& stop) { visit(stop); });
     }
     
-    // Get stop by ID
-    BusStop* getStop(const char* stopID) {
-        return (BusStop*)stopTable->search(stopID);
+    // TransportSystem::getStop(stopID, copy)
+    // Time: Average O(1)
+    // Space: O(1)
+    // copies the stop out under the table's shared lock (the table is shared with
+    // the feed and visualization threads); false if the stop does not exist
+    bool getStop(const char* stopID, BusStop& copy) {
+        return stopTable->read(stopID, [&copy](const BusStop& stop) { copy = stop; });
     }
     
     // Get graph for pathfinding visualization
@@ -862,43 +1888,45 @@ public:
     // Get visual path between two stops (for visualization)
     // Returns path length, fills pathIds array with stop IDs, sets distance
     int getVisualPath(const char* from, const char* to, char pathIds[][50], double& distance) {
-        int vertexCount = stopGraph->getVertexCount();
-        double* distances = new double[vertexCount];
-        int* previous = new int[vertexCount];
-        
-        stopGraph->dijkstra(from, distances, previous);
-        
-        // Find destination index
-        int destIndex = -1;
-        for (int i = 0; i < vertexCount; i++) {
-            if (strcmp(stopGraph->getVertexName(i), to) == 0) {
-                destIndex = i;
-                break;
-            }
-        }
+        // Path comes straight from a per-thread workspace, no arrays allocated here
+        const int* path = nullptr;
+        int pathLength = 0;
+        distance = routeStops(from, to, path, pathLength);
         
-        if (destIndex == -1 || distances[destIndex] >= 999999) {
-            delete[] distances;
-            delete[] previous;
+        if (distance >= GRAPH_MAX_DISTANCE) {
             distance = 0;
             return 0;  // No path found
         }
         
-        // Get path
-        int path[100];
-        int pathLength = 0;
-        stopGraph->getPath(previous, destIndex, path, pathLength);
-        
         // Copy stop IDs to output
         for (int i = 0; i < pathLength && i < 50; i++) {
             strcpy(pathIds[i], stopGraph->getVertexName(path[i]));
         }
         
-        distance = distances[destIndex];
-        
-        delete[] distances;
-        delete[] previous;
-        return pathLength;
+        return pathLength < 50 ? pathLength : 50;
+    }
+    
+    // alternates to getVisualPath's route for the path overlay: stop IDs, stop counts
+    // and distances of up to ALTERNATE_ROUTES routes; returns how many
+    int getVisualAlternates(const char* from, const char* to, char pathIds[][50][50],
+                            int* pathCounts, double* distances) {
+        const int* path = nullptr;
+        int pathLength = 0;
+        if (routeStops(from, to, path, pathLength) >= GRAPH_MAX_DISTANCE) {
+            return 0;
+        }
+        int alternates[ALTERNATE_ROUTES];
+        int alternateCount = findAlternates(from, to, path, pathLength, alternates);
+        for (int a = 0; a < alternateCount; a++) {
+            int length = 0;
+            const int* route = routeAlternatives->path(alternates[a], length);
+            pathCounts[a] = length < 50 ? length : 50;
+            distances[a] = routeAlternatives->cost(alternates[a]);
+            for (int i = 0; i < pathCounts[a]; i++) {
+                strcpy(pathIds[a][i], stopGraph->getVertexName(route[i]));
+            }
+        }
+        return alternateCount;
     }
     
     // Get distance between two stops (returns 0 if not connected)
@@ -907,12 +1935,38 @@ public:
     }
     
     // Bus visualization helpers
-    void getBusKeys(char** keys, int* count) {
-        busTable->getAllKeys(keys, count);
+    // visit(Bus&) for every bus, straight from the table storage
+    template <typename Visitor>
+    void forEachBus(Visitor visit) {
+        busTable->forEach([&visit](const StringView&, Bus& bus) { visit(bus); });
+    }
+    
+    // TransportSystem::readBus(busID, visit)
+    // Time: Average O(1) + visit
+    // Space: O(1)
+    // calls visit(const Bus&) under the table's shared lock; a Bus owns its route
+    // arrays, so it is read in place rather than copied. false if the bus is unknown
+    template <typename Visitor>
+    bool readBus(const char* busID, Visitor visit) {
+        return busTable->read(busID, visit);
+    }
+    
+    // TransportSystem::getStopCentrality(stopID)
+    // Time: Average O(k) lookup, plus a betweenness run the first time after a change
+    // Space: O(1)
+    // share of all stop-to-stop shortest paths running through the stop (0..1)
+    double getStopCentrality(const char* stopID) {
+        int stop = stopGraph->indexOf(stopID);
+        int n = stopGraph->getVertexCount();
+        if (stop == -1 || n < 3) {
+            return 0;
+        }
+        return stopGraph->getBetweenness()[stop] / ((double)(n - 1) * (n - 2));
     }
     
-    Bus* getBus(const char* busID) {
-        return (Bus*)busTable->search(busID);
+    // stop ID behind a route entry (route entries are stop graph indices)
+    const char* getStopName(int stopIndex) {
+        return stopGraph->getVertexName(stopIndex);
     }
     
     ~TransportSystem() {
@@ -920,6 +1974,16 @@ public:
         delete busTable;
         delete stopTable;
         delete routeHistory;
+        delete gpsFeed;
+        delete stopHierarchy;
+        delete routeCache;
+        delete routeAlternatives;
+        delete schoolBusTable;
+        delete emergencyTable;
+        delete emergencyQueue;
+        delete[] dispatchSeeds;
+        delete[] seedHolder;
+        delete arena;   // last: everything above allocated from it
     }
 };
 
@@ -2,10 +2,12 @@
 #define TREE_H
 
 #include "String.h"
+#include "Arena.h"
 #include <iostream>
 using namespace std;
 
 // node for n-ary tree (no templates)
+// the node, its name and its child array are all carved from the tree's arena
 struct TreeNode {
     int data;  // simple int data for now
     char* name;
@@ -13,51 +15,44 @@ struct TreeNode {
     int childCount;
     int childCapacity;
     
-    TreeNode(int val, const char* nodeName) {
+    TreeNode(int val, const char* nodeName, CityArena* arena) {
         data = val;
-        int len = stringLength(nodeName);
-        name = new char[len + 1];
-        stringCopy(name, nodeName);
+        name = arena->copyString(nodeName);
         toUpperCase(name);  // ✅ CONVERT TO UPPERCASE! This was missing!
         childCapacity = 10;
         childCount = 0;
-        children = new TreeNode*[childCapacity];
+        children = (TreeNode**)arena->allocate(sizeof(TreeNode*) * childCapacity);
         for (int i = 0; i < childCapacity; i++) {
             children[i] = nullptr;
         }
     }
     
     // add child to this node
-    void addChild(TreeNode* child) {
+    void addChild(TreeNode* child, CityArena* arena) {
         if (childCount == childCapacity) {
             // expand capacity
+            int oldCapacity = childCapacity;
             childCapacity *= 2;
-            TreeNode** newChildren = new TreeNode*[childCapacity];
+            TreeNode** newChildren = (TreeNode**)arena->allocate(sizeof(TreeNode*) * childCapacity);
             for (int i = 0; i < childCount; i++) {
                 newChildren[i] = children[i];
             }
             for (int i = childCount; i < childCapacity; i++) {
                 newChildren[i] = nullptr;
             }
-            delete[] children;
+            arena->release(children, sizeof(TreeNode*) * oldCapacity);
             children = newChildren;
         }
         children[childCount++] = child;
     }
-    
-    ~TreeNode() {
-        delete[] name;
-        for (int i = 0; i < childCount; i++) {
-            delete children[i];
-        }
-        delete[] children;
-    }
 };
 
 // n-ary tree structure (no templates)
 class Tree {
 private:
     TreeNode* root;
+    CityArena* arena;       // shared by the owning system, or our own
+    CityArena* ownedArena;  // set only when no arena was handed in
     
     // helper to print tree
     void printHelper(TreeNode* node, int level) {
@@ -89,24 +84,31 @@ private:
         return nullptr;
     }
 
-    // Helper for recursive deletion
+    // Helper for recursive deletion (hands nodes back to the arena for reuse)
     void deleteTree(TreeNode* node) {
         if (node == nullptr) return;
         for (int i = 0; i < node->childCount; i++) {
             deleteTree(node->children[i]);
         }
-        delete node; // Delete the node itself after its children
+        arena->release(node->children, sizeof(TreeNode*) * node->childCapacity);
+        arena->destroy(node); // Delete the node itself after its children
     }
 
 public:
-    Tree() {
+    Tree(CityArena* sharedArena = nullptr) {
         root = nullptr;
+        ownedArena = nullptr;
+        if (sharedArena == nullptr) {
+            ownedArena = new CityArena();
+            sharedArena = ownedArena;
+        }
+        arena = sharedArena;
     }
     
     // set root node
     void setRoot(int data, const char* name) {
         if (root != nullptr) deleteTree(root); // Use helper for full tree deletion
-        root = new TreeNode(data, name); // TreeNode constructor converts name to uppercase
+        root = arena->create<TreeNode>(data, name, arena); // TreeNode constructor converts name to uppercase
     }
     
     // get root
@@ -146,8 +148,8 @@ public:
             return false; // parent not found (case-insensitive)
         }
         
-        TreeNode* newNode = new TreeNode(data, childName); // TreeNode constructor converts name to uppercase
-        parent->addChild(newNode);
+        TreeNode* newNode = arena->create<TreeNode>(data, childName, arena); // TreeNode constructor converts name to uppercase
+        parent->addChild(newNode, arena);
         return true;
     }
     
@@ -176,10 +178,9 @@ public:
         printHelper(root, 0);
     }
     
+    // the nodes are not walked: the arena releases them in bulk
     ~Tree() {
-        if (root != nullptr) {
-            delete root;
-        }
+        delete ownedArena;
     }
 };
 
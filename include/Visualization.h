@@ -23,63 +23,63 @@ const float UI_WIDTH = 250.0f;
 struct StopData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
 struct HospitalData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
 struct SchoolData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
 struct PharmacyData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
 struct MallData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
 struct ParkData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
 struct AirportData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
 struct RailwayStationData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
 struct MosqueData {
     char id[50];
     char name[100];
-    char sector[50];
+    SectorId sectorId;   // interned, see SectorRegistry.h
     float x, y;
 };
 
@@ -100,9 +100,8 @@ struct BusData {
     float pauseTimer;        // Pause at stops (seconds)
     bool isMoving;           // Currently in motion
     // Path following
-    int pathStops[20];       // Stop indices in path
-    int pathLength;          // Number of stops in path
-    int pathIndex;           // Current position in path
+    BusRoute path;           // the bus route as indices into stops[]
+    int pathIndex;           // Current position in path, -1 = off the route
     int currentStopIdx;      // Current stop index
 };
 
@@ -146,7 +145,7 @@ struct FlightData {
 struct DecorationData {
     int type;         // 0=house, 1=flats, 2=factory, 3=water tower, 4=restaurant, 5=gas station, 6=police, 7=fire
     float x, y;
-    char sector[20];
+    SectorId sectorId;
 };
 
 class Visualization {
@@ -245,11 +244,9 @@ private:
     struct SectorSpatialData {
         OccupiedPosition positions[100];
         int count;
-        char sectorName[50];
+        SectorId sectorId;
         
-        SectorSpatialData() : count(0) {
-            sectorName[0] = '\0';
-        }
+        SectorSpatialData() : count(0), sectorId(NO_SECTOR) {}
     };
     
     SectorSpatialData sectorGrids[20];  // One per sector
@@ -282,6 +279,10 @@ private:
     int pathStopCount;             // Number of stops in path
     float pathDistance;            // Total path distance in km
     bool pathFound;                // Was a valid path found?
+    char altPathIds[TransportSystem::ALTERNATE_ROUTES][50][50];   // next best routes (bus network)
+    int altPathCounts[TransportSystem::ALTERNATE_ROUTES];
+    float altPathDistances[TransportSystem::ALTERNATE_ROUTES];
+    int altPathTotal;              // Number of alternates shown
     
     // Toggles
     bool showConnections;
@@ -301,6 +302,7 @@ private:
     bool showMosques;
     bool showDecorations;
     bool showInstructions;
+    bool showCentrality;           // betweenness halos on stops and stations
     bool running;
     
     // System references
@@ -334,13 +336,13 @@ public:
                       searchBoxFocused(false), searchFilterType(-1), hoveredSearchResult(-1),
                       pathfindingMode(false), pathfindingNetworkType(0),
                       pathSourceStop(-1), pathDestStop(-1),
-                      pathStopCount(0), pathDistance(0.0f), pathFound(false),
+                      pathStopCount(0), pathDistance(0.0f), pathFound(false), altPathTotal(0),
                       showConnections(true), showAirportConnections(true), showRailwayConnections(true),
                       connectionCycleState(0),
                       showHospitals(true), showSchools(true),
                       showPharmacies(true), showMalls(true), showParks(true),
                       showAirports(true), showRailways(true),
-                      showBuses(true), showTrains(true), showFlights(true), showMosques(true), showDecorations(true), showInstructions(false),
+                      showBuses(true), showTrains(true), showFlights(true), showMosques(true), showDecorations(true), showInstructions(false), showCentrality(false),
                       animationPaused(true), vehicleSpeed(150.0f),  // Paused by default
                       running(true), 
                       transport(nullptr), medical(nullptr), education(nullptr),
@@ -375,49 +377,22 @@ public:
     // Collect ALL sectors from ALL data sources
     void collectAllSectors(PopulationSystem* pop, TransportSystem* trans, 
                           MedicalSystem* med, EducationSystem* edu) {
-        char* allSectors[100];
+        SectorId allSectors[100];
         int totalCount = 0;
         
-        // Helper to add sector if unique (case-insensitive, whitespace-trimmed)
-        auto addUniqueSector = [&](const char* sector) {
-            if (sector == nullptr || sector[0] == '\0') return;
-            
-            // Trim and normalize input sector
-            char trimmed[100];
-            int start = 0;
-            while (sector[start] == ' ') start++;
-            
-            int len = strlen(sector + start);
-            while (len > 0 && sector[start + len - 1] == ' ') len--;
-            
-            for (int i = 0; i < len; i++) {
-                trimmed[i] = sector[start + i];
-            }
-            trimmed[len] = '\0';
-            
-            if (trimmed[0] == '\0') return; // Empty after trimming
-            
-            // Normalize to uppercase for comparison
-            char normalizedSector[100];
-            strcpy(normalizedSector, trimmed);
-            toUpperCase(normalizedSector);
-            
-            // Check if already exists (case-insensitive)
-            for (int i = 0; i < totalCount; i++) {
-                char existingNormalized[100];
-                strcpy(existingNormalized, allSectors[i]);
-                toUpperCase(existingNormalized);
-                
-                if (strcmp(existingNormalized, normalizedSector) == 0) {
-                    return; // Already exists
-                }
-            }
-            
-            // Add new unique sector (using trimmed original case)
+        // ids are dense, so "already collected?" is one flag lookup instead of
+        // comparing against every sector gathered so far
+        int idCount = sectorRegistry.getCount();
+        bool* seen = new bool[idCount > 0 ? idCount : 1];
+        for (int i = 0; i < idCount; i++) {
+            seen[i] = false;
+        }
+        
+        auto addUniqueSector = [&](SectorId sector) {
+            if (sector == NO_SECTOR || sector >= idCount || seen[sector]) return;
+            seen[sector] = true;
             if (totalCount < 100) {
-                int trimmedLen = strlen(trimmed);
-                allSectors[totalCount] = new char[trimmedLen + 1];
-                strcpy(allSectors[totalCount], trimmed);
+                allSectors[totalCount] = sector;
                 totalCount++;
             }
         };
@@ -428,7 +403,7 @@ public:
             int popCount = 0;
             pop->getSectorNames(popSectors, &popCount);
             for (int i = 0; i < popCount; i++) {
-                addUniqueSector(popSectors[i]);
+                addUniqueSector(findSector(popSectors[i]));
                 delete[] popSectors[i];
             }
             delete[] popSectors;
@@ -436,126 +411,65 @@ public:
         
         // 2. Collect from TransportSystem (bus stops)
         if (trans) {
-            char** keys = new char*[50];
-            int count = 0;
-            trans->getStopKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                BusStop* stop = trans->getStop(keys[i]);
-                if (stop) {
-                    addUniqueSector(stop->sector);
-                }
-            }
-            delete[] keys;
+            trans->forEachStop([&](BusStop& stop) {
+                addUniqueSector(stop.sectorId);
+            });
         }
         
         // 3. Collect from MedicalSystem (hospitals)
         if (med) {
-            char** keys = new char*[20];
-            int count = 0;
-            med->getHospitalKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                Hospital* hosp = med->getHospital(keys[i]);
-                if (hosp) {
-                    addUniqueSector(hosp->sector);
-                }
-            }
-            delete[] keys;
+            med->forEachHospital([&](Hospital& hosp) {
+                addUniqueSector(hosp.sectorId);
+            });
         }
         
         // 4. Collect from EducationSystem (schools)
         if (edu) {
-            char** keys = new char*[20];
-            int count = 0;
-            edu->getSchoolKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                School* school = edu->getSchool(keys[i]);
-                if (school) {
-                    addUniqueSector(school->sector);
-                }
-            }
-            delete[] keys;
+            edu->forEachSchool([&](School& school) {
+                addUniqueSector(school.sectorId);
+            });
         }
         
         // 5. Collect from MedicalSystem (pharmacies)
         if (med) {
-            char** keys = new char*[20];
-            int count = 0;
-            med->getPharmacyKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                Pharmacy* pharm = med->getPharmacy(keys[i]);
-                if (pharm) {
-                    addUniqueSector(pharm->sector);
-                }
-            }
-            delete[] keys;
+            med->forEachPharmacy([&](Pharmacy& pharm) {
+                addUniqueSector(pharm.sectorId);
+            });
         }
         
         // 6. Collect from CommercialSystem (malls)
         if (commercial) {
-            char** keys = new char*[20];
-            int count = 0;
-            commercial->getMallKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                Mall* mall = commercial->getMall(keys[i]);
-                if (mall) {
-                    addUniqueSector(mall->sector);
-                }
-            }
-            delete[] keys;
+            commercial->forEachMall([&](Mall& mall) {
+                addUniqueSector(mall.sectorId);
+            });
         }
         
         // 6. Collect from PublicFacilitySystem (parks AND mosques)
         if (publicFacilities) {
-            char** keys = new char*[20];
-            int count = 0;
-            
             // Parks
-            publicFacilities->getParkKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                Facility* park = publicFacilities->getPark(keys[i]);
-                if (park) {
-                    addUniqueSector(park->sector);
-                }
-            }
+            publicFacilities->forEachPark([&](Facility& park) {
+                addUniqueSector(park.sectorId);
+            });
             
             // Mosques
-            publicFacilities->getMosqueKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                Facility* mosque = publicFacilities->getMosque(keys[i]);
-                if (mosque) {
-                    addUniqueSector(mosque->sector);
-                }
-            }
+            publicFacilities->forEachMosque([&](Facility& mosque) {
+                addUniqueSector(mosque.sectorId);
+            });
             
-            delete[] keys;
         }
         
         // 8. Collect from AirportSystem
         if (airports_sys) {
-            char** keys = new char*[10];
-            int count = 0;
-            airports_sys->getAirportKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                Airport* airport = airports_sys->getAirport(keys[i]);
-                if (airport) {
-                    addUniqueSector(airport->sector);
-                }
-            }
-            delete[] keys;
+            airports_sys->forEachAirport([&](Airport& airport) {
+                addUniqueSector(airport.sectorId);
+            });
         }
         
         // 9. Collect from RailwaySystem
         if (railway_sys) {
-            char** keys = new char*[10];
-            int count = 0;
-            railway_sys->getStationKeys(keys, &count);
-            for (int i = 0; i < count; i++) {
-                RailStation* station = railway_sys->getStation(keys[i]);
-                if (station) {
-                    addUniqueSector(station->sector);
-                }
-            }
-            delete[] keys;
+            railway_sys->forEachStation([&](RailStation& station) {
+                addUniqueSector(station.sectorId);
+            });
         }
         
         // Build city map from collected unique sectors
@@ -566,10 +480,7 @@ public:
             printf("[WARNING] No sectors found in any system\n");
         }
         
-        // Clean up
-        for (int i = 0; i < totalCount; i++) {
-            delete[] allSectors[i];
-        }
+        delete[] seen;
     }
     
     void setTransportSystem(TransportSystem* ts) { 
@@ -611,47 +522,24 @@ public:
         sectorGridCount = 0;
         for (int i = 0; i < 20; i++) {
             sectorGrids[i].count = 0;
-            sectorGrids[i].sectorName[0] = '\0';
+            sectorGrids[i].sectorId = NO_SECTOR;
         }
     }
     
-    // Normalize sector name for comparison (uppercase, trimmed)
-    void normalizeSectorForGrid(const char* src, char* dst) {
-        int i = 0, j = 0;
-        // Skip leading whitespace
-        while (src[i] == ' ') i++;
-        // Copy and uppercase
-        while (src[i] != '\0' && j < 49) {
-            if (src[i] >= 'a' && src[i] <= 'z') {
-                dst[j++] = src[i] - 32;  // Convert to uppercase
-            } else {
-                dst[j++] = src[i];
-            }
-            i++;
-        }
-        // Trim trailing whitespace
-        while (j > 0 && dst[j-1] == ' ') j--;
-        dst[j] = '\0';
-    }
-    
-    // Get or create spatial grid for a sector (case-insensitive)
-    SectorSpatialData* getSectorGrid(const char* sector) {
-        // Normalize input sector name
-        char normalizedInput[50];
-        normalizeSectorForGrid(sector, normalizedInput);
+    // Get or create spatial grid for a sector (int compare on the interned id)
+    SectorSpatialData* getSectorGrid(SectorId sector) {
+        if (sector == NO_SECTOR) return nullptr;
         
-        // Find existing (case-insensitive)
+        // Find existing
         for (int i = 0; i < sectorGridCount; i++) {
-            char normalizedExisting[50];
-            normalizeSectorForGrid(sectorGrids[i].sectorName, normalizedExisting);
-            if (strcmp(normalizedExisting, normalizedInput) == 0) {
+            if (sectorGrids[i].sectorId == sector) {
                 return &sectorGrids[i];
             }
         }
         
         // Create new
         if (sectorGridCount < 20) {
-            strcpy(sectorGrids[sectorGridCount].sectorName, sector);
+            sectorGrids[sectorGridCount].sectorId = sector;
             sectorGrids[sectorGridCount].count = 0;
             return &sectorGrids[sectorGridCount++];
         }
@@ -719,7 +607,7 @@ public:
     }
     
     // Find free position in sector that doesn't collide
-    bool findFreePosition(const char* sector, float radius, float& outX, float& outY) {
+    bool findFreePosition(SectorId sector, float radius, float& outX, float& outY) {
         SectorSpatialData* grid = getSectorGrid(sector);
         if (!grid) return false;  // Exceed sector limit
         
@@ -795,7 +683,7 @@ public:
     }
     
     // Mark position as occupied
-    void markPositionOccupied(const char* sector, float x, float y, float radius) {
+    void markPositionOccupied(SectorId sector, float x, float y, float radius) {
         SectorSpatialData* grid = getSectorGrid(sector);
         if (!grid || grid->count >= 100) return;
         
@@ -964,7 +852,7 @@ public:
         
         // Get all sectors from cityMap
         for (int s = 0; s < cityMap.getSectorCount() && decorationCount < 200; s++) {
-            const char* sectorName = cityMap.getSector(s)->name;
+            SectorId sectorId = cityMap.getSector(s)->id;
             
             // Generate 3-4 decorations per sector
             int numDecorations = 3 + (rand() % 2);  // 3 or 4
@@ -975,12 +863,12 @@ public:
                 
                 float x, y;
                 // Use collision-free placement (60px radius for decorations)
-                if (findFreePosition(sectorName, 60.0f, x, y)) {
+                if (findFreePosition(sectorId, 60.0f, x, y)) {
                     decorations[decorationCount].type = type;
                     decorations[decorationCount].x = x;
                     decorations[decorationCount].y = y;
-                    strcpy(decorations[decorationCount].sector, sectorName);
-                    markPositionOccupied(sectorName, x, y, 60.0f);
+                    decorations[decorationCount].sectorId = sectorId;
+                    markPositionOccupied(sectorId, x, y, 60.0f);
                     decorationCount++;
                 }
             }
@@ -1001,7 +889,6 @@ public:
             buses[i].progress = 1.0f;
             buses[i].pauseTimer = 0.5f + (rand() % 100) / 100.0f;
             buses[i].isMoving = false;
-            buses[i].pathLength = 0;
             buses[i].pathIndex = 0;
             // currentStopIdx is now set during loadBusesFromSystem()
             // Only use distance-based fallback if somehow not set
@@ -1015,6 +902,7 @@ public:
                     }
                 }
             }
+            buses[i].pathIndex = buses[i].path.positionOf(buses[i].currentStopIdx);
         }
         
         // Initialize trains
@@ -1065,8 +953,25 @@ public:
     }
     
     void pickNextTarget(BusData& bus) {
-        // Only pick directly connected stops - no random jumps
-        if (bus.currentStopIdx < 0 || connectionCount == 0) return;
+        if (bus.currentStopIdx < 0) return;
+        
+        // Follow the bus route by position while there is a stop ahead; a bus that
+        // wandered back onto its route picks it up at the stop's next visit
+        if (bus.path.stopAt(bus.pathIndex) != bus.currentStopIdx) {
+            bus.pathIndex = bus.path.positionAfter(bus.currentStopIdx, bus.pathIndex > 0 ? bus.pathIndex : 0);
+        }
+        int routeNext = bus.path.stopAt(bus.pathIndex + 1);
+        if (bus.pathIndex != -1 && routeNext != -1) {
+            bus.targetX = stops[routeNext].x;
+            bus.targetY = stops[routeNext].y;
+            bus.currentStopIdx = routeNext;
+            bus.pathIndex++;
+            bus.isMoving = true;
+            return;
+        }
+        
+        // Off the route or at its end: only pick directly connected stops - no random jumps
+        if (connectionCount == 0) return;
         
         // Find all connections from current stop
         int connectedStops[20];
@@ -1237,6 +1142,7 @@ public:
         pathSourceStop = -1;
         pathDestStop = -1;
         pathStopCount = 0;
+        altPathTotal = 0;
         pathDistance = 0.0f;
         pathFound = false;
         // Clear entity selections
@@ -1252,6 +1158,7 @@ public:
         pathSourceStop = -1;
         pathDestStop = -1;
         pathStopCount = 0;
+        altPathTotal = 0;
         pathDistance = 0.0f;
         pathFound = false;
     }
@@ -1260,6 +1167,7 @@ public:
         pathSourceStop = -1;
         pathDestStop = -1;
         pathStopCount = 0;
+        altPathTotal = 0;
         pathDistance = 0.0f;
         pathFound = false;
     }
@@ -1268,12 +1176,18 @@ public:
         if (pathSourceStop < 0 || pathDestStop < 0) return;
         
         double distance = 0.0;
+        altPathTotal = 0;   // alternates are only offered on the bus network
         
         if (pathfindingNetworkType == 0 && transport != nullptr) {
             // Bus stops
             const char* sourceId = stops[pathSourceStop].id;
             const char* destId = stops[pathDestStop].id;
             pathStopCount = transport->getVisualPath(sourceId, destId, pathStopIds, distance);
+            double altDistances[TransportSystem::ALTERNATE_ROUTES];
+            altPathTotal = transport->getVisualAlternates(sourceId, destId, altPathIds, altPathCounts, altDistances);
+            for (int a = 0; a < altPathTotal; a++) {
+                altPathDistances[a] = static_cast<float>(altDistances[a]);
+            }
         } else if (pathfindingNetworkType == 1 && airports_sys != nullptr) {
             // Airports
             const char* sourceId = airports[pathSourceStop].id;
@@ -1297,31 +1211,20 @@ public:
         if (!transport) return;
         stopCount = 0;
         
-        // Get all stops from the hashtable
-        char** keys = new char*[50];
-        int count = 0;
-        transport->getStopKeys(keys, &count);
-        
-        // Count stops per sector for better distribution
-        int sectorStopCounts[10] = {0};
-        int sectorStartIndices[10] = {0};
-        
-        for (int i = 0; i < count && stopCount < 50; i++) {
-            BusStop* stop = transport->getStop(keys[i]);
-            if (stop) {
-                strcpy(stops[stopCount].id, stop->stopID);
-                strcpy(stops[stopCount].name, stop->name);
-                strcpy(stops[stopCount].sector, stop->sector);
-                
-                // Use collision-free placement
-                if (findFreePosition(stop->sector, 35.0f, stops[stopCount].x, stops[stopCount].y)) {
-                    markPositionOccupied(stop->sector, stops[stopCount].x, stops[stopCount].y, 35.0f);
-                    stopCount++;
-                }
+        // Walk the stop table in place
+        transport->forEachStop([&](BusStop& stop) {
+            if (stopCount >= 50) return;  // display arrays are fixed size
+            strcpy(stops[stopCount].id, stop.stopID);
+            strcpy(stops[stopCount].name, stop.name);
+            stops[stopCount].sectorId = stop.sectorId;
+            
+            // Use collision-free placement
+            if (findFreePosition(stop.sectorId, 35.0f, stops[stopCount].x, stops[stopCount].y)) {
+                markPositionOccupied(stop.sectorId, stops[stopCount].x, stops[stopCount].y, 35.0f);
+                stopCount++;
             }
-        }
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d bus stops from system\n", stopCount);
     }
     
@@ -1393,27 +1296,20 @@ public:
         if (!medical) return;
         hospitalCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        medical->getHospitalKeys(keys, &count);
-        
-        for (int i = 0; i < count && hospitalCount < 20; i++) {
-            Hospital* hosp = medical->getHospital(keys[i]);
-            if (hosp) {
-                strcpy(hospitals[hospitalCount].id, hosp->hospitalID);
-                strcpy(hospitals[hospitalCount].name, hosp->name);
-                strcpy(hospitals[hospitalCount].sector, hosp->sector);
-                
-                // Use collision-free placement (60px radius for hospitals)
-                if (!findFreePosition(hosp->sector, 60.0f, hospitals[hospitalCount].x, hospitals[hospitalCount].y)) {
-                    cityMap.getSectorPosition(hosp->sector, hospitals[hospitalCount].x, hospitals[hospitalCount].y);
-                }
-                markPositionOccupied(hosp->sector, hospitals[hospitalCount].x, hospitals[hospitalCount].y, 60.0f);
-                hospitalCount++;
+        medical->forEachHospital([&](Hospital& hosp) {
+            if (hospitalCount >= 20) return;  // display arrays are fixed size
+            strcpy(hospitals[hospitalCount].id, hosp.hospitalID);
+            strcpy(hospitals[hospitalCount].name, hosp.name);
+            hospitals[hospitalCount].sectorId = hosp.sectorId;
+            
+            // Use collision-free placement (60px radius for hospitals)
+            if (!findFreePosition(hosp.sectorId, 60.0f, hospitals[hospitalCount].x, hospitals[hospitalCount].y)) {
+                cityMap.getSectorPosition(hosp.sectorId, hospitals[hospitalCount].x, hospitals[hospitalCount].y);
             }
-        }
+            markPositionOccupied(hosp.sectorId, hospitals[hospitalCount].x, hospitals[hospitalCount].y, 60.0f);
+            hospitalCount++;
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d hospitals\n", hospitalCount);
     }
     
@@ -1422,27 +1318,20 @@ public:
         if (!education) return;
         schoolCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        education->getSchoolKeys(keys, &count);
-        
-        for (int i = 0; i < count && schoolCount < 20; i++) {
-            School* school = education->getSchool(keys[i]);
-            if (school) {
-                strcpy(schools[schoolCount].id, school->schoolID);
-                strcpy(schools[schoolCount].name, school->name);
-                strcpy(schools[schoolCount].sector, school->sector);
-                
-                // Use collision-free placement (50px radius for schools)
-                if (!findFreePosition(school->sector, 50.0f, schools[schoolCount].x, schools[schoolCount].y)) {
-                    cityMap.getSectorPosition(school->sector, schools[schoolCount].x, schools[schoolCount].y);
-                }
-                markPositionOccupied(school->sector, schools[schoolCount].x, schools[schoolCount].y, 50.0f);
-                schoolCount++;
+        education->forEachSchool([&](School& school) {
+            if (schoolCount >= 20) return;  // display arrays are fixed size
+            strcpy(schools[schoolCount].id, school.schoolID);
+            strcpy(schools[schoolCount].name, school.name);
+            schools[schoolCount].sectorId = school.sectorId;
+            
+            // Use collision-free placement (50px radius for schools)
+            if (!findFreePosition(school.sectorId, 50.0f, schools[schoolCount].x, schools[schoolCount].y)) {
+                cityMap.getSectorPosition(school.sectorId, schools[schoolCount].x, schools[schoolCount].y);
             }
-        }
+            markPositionOccupied(school.sectorId, schools[schoolCount].x, schools[schoolCount].y, 50.0f);
+            schoolCount++;
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d schools\n", schoolCount);
     }
     
@@ -1451,27 +1340,20 @@ public:
         if (!medical) return;
         pharmacyCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        medical->getPharmacyKeys(keys, &count);
-        
-        for (int i = 0; i < count && pharmacyCount < 20; i++) {
-            Pharmacy* pharm = medical->getPharmacy(keys[i]);
-            if (pharm) {
-                strcpy(pharmacies[pharmacyCount].id, pharm->pharmacyID);
-                strcpy(pharmacies[pharmacyCount].name, pharm->name);
-                strcpy(pharmacies[pharmacyCount].sector, pharm->sector);
-                
-                // Use collision-free placement (50px radius for pharmacies)
-                if (!findFreePosition(pharm->sector, 50.0f, pharmacies[pharmacyCount].x, pharmacies[pharmacyCount].y)) {
-                     cityMap.getSectorPosition(pharm->sector, pharmacies[pharmacyCount].x, pharmacies[pharmacyCount].y);
-                }
-                markPositionOccupied(pharm->sector, pharmacies[pharmacyCount].x, pharmacies[pharmacyCount].y, 50.0f);
-                pharmacyCount++;
+        medical->forEachPharmacy([&](Pharmacy& pharm) {
+            if (pharmacyCount >= 20) return;  // display arrays are fixed size
+            strcpy(pharmacies[pharmacyCount].id, pharm.pharmacyID);
+            strcpy(pharmacies[pharmacyCount].name, pharm.name);
+            pharmacies[pharmacyCount].sectorId = pharm.sectorId;
+            
+            // Use collision-free placement (50px radius for pharmacies)
+            if (!findFreePosition(pharm.sectorId, 50.0f, pharmacies[pharmacyCount].x, pharmacies[pharmacyCount].y)) {
+                 cityMap.getSectorPosition(pharm.sectorId, pharmacies[pharmacyCount].x, pharmacies[pharmacyCount].y);
             }
-        }
+            markPositionOccupied(pharm.sectorId, pharmacies[pharmacyCount].x, pharmacies[pharmacyCount].y, 50.0f);
+            pharmacyCount++;
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d pharmacies\n", pharmacyCount);
     }
     
@@ -1480,27 +1362,20 @@ public:
         if (!commercial) return;
         mallCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        commercial->getMallKeys(keys, &count);
-        
-        for (int i = 0; i < count && mallCount < 20; i++) {
-            Mall* mall = commercial->getMall(keys[i]);
-            if (mall) {
-                strcpy(malls[mallCount].id, mall->mallID);
-                strcpy(malls[mallCount].name, mall->name);
-                strcpy(malls[mallCount].sector, mall->sector);
-                
-                // Use collision-free placement (60px radius for malls)
-                if (!findFreePosition(mall->sector, 60.0f, malls[mallCount].x, malls[mallCount].y)) {
-                    cityMap.getSectorPosition(mall->sector, malls[mallCount].x, malls[mallCount].y);
-                }
-                markPositionOccupied(mall->sector, malls[mallCount].x, malls[mallCount].y, 60.0f);
-                mallCount++;
+        commercial->forEachMall([&](Mall& mall) {
+            if (mallCount >= 20) return;  // display arrays are fixed size
+            strcpy(malls[mallCount].id, mall.mallID);
+            strcpy(malls[mallCount].name, mall.name);
+            malls[mallCount].sectorId = mall.sectorId;
+            
+            // Use collision-free placement (60px radius for malls)
+            if (!findFreePosition(mall.sectorId, 60.0f, malls[mallCount].x, malls[mallCount].y)) {
+                cityMap.getSectorPosition(mall.sectorId, malls[mallCount].x, malls[mallCount].y);
             }
-        }
+            markPositionOccupied(mall.sectorId, malls[mallCount].x, malls[mallCount].y, 60.0f);
+            mallCount++;
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d malls\n", mallCount);
     }
     
@@ -1509,28 +1384,21 @@ public:
         if (!publicFacilities) return;
         parkCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        publicFacilities->getParkKeys(keys, &count);
-        
-        for (int i = 0; i < count && parkCount < 20; i++) {
-            Facility* park = publicFacilities->getPark(keys[i]);
-            if (park) {
-                strcpy(parks[parkCount].id, park->facilityID);
-                strcpy(parks[parkCount].name, park->name);
-                strcpy(parks[parkCount].sector, park->sector);
-                
-                // Use collision-free placement (90px radius for parks - reduced to fit)
-                if (!findFreePosition(park->sector, 90.0f, parks[parkCount].x, parks[parkCount].y)) {
-                    // Fallback to sector position so it's in the list
-                    cityMap.getSectorPosition(park->sector, parks[parkCount].x, parks[parkCount].y);
-                }
-                markPositionOccupied(park->sector, parks[parkCount].x, parks[parkCount].y, 90.0f);
-                parkCount++;
+        publicFacilities->forEachPark([&](Facility& park) {
+            if (parkCount >= 20) return;  // display arrays are fixed size
+            strcpy(parks[parkCount].id, park.facilityID);
+            strcpy(parks[parkCount].name, park.name);
+            parks[parkCount].sectorId = park.sectorId;
+            
+            // Use collision-free placement (90px radius for parks - reduced to fit)
+            if (!findFreePosition(park.sectorId, 90.0f, parks[parkCount].x, parks[parkCount].y)) {
+                // Fallback to sector position so it's in the list
+                cityMap.getSectorPosition(park.sectorId, parks[parkCount].x, parks[parkCount].y);
             }
-        }
+            markPositionOccupied(park.sectorId, parks[parkCount].x, parks[parkCount].y, 90.0f);
+            parkCount++;
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d parks\n", parkCount);
     }
     
@@ -1539,27 +1407,20 @@ public:
         if (!publicFacilities) return;
         mosqueCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        publicFacilities->getMosqueKeys(keys, &count);
-        
-        for (int i = 0; i < count && mosqueCount < 20; i++) {
-            Facility* mosque = publicFacilities->getMosque(keys[i]);
-            if (mosque) {
-                strcpy(mosques[mosqueCount].id, mosque->facilityID);
-                strcpy(mosques[mosqueCount].name, mosque->name);
-                strcpy(mosques[mosqueCount].sector, mosque->sector);
-                
-                // Use collision-free placement (40px radius for mosques - reduced)
-                if (!findFreePosition(mosque->sector, 40.0f, mosques[mosqueCount].x, mosques[mosqueCount].y)) {
-                    cityMap.getSectorPosition(mosque->sector, mosques[mosqueCount].x, mosques[mosqueCount].y);
-                }
-                markPositionOccupied(mosque->sector, mosques[mosqueCount].x, mosques[mosqueCount].y, 40.0f);
-                mosqueCount++;
+        publicFacilities->forEachMosque([&](Facility& mosque) {
+            if (mosqueCount >= 20) return;  // display arrays are fixed size
+            strcpy(mosques[mosqueCount].id, mosque.facilityID);
+            strcpy(mosques[mosqueCount].name, mosque.name);
+            mosques[mosqueCount].sectorId = mosque.sectorId;
+            
+            // Use collision-free placement (40px radius for mosques - reduced)
+            if (!findFreePosition(mosque.sectorId, 40.0f, mosques[mosqueCount].x, mosques[mosqueCount].y)) {
+                cityMap.getSectorPosition(mosque.sectorId, mosques[mosqueCount].x, mosques[mosqueCount].y);
             }
-        }
+            markPositionOccupied(mosque.sectorId, mosques[mosqueCount].x, mosques[mosqueCount].y, 40.0f);
+            mosqueCount++;
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d mosques\n", mosqueCount);
     }
     
@@ -1568,30 +1429,23 @@ public:
         if (!airports_sys) return;
         airportCount = 0;
         
-        char** keys = new char*[10];
-        int count = 0;
-        airports_sys->getAirportKeys(keys, &count);
-        
-        for (int i = 0; i < count && airportCount < 10; i++) {
-            Airport* airport = airports_sys->getAirport(keys[i]);
-            if (airport) {
-                strcpy(airports[airportCount].id, airport->code);
-                strcpy(airports[airportCount].name, airport->name);
-                strcpy(airports[airportCount].sector, airport->sector);
-                
-                // Use collision-free placement (80px radius for airports - reduced)
-                if (!findFreePosition(airport->sector, 80.0f, airports[airportCount].x, airports[airportCount].y)) {
-                    cityMap.getSectorPosition(airport->sector, airports[airportCount].x, airports[airportCount].y);
-                }
-                markPositionOccupied(airport->sector, airports[airportCount].x, airports[airportCount].y, 80.0f);
-                airportCount++;
+        airports_sys->forEachAirport([&](Airport& airport) {
+            if (airportCount >= 10) return;  // display arrays are fixed size
+            strcpy(airports[airportCount].id, airport.code);
+            strcpy(airports[airportCount].name, airport.name);
+            airports[airportCount].sectorId = airport.sectorId;
+            
+            // Use collision-free placement (80px radius for airports - reduced)
+            if (!findFreePosition(airport.sectorId, 80.0f, airports[airportCount].x, airports[airportCount].y)) {
+                cityMap.getSectorPosition(airport.sectorId, airports[airportCount].x, airports[airportCount].y);
             }
-        }
+            markPositionOccupied(airport.sectorId, airports[airportCount].x, airports[airportCount].y, 80.0f);
+            airportCount++;
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d airports\n", airportCount);
         for (int i = 0; i < airportCount; i++) {
-            printf("  Airport %s at (%.1f, %.1f) sector=%s\n", airports[i].id, airports[i].x, airports[i].y, airports[i].sector);
+            printf("  Airport %s at (%.1f, %.1f) sector=%s\n", airports[i].id, airports[i].x, airports[i].y, sectorName(airports[i].sectorId));
         }
     }
     
@@ -1600,30 +1454,23 @@ public:
         if (!railway_sys) return;
         railwayStationCount = 0;
         
-        char** keys = new char*[10];
-        int count = 0;
-        railway_sys->getStationKeys(keys, &count);
-        
-        for (int i = 0; i < count && railwayStationCount < 10; i++) {
-            RailStation* station = railway_sys->getStation(keys[i]);
-            if (station) {
-                strcpy(railwayStations[railwayStationCount].id, station->stationID);
-                strcpy(railwayStations[railwayStationCount].name, station->name);
-                strcpy(railwayStations[railwayStationCount].sector, station->sector);
-                
-                // Use collision-free placement (70px radius for railway stations - reduced)
-                if (!findFreePosition(station->sector, 70.0f, railwayStations[railwayStationCount].x, railwayStations[railwayStationCount].y)) {
-                    cityMap.getSectorPosition(station->sector, railwayStations[railwayStationCount].x, railwayStations[railwayStationCount].y);
-                }
-                markPositionOccupied(station->sector, railwayStations[railwayStationCount].x, railwayStations[railwayStationCount].y, 70.0f);
-                railwayStationCount++;
+        railway_sys->forEachStation([&](RailStation& station) {
+            if (railwayStationCount >= 10) return;  // display arrays are fixed size
+            strcpy(railwayStations[railwayStationCount].id, station.stationID);
+            strcpy(railwayStations[railwayStationCount].name, station.name);
+            railwayStations[railwayStationCount].sectorId = station.sectorId;
+            
+            // Use collision-free placement (70px radius for railway stations - reduced)
+            if (!findFreePosition(station.sectorId, 70.0f, railwayStations[railwayStationCount].x, railwayStations[railwayStationCount].y)) {
+                cityMap.getSectorPosition(station.sectorId, railwayStations[railwayStationCount].x, railwayStations[railwayStationCount].y);
             }
-        }
+            markPositionOccupied(station.sectorId, railwayStations[railwayStationCount].x, railwayStations[railwayStationCount].y, 70.0f);
+            railwayStationCount++;
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d railway stations\n", railwayStationCount);
         for (int i = 0; i < railwayStationCount; i++) {
-            printf("  Railway %s at (%.1f, %.1f) sector=%s\n", railwayStations[i].id, railwayStations[i].x, railwayStations[i].y, railwayStations[i].sector);
+            printf("  Railway %s at (%.1f, %.1f) sector=%s\n", railwayStations[i].id, railwayStations[i].x, railwayStations[i].y, sectorName(railwayStations[i].sectorId));
         }
     }
     
@@ -1632,47 +1479,53 @@ public:
         if (!transport) return;
         busCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        transport->getBusKeys(keys, &count);
-        
-        for (int i = 0; i < count && busCount < 10; i++) {
-            Bus* bus = transport->getBus(keys[i]);
-            if (bus) {
-                strcpy(buses[busCount].id, bus->busNo);
-                strcpy(buses[busCount].name, bus->company);
-                strcpy(buses[busCount].currentStop, bus->currentStop);
-                
-                // Position bus at its current stop (with offset)
-                bool positioned = false;
-                for (int j = 0; j < stopCount; j++) {
-                    if (strcmp(stops[j].id, bus->currentStop) == 0) {
-                        // Use collision-free placement (40px radius for buses)
-                        if (findFreePosition(stops[j].sector, 40.0f, buses[busCount].x, buses[busCount].y)) {
-                            markPositionOccupied(stops[j].sector, buses[busCount].x, buses[busCount].y, 40.0f);
-                            // Store stop index directly for animation (don't rely on distance check)
-                            buses[busCount].currentStopIdx = j;
-                            busCount++;
-                            positioned = true;
-                        }
+        transport->forEachBus([&](Bus& bus) {
+            if (busCount >= 10) return;  // display arrays are fixed size
+            
+            // Route: translate stop graph indices into indices of stops[] once
+            buses[busCount].path.clear();
+            for (int r = 0; r < bus.route.getLength(); r++) {
+                const char* routeStop = transport->getStopName(bus.route.stopAt(r));
+                for (int j = 0; routeStop != nullptr && j < stopCount; j++) {
+                    if (strcmp(stops[j].id, routeStop) == 0) {
+                        buses[busCount].path.append(j);
                         break;
                     }
                 }
-                
-                // Fallback if stop not found or placement failed
-                if (!positioned) {
-                    buses[busCount].x = 100;
-                    buses[busCount].y = 100;
-                    buses[busCount].currentStopIdx = -1;  // No valid stop
-                    // If fallback, still increment busCount if not already incremented by findFreePosition
-                    if (busCount < 10) { // Ensure we don't exceed array bounds
+            }
+            
+            strcpy(buses[busCount].id, bus.busNo);
+            strcpy(buses[busCount].name, bus.company);
+            strcpy(buses[busCount].currentStop, bus.currentStop);
+            
+            // Position bus at its current stop (with offset)
+            bool positioned = false;
+            for (int j = 0; j < stopCount; j++) {
+                if (strcmp(stops[j].id, bus.currentStop) == 0) {
+                    // Use collision-free placement (40px radius for buses)
+                    if (findFreePosition(stops[j].sectorId, 40.0f, buses[busCount].x, buses[busCount].y)) {
+                        markPositionOccupied(stops[j].sectorId, buses[busCount].x, buses[busCount].y, 40.0f);
+                        // Store stop index directly for animation (don't rely on distance check)
+                        buses[busCount].currentStopIdx = j;
                         busCount++;
+                        positioned = true;
                     }
+                    break;
                 }
             }
-        }
+            
+            // Fallback if stop not found or placement failed
+            if (!positioned) {
+                buses[busCount].x = 100;
+                buses[busCount].y = 100;
+                buses[busCount].currentStopIdx = -1;  // No valid stop
+                // If fallback, still increment busCount if not already incremented by findFreePosition
+                if (busCount < 10) { // Ensure we don't exceed array bounds
+                    busCount++;
+                }
+            }
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d buses\n", busCount);
     }
     
@@ -1681,32 +1534,25 @@ public:
         if (!railway_sys) return;
         trainCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        railway_sys->getTrainKeys(keys, &count);
-        
-        for (int i = 0; i < count && trainCount < 20; i++) {
-            Train* train = railway_sys->getTrain(keys[i]);
-            if (train) {
-                strcpy(trains[trainCount].id, train->trainNo);
-                strcpy(trains[trainCount].name, train->name);
-                strcpy(trains[trainCount].currentStation, train->currentLocation);
-                
-                // Position near current station with collision-free placement
-                for (int j = 0; j < railwayStationCount; j++) {
-                    if (strcmp(railwayStations[j].id, train->currentLocation) == 0) {
-                        // Use collision-free placement (40px radius for trains)
-                        if (findFreePosition(railwayStations[j].sector, 40.0f, trains[trainCount].x, trains[trainCount].y)) {
-                            markPositionOccupied(railwayStations[j].sector, trains[trainCount].x, trains[trainCount].y, 40.0f);
-                            trainCount++;
-                        }
-                        break;
+        railway_sys->forEachTrain([&](Train& train) {
+            if (trainCount >= 20) return;  // display arrays are fixed size
+            strcpy(trains[trainCount].id, train.trainNo);
+            strcpy(trains[trainCount].name, train.name);
+            strcpy(trains[trainCount].currentStation, train.currentLocation);
+            
+            // Position near current station with collision-free placement
+            for (int j = 0; j < railwayStationCount; j++) {
+                if (strcmp(railwayStations[j].id, train.currentLocation) == 0) {
+                    // Use collision-free placement (40px radius for trains)
+                    if (findFreePosition(railwayStations[j].sectorId, 40.0f, trains[trainCount].x, trains[trainCount].y)) {
+                        markPositionOccupied(railwayStations[j].sectorId, trains[trainCount].x, trains[trainCount].y, 40.0f);
+                        trainCount++;
                     }
+                    break;
                 }
             }
-        }
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d trains\n", trainCount);
     }
     
@@ -1715,32 +1561,25 @@ public:
         if (!airports_sys) return;
         flightCount = 0;
         
-        char** keys = new char*[20];
-        int count = 0;
-        airports_sys->getFlightKeys(keys, &count);
-        
-        for (int i = 0; i < count && flightCount < 20; i++) {
-            Flight* flight = airports_sys->getFlight(keys[i]);
-            if (flight) {
-                strcpy(flights[flightCount].id, flight->flightNo);
-                strcpy(flights[flightCount].airline, flight->airline);
-                strcpy(flights[flightCount].currentAirport, flight->currentLocation);
-                
-                // Position at current airport with collision-free placement
-                for (int j = 0; j < airportCount; j++) {
-                    if (strcmp(airports[j].id, flight->currentLocation) == 0) {
-                        // Use collision-free placement (35px radius for flights)
-                        if (findFreePosition(airports[j].sector, 35.0f, flights[flightCount].x, flights[flightCount].y)) {
-                            markPositionOccupied(airports[j].sector, flights[flightCount].x, flights[flightCount].y, 35.0f);
-                            flightCount++;
-                        }
-                        break;
+        airports_sys->forEachFlight([&](Flight& flight) {
+            if (flightCount >= 20) return;  // display arrays are fixed size
+            strcpy(flights[flightCount].id, flight.flightNo);
+            strcpy(flights[flightCount].airline, flight.airline);
+            strcpy(flights[flightCount].currentAirport, flight.currentLocation);
+            
+            // Position at current airport with collision-free placement
+            for (int j = 0; j < airportCount; j++) {
+                if (strcmp(airports[j].id, flight.currentLocation) == 0) {
+                    // Use collision-free placement (35px radius for flights)
+                    if (findFreePosition(airports[j].sectorId, 35.0f, flights[flightCount].x, flights[flightCount].y)) {
+                        markPositionOccupied(airports[j].sectorId, flights[flightCount].x, flights[flightCount].y, 35.0f);
+                        flightCount++;
                     }
+                    break;
                 }
             }
-        }
+        });
         
-        delete[] keys;
         printf("[OK] Loaded %d flights\n", flightCount);
     }
     
@@ -1845,7 +1684,7 @@ public:
     void calculateSectorSizes() {
         // Use sectorGrids to count entities per sector
         for (int i = 0; i < sectorGridCount; i++) {
-            cityMap.setSectorEntityCount(sectorGrids[i].sectorName, sectorGrids[i].count);
+            cityMap.setSectorEntityCount(sectorGrids[i].sectorId, sectorGrids[i].count);
         }
         printf("[OK] Calculated sector sizes based on entity counts\n");
     }
@@ -1862,7 +1701,7 @@ public:
 
             // Helper lambda to place bad items safely
             // Returns true if placement succeeded, false if resizing is needed
-            auto placeEntity = [&](const char* sector, float radius, float* x, float* y) -> bool {
+            auto placeEntity = [&](SectorId sector, float radius, float* x, float* y) -> bool {
                 if (findFreePosition(sector, radius, *x, *y)) {
                      markPositionOccupied(sector, *x, *y, radius);
                      return true;
@@ -1870,7 +1709,7 @@ public:
                     // Placement failed!
                     // If we haven't hit max retries, request expansion
                     if (resizeAttempts < MAX_RESIZE_ATTEMPTS) {
-                        printf("[INFO] Expansion trigger for %s due to fit failure.\n", sector);
+                        printf("[INFO] Expansion trigger for %s due to fit failure.\n", sectorName(sector));
                         cityMap.expandSectorBounds(sector, 200.0f); // Add chunk of space
                         cityMap.recalculateGridPositions(); // Recalc grid layout
                         return false; // Signal to restart loop
@@ -1885,7 +1724,7 @@ public:
 
             // Re-place stops
             for (int i = 0; i < stopCount; i++) {
-                if (!placeEntity(stops[i].sector, 60.0f, &stops[i].x, &stops[i].y)) {
+                if (!placeEntity(stops[i].sectorId, 60.0f, &stops[i].x, &stops[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1893,7 +1732,7 @@ public:
 
             // Re-place hospitals
             for (int i = 0; i < hospitalCount; i++) {
-                if (!placeEntity(hospitals[i].sector, 60.0f, &hospitals[i].x, &hospitals[i].y)) {
+                if (!placeEntity(hospitals[i].sectorId, 60.0f, &hospitals[i].x, &hospitals[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1901,7 +1740,7 @@ public:
 
             // Re-place schools
             for (int i = 0; i < schoolCount; i++) {
-                if (!placeEntity(schools[i].sector, 50.0f, &schools[i].x, &schools[i].y)) {
+                if (!placeEntity(schools[i].sectorId, 50.0f, &schools[i].x, &schools[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1909,7 +1748,7 @@ public:
 
             // Re-place pharmacies
             for (int i = 0; i < pharmacyCount; i++) {
-                if (!placeEntity(pharmacies[i].sector, 50.0f, &pharmacies[i].x, &pharmacies[i].y)) {
+                if (!placeEntity(pharmacies[i].sectorId, 50.0f, &pharmacies[i].x, &pharmacies[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1917,7 +1756,7 @@ public:
 
             // Re-place malls
             for (int i = 0; i < mallCount; i++) {
-                if (!placeEntity(malls[i].sector, 60.0f, &malls[i].x, &malls[i].y)) {
+                if (!placeEntity(malls[i].sectorId, 60.0f, &malls[i].x, &malls[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1925,7 +1764,7 @@ public:
 
             // Re-place parks
             for (int i = 0; i < parkCount; i++) {
-                if (!placeEntity(parks[i].sector, 90.0f, &parks[i].x, &parks[i].y)) {
+                if (!placeEntity(parks[i].sectorId, 90.0f, &parks[i].x, &parks[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1933,7 +1772,7 @@ public:
 
             // Re-place mosques
             for (int i = 0; i < mosqueCount; i++) {
-                if (!placeEntity(mosques[i].sector, 40.0f, &mosques[i].x, &mosques[i].y)) {
+                if (!placeEntity(mosques[i].sectorId, 40.0f, &mosques[i].x, &mosques[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1941,7 +1780,7 @@ public:
 
             // Re-place airports
             for (int i = 0; i < airportCount; i++) {
-                if (!placeEntity(airports[i].sector, 80.0f, &airports[i].x, &airports[i].y)) {
+                if (!placeEntity(airports[i].sectorId, 80.0f, &airports[i].x, &airports[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1949,7 +1788,7 @@ public:
 
             // Re-place railway stations
             for (int i = 0; i < railwayStationCount; i++) {
-                if (!placeEntity(railwayStations[i].sector, 60.0f, &railwayStations[i].x, &railwayStations[i].y)) {
+                if (!placeEntity(railwayStations[i].sectorId, 60.0f, &railwayStations[i].x, &railwayStations[i].y)) {
                     needsResizing = true; break;
                 }
             }
@@ -1960,12 +1799,12 @@ public:
             for (int i = 0; i < busCount; i++) {
                 for (int j = 0; j < stopCount; j++) {
                     if (strcmp(stops[j].id, buses[i].currentStop) == 0) {
-                        if (findFreePosition(stops[j].sector, 40.0f, buses[i].x, buses[i].y)) {
-                            markPositionOccupied(stops[j].sector, buses[i].x, buses[i].y, 40.0f);
+                        if (findFreePosition(stops[j].sectorId, 40.0f, buses[i].x, buses[i].y)) {
+                            markPositionOccupied(stops[j].sectorId, buses[i].x, buses[i].y, 40.0f);
                             buses[i].currentStopIdx = j;
                         } else {
                             // Vehicles just force-place, they don't expand sectors
-                             markPositionOccupied(stops[j].sector, buses[i].x, buses[i].y, 40.0f);
+                             markPositionOccupied(stops[j].sectorId, buses[i].x, buses[i].y, 40.0f);
                         }
                         break;
                     }
@@ -1976,11 +1815,11 @@ public:
             for (int i = 0; i < trainCount; i++) {
                 for (int j = 0; j < railwayStationCount; j++) {
                     if (strcmp(railwayStations[j].id, trains[i].currentStation) == 0) {
-                        if (findFreePosition(railwayStations[j].sector, 50.0f, trains[i].x, trains[i].y)) {
-                            markPositionOccupied(railwayStations[j].sector, trains[i].x, trains[i].y, 50.0f);
+                        if (findFreePosition(railwayStations[j].sectorId, 50.0f, trains[i].x, trains[i].y)) {
+                            markPositionOccupied(railwayStations[j].sectorId, trains[i].x, trains[i].y, 50.0f);
                             trains[i].currentStationIdx = j;
                         } else {
-                            markPositionOccupied(railwayStations[j].sector, trains[i].x, trains[i].y, 50.0f);
+                            markPositionOccupied(railwayStations[j].sectorId, trains[i].x, trains[i].y, 50.0f);
                         }
                         break;
                     }
@@ -1991,8 +1830,8 @@ public:
             for (int i = 0; i < flightCount; i++) {
                 for (int j = 0; j < airportCount; j++) {
                     if (strcmp(airports[j].id, flights[i].currentAirport) == 0) {
-                        if (findFreePosition(airports[j].sector, 35.0f, flights[i].x, flights[i].y)) {
-                            markPositionOccupied(airports[j].sector, flights[i].x, flights[i].y, 35.0f);
+                        if (findFreePosition(airports[j].sectorId, 35.0f, flights[i].x, flights[i].y)) {
+                            markPositionOccupied(airports[j].sectorId, flights[i].x, flights[i].y, 35.0f);
                             flights[i].currentAirportIdx = j;
                             flights[i].animX = flights[i].x;
                             flights[i].animY = flights[i].y;
@@ -2001,7 +1840,7 @@ public:
                             flights[i].progress = 1.0f;
                             flights[i].isMoving = false;
                         } else {
-                            markPositionOccupied(airports[j].sector, flights[i].x, flights[i].y, 35.0f);
+                            markPositionOccupied(airports[j].sectorId, flights[i].x, flights[i].y, 35.0f);
                         }
                         break;
                     }
@@ -2136,6 +1975,12 @@ public:
                 if (key->scancode == sf::Keyboard::Scancode::Semicolon) showDecorations = !showDecorations;
                 if (key->scancode == sf::Keyboard::Scancode::I) showInstructions = !showInstructions;
                 
+                // Critical stops overlay (betweenness centrality)
+                if (key->scancode == sf::Keyboard::Scancode::C) {
+                    showCentrality = !showCentrality;
+                    printf("[INFO] Critical stops overlay: %s\n", showCentrality ? "ON" : "OFF");
+                }
+                
                 // Pathfinding mode toggle - cycles: Off → Buses → Airports → Railways → Off
                 if (key->scancode == sf::Keyboard::Scancode::P) {
                     if (!pathfindingMode) {
@@ -2470,6 +2315,7 @@ public:
                         pathSourceStop = i;
                         pathDestStop = -1;
                         pathStopCount = 0;
+                        altPathTotal = 0;
                         pathFound = false;
                     } else if (pathDestStop < 0 && i != pathSourceStop) {
                         // Second click - select destination and calculate
@@ -2480,6 +2326,7 @@ public:
                         pathSourceStop = i;
                         pathDestStop = -1;
                         pathStopCount = 0;
+                        altPathTotal = 0;
                         pathFound = false;
                     }
                     return;
@@ -2684,6 +2531,106 @@ public:
         va.append(sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(0.f, h)));
     }
 
+    // Halo sized by a stop's share of shortest paths, relative to the busiest one
+    void drawCentralityHalo(float x, float y, double share, double maxShare, sf::Color color) {
+        if (share <= 0 || maxShare <= 0) return;
+        float radius = 20.0f + 60.0f * (float)(share / maxShare);
+        sf::CircleShape halo(radius);
+        halo.setOrigin(sf::Vector2f(radius, radius));
+        halo.setPosition(sf::Vector2f(x, y));
+        halo.setFillColor(sf::Color(color.r, color.g, color.b, 70));
+        halo.setOutlineColor(color);
+        halo.setOutlineThickness(2.0f);
+        window.draw(halo);
+    }
+    
+    // Betweenness overlay: the stops / stations most shortest paths run through
+    // (isInView is the render pass's visibility test)
+    template <typename InView>
+    void drawCentralityOverlay(InView isInView) {
+        if (transport) {
+            double shares[sizeof(stops) / sizeof(stops[0])];     // one per display stop
+            double maxShare = 0;
+            for (int i = 0; i < stopCount; i++) {
+                shares[i] = transport->getStopCentrality(stops[i].id);
+                if (shares[i] > maxShare) maxShare = shares[i];
+            }
+            for (int i = 0; i < stopCount; i++) {
+                if (isInView(stops[i].x, stops[i].y)) {
+                    drawCentralityHalo(stops[i].x, stops[i].y, shares[i], maxShare, sf::Color(239, 68, 68));
+                }
+            }
+        }
+        if (railway_sys && showRailways) {
+            double shares[sizeof(railwayStations) / sizeof(railwayStations[0])];
+            double maxShare = 0;
+            for (int i = 0; i < railwayStationCount; i++) {
+                shares[i] = railway_sys->getStationCentrality(railwayStations[i].id);
+                if (shares[i] > maxShare) maxShare = shares[i];
+            }
+            for (int i = 0; i < railwayStationCount; i++) {
+                if (isInView(railwayStations[i].x, railwayStations[i].y)) {
+                    drawCentralityHalo(railwayStations[i].x, railwayStations[i].y, shares[i], maxShare,
+                                       sf::Color(168, 85, 247));
+                }
+            }
+        }
+    }
+    
+    // Draw a route given as entity IDs of the current pathfinding network
+    void drawPathOverlay(char ids[][50], int count, sf::Color color, float thickness) {
+        for (int i = 0; i < count - 1; i++) {
+            int fromIdx = -1, toIdx = -1;
+            
+            // Find entity indices based on network type
+            if (pathfindingNetworkType == 0) {
+                for (int j = 0; j < stopCount; j++) {
+                    if (strcmp(stops[j].id, ids[i]) == 0) fromIdx = j;
+                    if (strcmp(stops[j].id, ids[i + 1]) == 0) toIdx = j;
+                }
+            } else if (pathfindingNetworkType == 1) {
+                for (int j = 0; j < airportCount; j++) {
+                    if (strcmp(airports[j].id, ids[i]) == 0) fromIdx = j;
+                    if (strcmp(airports[j].id, ids[i + 1]) == 0) toIdx = j;
+                }
+            } else {
+                for (int j = 0; j < railwayStationCount; j++) {
+                    if (strcmp(railwayStations[j].id, ids[i]) == 0) fromIdx = j;
+                    if (strcmp(railwayStations[j].id, ids[i + 1]) == 0) toIdx = j;
+                }
+            }
+            
+            if (fromIdx >= 0 && toIdx >= 0) {
+                float x1, y1, x2, y2;
+                if (pathfindingNetworkType == 0) {
+                    x1 = stops[fromIdx].x; y1 = stops[fromIdx].y;
+                    x2 = stops[toIdx].x; y2 = stops[toIdx].y;
+                } else if (pathfindingNetworkType == 1) {
+                    x1 = airports[fromIdx].x; y1 = airports[fromIdx].y;
+                    x2 = airports[toIdx].x; y2 = airports[toIdx].y;
+                } else {
+                    x1 = railwayStations[fromIdx].x; y1 = railwayStations[fromIdx].y;
+                    x2 = railwayStations[toIdx].x; y2 = railwayStations[toIdx].y;
+                }
+                
+                float dx = x2 - x1, dy = y2 - y1;
+                float len = std::sqrt(dx*dx + dy*dy);
+                if (len > 1) {
+                    float nx = -dy / len * thickness / 2;
+                    float ny = dx / len * thickness / 2;
+                    
+                    sf::ConvexShape pathLine(4);
+                    pathLine.setPoint(0, sf::Vector2f(x1 + nx, y1 + ny));
+                    pathLine.setPoint(1, sf::Vector2f(x1 - nx, y1 - ny));
+                    pathLine.setPoint(2, sf::Vector2f(x2 - nx, y2 - ny));
+                    pathLine.setPoint(3, sf::Vector2f(x2 + nx, y2 + ny));
+                    pathLine.setFillColor(color);
+                    window.draw(pathLine);
+                }
+            }
+        }
+    }
+    
     void render() {
         window.clear(sf::Color(25, 30, 35));
         
@@ -2724,61 +2671,12 @@ public:
         
         // ===== PATHFINDING PATH RENDERING =====
         if (pathfindingMode && pathFound && pathStopCount > 1) {
-            // Use bright green for ALL highlighted paths (buses, airports, railways)
-            sf::Color pathColor = sf::Color(50, 255, 100, 220);
-            
-            // Draw the calculated path
-            for (int i = 0; i < pathStopCount - 1; i++) {
-                int fromIdx = -1, toIdx = -1;
-                
-                // Find entity indices based on network type
-                if (pathfindingNetworkType == 0) {
-                    for (int j = 0; j < stopCount; j++) {
-                        if (strcmp(stops[j].id, pathStopIds[i]) == 0) fromIdx = j;
-                        if (strcmp(stops[j].id, pathStopIds[i + 1]) == 0) toIdx = j;
-                    }
-                } else if (pathfindingNetworkType == 1) {
-                    for (int j = 0; j < airportCount; j++) {
-                        if (strcmp(airports[j].id, pathStopIds[i]) == 0) fromIdx = j;
-                        if (strcmp(airports[j].id, pathStopIds[i + 1]) == 0) toIdx = j;
-                    }
-                } else {
-                    for (int j = 0; j < railwayStationCount; j++) {
-                        if (strcmp(railwayStations[j].id, pathStopIds[i]) == 0) fromIdx = j;
-                        if (strcmp(railwayStations[j].id, pathStopIds[i + 1]) == 0) toIdx = j;
-                    }
-                }
-                
-                if (fromIdx >= 0 && toIdx >= 0) {
-                    float x1, y1, x2, y2;
-                    if (pathfindingNetworkType == 0) {
-                        x1 = stops[fromIdx].x; y1 = stops[fromIdx].y;
-                        x2 = stops[toIdx].x; y2 = stops[toIdx].y;
-                    } else if (pathfindingNetworkType == 1) {
-                        x1 = airports[fromIdx].x; y1 = airports[fromIdx].y;
-                        x2 = airports[toIdx].x; y2 = airports[toIdx].y;
-                    } else {
-                        x1 = railwayStations[fromIdx].x; y1 = railwayStations[fromIdx].y;
-                        x2 = railwayStations[toIdx].x; y2 = railwayStations[toIdx].y;
-                    }
-                    
-                    float dx = x2 - x1, dy = y2 - y1;
-                    float len = std::sqrt(dx*dx + dy*dy);
-                    if (len > 1) {
-                        float thickness = 10.0f;
-                        float nx = -dy / len * thickness / 2;
-                        float ny = dx / len * thickness / 2;
-                        
-                        sf::ConvexShape pathLine(4);
-                        pathLine.setPoint(0, sf::Vector2f(x1 + nx, y1 + ny));
-                        pathLine.setPoint(1, sf::Vector2f(x1 - nx, y1 - ny));
-                        pathLine.setPoint(2, sf::Vector2f(x2 - nx, y2 - ny));
-                        pathLine.setPoint(3, sf::Vector2f(x2 + nx, y2 + ny));
-                        pathLine.setFillColor(pathColor);
-                        window.draw(pathLine);
-                    }
-                }
+            // Alternates first (thinner, amber) so the main route stays on top
+            for (int a = altPathTotal - 1; a >= 0; a--) {
+                drawPathOverlay(altPathIds[a], altPathCounts[a], sf::Color(255, 170, 40, 150), 6.0f);
             }
+            // Use bright green for ALL highlighted paths (buses, airports, railways)
+            drawPathOverlay(pathStopIds, pathStopCount, sf::Color(50, 255, 100, 220), 10.0f);
         }
         
         // Draw source/destination markers for pathfinding
@@ -3045,6 +2943,11 @@ public:
             }
         }
         
+        // Critical stops overlay, under the stop sprites
+        if (showCentrality) {
+            drawCentralityOverlay(isInView);
+        }
+        
         // 14. Bus stops (drawn last for visibility)
         for (int i = 0; i < stopCount; i++) {
             if (isInView(stops[i].x, stops[i].y)) {
@@ -3186,7 +3089,7 @@ public:
         float panelY = 200.0f;
         
         if (showInstructions) {
-            sf::RectangleShape instrPanel(sf::Vector2f(230, 520));
+            sf::RectangleShape instrPanel(sf::Vector2f(230, 538));
             instrPanel.setPosition(sf::Vector2f(10, panelY));
             instrPanel.setFillColor(sf::Color(35, 45, 55, 250));
             instrPanel.setOutlineColor(sf::Color(100, 150, 200));
@@ -3224,11 +3127,12 @@ public:
                 "",
                 "1 - Cycle connection lines",
                 "P - Pathfinding mode",
+                "C - Critical stops overlay",
                 "I - Toggle this panel"
             };
             
             float lineY = panelY + 35;
-            for (int i = 0; i < 24; i++) {
+            for (int i = 0; i < 25; i++) {
                 sf::Color textColor = (i == 0 || i == 7 || i == 21) ? sf::Color(150, 200, 255) : sf::Color(200, 200, 200);
                 int fontSize = (i == 7) ? 13 : 12;
                 sf::Text ctrlText(font, controls[i], fontSize);
@@ -3239,7 +3143,7 @@ public:
                 lineY += (i == 6 || i == 20) ? 8 : 18;
             }
             
-            panelY += 530;
+            panelY += 548;
         }
         
         // ===== PATHFINDING MODE UI =====
@@ -3254,7 +3158,8 @@ public:
             sf::Color panelBg = pathfindingNetworkType == 0 ? sf::Color(40, 60, 50) :
                                 pathfindingNetworkType == 1 ? sf::Color(60, 50, 40) : sf::Color(50, 40, 60);
             
-            sf::RectangleShape pathPanel(sf::Vector2f(230, 130));
+            float pathPanelHeight = altPathTotal > 0 ? 150.0f : 130.0f;
+            sf::RectangleShape pathPanel(sf::Vector2f(230, pathPanelHeight));
             pathPanel.setPosition(sf::Vector2f(10, panelY));
             pathPanel.setFillColor(panelBg);
             pathPanel.setOutlineColor(networkColor);
@@ -3328,12 +3233,28 @@ public:
                 window.draw(distText);
             }
             
+            // Alternates (extra km over the main route)
+            if (pathFound && altPathTotal > 0) {
+                char altStr[80];
+                int written = snprintf(altStr, 80, "Alternates:");
+                for (int a = 0; a < altPathTotal && written < 80; a++) {
+                    written += snprintf(altStr + written, 80 - written, " +%.1f", altPathDistances[a] - pathDistance);
+                }
+                if (written < 80) {
+                    snprintf(altStr + written, 80 - written, " km");
+                }
+                sf::Text altText(font, altStr, 11);
+                altText.setPosition(sf::Vector2f(15, panelY + 112));
+                altText.setFillColor(sf::Color(255, 170, 40));
+                window.draw(altText);
+            }
+            
             sf::Text escHint(font, "[P] change network/exit", 10);
-            escHint.setPosition(sf::Vector2f(15, panelY + 112));
+            escHint.setPosition(sf::Vector2f(15, panelY + pathPanelHeight - 18));
             escHint.setFillColor(sf::Color(120, 120, 120));
             window.draw(escHint);
             
-            panelY += 140;  // Move entity panel below pathfinding panel
+            panelY += pathPanelHeight + 10;  // Move entity panel below pathfinding panel
         }
         
         // Selected entity info - base Y position for all panels
@@ -3363,7 +3284,7 @@ public:
             window.draw(stopId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", stops[selectedStop].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(stops[selectedStop].sectorId));
             sf::Text stopSector(font, sectorStr, 11);
             stopSector.setPosition(sf::Vector2f(15, panelY + 70));
             stopSector.setFillColor(sf::Color(180, 180, 180));
@@ -3393,7 +3314,7 @@ public:
             window.draw(hospId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", hospitals[selectedHospital].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(hospitals[selectedHospital].sectorId));
             sf::Text hospSector(font, sectorStr, 11);
             hospSector.setPosition(sf::Vector2f(15, panelY + 70));
             hospSector.setFillColor(sf::Color(180, 180, 180));
@@ -3423,7 +3344,7 @@ public:
             window.draw(schoolId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", schools[selectedSchool].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(schools[selectedSchool].sectorId));
             sf::Text schoolSector(font, sectorStr, 11);
             schoolSector.setPosition(sf::Vector2f(15, panelY + 70));
             schoolSector.setFillColor(sf::Color(180, 180, 180));
@@ -3453,7 +3374,7 @@ public:
             window.draw(pharmId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", pharmacies[selectedPharmacy].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(pharmacies[selectedPharmacy].sectorId));
             sf::Text pharmSector(font, sectorStr, 11);
             pharmSector.setPosition(sf::Vector2f(15, panelY + 70));
             pharmSector.setFillColor(sf::Color(180, 180, 180));
@@ -3483,7 +3404,7 @@ public:
             window.draw(mallId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", malls[selectedMall].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(malls[selectedMall].sectorId));
             sf::Text mallSector(font, sectorStr, 11);
             mallSector.setPosition(sf::Vector2f(15, panelY + 70));
             mallSector.setFillColor(sf::Color(180, 180, 180));
@@ -3513,7 +3434,7 @@ public:
             window.draw(parkId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", parks[selectedPark].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(parks[selectedPark].sectorId));
             sf::Text parkSector(font, sectorStr, 11);
             parkSector.setPosition(sf::Vector2f(15, panelY + 70));
             parkSector.setFillColor(sf::Color(180, 180, 180));
@@ -3543,7 +3464,7 @@ public:
             window.draw(mosqueId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", mosques[selectedMosque].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(mosques[selectedMosque].sectorId));
             sf::Text mosqueSector(font, sectorStr, 11);
             mosqueSector.setPosition(sf::Vector2f(15, panelY + 70));
             mosqueSector.setFillColor(sf::Color(180, 180, 180));
@@ -3573,7 +3494,7 @@ public:
             window.draw(airportId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", airports[selectedAirport].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(airports[selectedAirport].sectorId));
             sf::Text airportSector(font, sectorStr, 11);
             airportSector.setPosition(sf::Vector2f(15, panelY + 70));
             airportSector.setFillColor(sf::Color(180, 180, 180));
@@ -3608,7 +3529,7 @@ public:
             window.draw(stationId);
             
             char sectorStr[60];
-            snprintf(sectorStr, 60, "Sector: %s", railwayStations[selectedRailwayStation].sector);
+            snprintf(sectorStr, 60, "Sector: %s", sectorName(railwayStations[selectedRailwayStation].sectorId));
             sf::Text stationSector(font, sectorStr, 11);
             stationSector.setPosition(sf::Vector2f(15, panelY + 70));
             stationSector.setFillColor(sf::Color(180, 180, 180));
@@ -24,6 +24,8 @@ PopulationSystem* populationSystem = nullptr;
 #include "include/RailwaySector.h"
 #include "include/CommercialSector.h"
 #include "include/TransportMenus.h"
+#include "include/MultimodalNetwork.h"
+#include "include/TransitRouter.h"
 #include "include/PublicFacilities.h"
 
 // visualization
@@ -35,6 +37,8 @@ MedicalSystem* medicalSystem = nullptr;
 TransportSystem* transportSystem = nullptr;
 AirportSystem* airportSystem = nullptr;
 RailwaySystem* railwaySystem = nullptr;
+MultimodalNetwork* multimodalNetwork = nullptr;
+TransitRouter* transitRouter = nullptr;
 CommercialSystem* commercialSystem = nullptr;
 PublicFacilitySystem* publicFacilities = nullptr;
 
@@ -70,63 +74,38 @@ bool initVisualization() {
 }
 
 // Helper to collect all unique sectors from all data sources
-void collectAllSectorsForDistribution(char** sectors, int* count) {
+void collectAllSectorsForDistribution(SectorId* sectors, int* count) {
     *count = 0;
     
-    // Helper to add sector if unique (case-insensitive, whitespace-trimmed)
-    auto addUnique = [&](const char* sector) {
-        if (sector == nullptr || sector[0] == '\0') return;
-        
-        // Trim whitespace
-        char trimmed[100];
-        int start = 0;
-        while (sector[start] == ' ') start++;
-        
-        int len = strlen(sector + start);
-        while (len > 0 && sector[start + len - 1] == ' ') len--;
-        
-        for (int i = 0; i < len; i++) {
-            trimmed[i] = sector[start + i];
-        }
-        trimmed[len] = '\0';
-        
-        if (trimmed[0] == '\0') return;
-        
-        // Check if unique (case-insensitive)
-        for (int i = 0; i < *count; i++) {
-            if (stringCompare(sectors[i], trimmed) == 0) return;
-        }
-        
+    // sector names were trimmed + case-folded once when interned,
+    // so uniqueness is just one flag per id
+    int idCount = sectorRegistry.getCount();
+    bool* seen = new bool[idCount > 0 ? idCount : 1];
+    for (int i = 0; i < idCount; i++) {
+        seen[i] = false;
+    }
+    
+    auto addUnique = [&](SectorId sector) {
+        if (sector == NO_SECTOR || sector >= idCount || seen[sector]) return;
+        seen[sector] = true;
         if (*count < 50) {
-            int trimmedLen = strlen(trimmed);
-            sectors[*count] = new char[trimmedLen + 1];
-            strcpy(sectors[*count], trimmed);
+            sectors[*count] = sector;
             (*count)++;
         }
     };
     
     // Collect from all hospitals
     if (medicalSystem) {
-        char** keys = new char*[20];
-        int hospCount = 0;
-        medicalSystem->getHospitalKeys(keys, &hospCount);
-        for (int i = 0; i < hospCount; i++) {
-            Hospital* h = medicalSystem->getHospital(keys[i]);
-            if (h) addUnique(h->sector);
-        }
-        delete[] keys;
+        medicalSystem->forEachHospital([&](Hospital& h) {
+            addUnique(h.sectorId);
+        });
     }
     
     // Collect from all schools
     if (educationSystem) {
-        char** keys = new char*[20];
-        int schoolCount = 0;
-        educationSystem->getSchoolKeys(keys, &schoolCount);
-        for (int i = 0; i < schoolCount; i++) {
-            School* s = educationSystem->getSchool(keys[i]);
-            if (s) addUnique(s->sector);
-        }
-        delete[] keys;
+        educationSystem->forEachSchool([&](School& s) {
+            addUnique(s.sectorId);
+        });
     }
     
     // Collect from PopulationSystem
@@ -135,11 +114,13 @@ void collectAllSectorsForDistribution(char** sectors, int* count) {
         int popCount = 0;
         populationSystem->getSectorNames(keys, &popCount);
         for (int i = 0; i < popCount; i++) {
-            addUnique(keys[i]);
+            addUnique(findSector(keys[i]));
             delete[] keys[i];
         }
         delete[] keys;
     }
+    
+    delete[] seen;
 }
 
 // load buses from csv
@@ -196,15 +177,14 @@ void loadStops() {
     file.getline(line, 500);
     
     // Get sectors from ALL data sources (hospitals, schools, population, etc.)
-    char** sectors = new char*[50];
+    SectorId sectors[50];
     int sectorCount = 0;
     collectAllSectorsForDistribution(sectors, &sectorCount);
     
     if (sectorCount == 0) {
         cout << "[WARNING] No sectors found in any system. Using default." << endl;
         sectorCount = 1;
-        sectors[0] = new char[10];
-        strcpy(sectors[0], "G-10");
+        sectors[0] = internSector("G-10");
     }
     
     printf("[OK] Using %d unique sectors for bus stop distribution\n", sectorCount);
@@ -238,18 +218,12 @@ void loadStops() {
             double lon = stringToDouble(lonStr);
             
             // Round-robin across ALL collected sectors
-            const char* assignedSector = sectors[stopIndex % sectorCount];
+            const char* assignedSector = sectorName(sectors[stopIndex % sectorCount]);
             transportSystem->addBusStop(tokens[0], tokens[1], assignedSector, lat, lon);
             stopIndex++;
         }
     }
     
-    // Clean up
-    for (int i = 0; i < sectorCount; i++) {
-        delete[] sectors[i];
-    }
-    delete[] sectors;
-    
     file.close();
     
     transportSystem->connectStops("Stop1", "Stop2", 2.5);
@@ -405,6 +379,13 @@ void busSystemMenu() {
         cout << "  [11] Register School Bus" << endl;
         cout << "  [12] Connect Two Bus Stops (Manual)" << endl;
         cout << "  [13] [DEMO] Simulate Passenger Queue (Boarding)" << endl;
+        cout << "  [14] [DEMO] Event Queue Throughput Benchmark" << endl;
+        cout << "  [15] [DEMO] Route Preprocessing (Contraction Hierarchy)" << endl;
+        cout << "  [16] [DEMO] Parallel Distance Matrix" << endl;
+        cout << "  [17] Update Road Distance / Close Road" << endl;
+        cout << "  [18] Stops Within Distance (Reachability)" << endl;
+        cout << "  [19] [DEMO] City-Wide Shortest Paths (Parallel Delta-Stepping)" << endl;
+        cout << "  [20] [DEMO] Arena Load / Teardown Timing" << endl;
         cout << "  [0] <-- Back to Transport Menu" << endl;
         cout << "+---------------------------------------------+" << endl;
         cout << ">> Stats: " << transportSystem->getBusCount() << " buses, "
@@ -488,9 +469,216 @@ void busSystemMenu() {
             cin >> stopID;
             normalizeInput(stopID);
             transportSystem->simulatePassengerBoarding(stopID);
+        } else if (choice == 14) {
+            transportSystem->benchmarkEventQueues();
+        } else if (choice == 15) {
+            transportSystem->benchmarkRouteHierarchy();
+        } else if (choice == 16) {
+            transportSystem->demoDistanceMatrix();
+        } else if (choice == 17) {
+            transportSystem->updateRoadManual();
+        } else if (choice == 18) {
+            char stopID[50];
+            double budget;
+            int direction;
+            cout << "\n=== Stops Within Distance ===" << endl;
+            cout << ">> Enter stop ID (e.g., stop4): ";
+            cin >> stopID;
+            normalizeInput(stopID);
+            cout << ">> Enter network distance limit (km): ";
+            cin >> budget;
+            cout << ">> [1] Reachable FROM this stop  [2] Can REACH this stop: ";
+            cin >> direction;
+            if (cin.fail() || budget < 0) {
+                cin.clear();
+                cin.ignore(10000, '\n');
+                cout << "[ERROR] Invalid input!" << endl;
+            } else {
+                transportSystem->showStopsWithin(stopID, budget, direction == 2);
+            }
+        } else if (choice == 19) {
+            transportSystem->demoCityWideTree();
+        } else if (choice == 20) {
+            transportSystem->benchmarkArenaReload();
+        } else if (choice != 0) {
+            cout << "[ERROR] Invalid choice!" << endl;
+        }
+    } while (choice != 0);
+}
+
+// Multimodal journey planner (bus, rail and air as one network)
+void journeyPlannerMenu() {
+    int choice = -1;
+    do {
+        cout << "\n+---------------------------------------------+" << endl;
+        cout << "|   JOURNEY PLANNER (BUS + RAIL + AIR)        |" << endl;
+        cout << "+---------------------------------------------+" << endl;
+        cout << "  [1] Plan Journey Between Any Two Places" << endl;
+        cout << "  [2] Add Transfer Link (Walk Between Modes)" << endl;
+        cout << "  [3] Set Mode Cost (min/km, boarding min)" << endl;
+        cout << "  [4] Display Multimodal Network Summary" << endl;
+        cout << "  [5] Timetable Journey (Depart At HH:MM)" << endl;
+        cout << "  [6] Timetable Summary (Routes & Trips)" << endl;
+        cout << "  [0] <-- Back to Transport Menu" << endl;
+        cout << "+---------------------------------------------+" << endl;
+        cout << ">> Your choice: ";
+        cin >> choice;
+        
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            cout << "\n[ERROR] Invalid input! Please enter a number." << endl;
+            choice = -1;
+            continue;
+        }
+        
+        if (choice == 1) {
+            char from[50], to[50];
+            cout << ">> From (stop ID / station ID / airport code, e.g. Stop1, AIR:ISB): ";
+            cin >> from;
+            cout << ">> To: ";
+            cin >> to;
+            multimodalNetwork->planJourney(from, to);
+        } else if (choice == 2) {
+            int fromMode, toMode;
+            char fromId[50], toId[50];
+            double walkKm;
+            cout << ">> Modes: 1 = Bus, 2 = Rail, 3 = Air" << endl;
+            cout << ">> From mode: ";
+            cin >> fromMode;
+            cout << ">> From ID: ";
+            cin >> fromId;
+            normalizeInput(fromId);
+            cout << ">> To mode: ";
+            cin >> toMode;
+            cout << ">> To ID: ";
+            cin >> toId;
+            normalizeInput(toId);
+            cout << ">> Walking distance (km): ";
+            cin >> walkKm;
+            if (!cin.fail() && multimodalNetwork->addTransfer(fromMode - 1, fromId, toMode - 1, toId, walkKm)) {
+                cout << "[OK] Transfer link added!" << endl;
+            }
+        } else if (choice == 3) {
+            int mode;
+            double minutesPerKm, boarding;
+            cout << ">> Mode (1 = Bus, 2 = Rail, 3 = Air): ";
+            cin >> mode;
+            cout << ">> Minutes per km: ";
+            cin >> minutesPerKm;
+            cout << ">> Boarding / waiting minutes: ";
+            cin >> boarding;
+            if (!cin.fail()) {
+                multimodalNetwork->setModeCost(mode - 1, minutesPerKm, boarding);
+            }
+        } else if (choice == 4) {
+            multimodalNetwork->displaySummary();
+        } else if (choice == 5) {
+            char from[50], to[50], departure[20];
+            cout << ">> From (stop ID / station ID / airport code, e.g. Stop1, AIR:ISB): ";
+            cin >> from;
+            cout << ">> To: ";
+            cin >> to;
+            cout << ">> Departure time (HH:MM): ";
+            cin >> departure;
+            transitRouter->planJourney(from, to, departure);
+        } else if (choice == 6) {
+            transitRouter->displaySummary();
+        } else if (choice != 0) {
+            cout << "[ERROR] Invalid choice!" << endl;
+        }
+        
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            cout << "\n[ERROR] Invalid input!" << endl;
+            choice = -1;
+        }
+    } while (choice != 0);
+}
+
+// Emergency vehicle menu (priority dispatch over the bus stop network)
+void emergencyMenu() {
+    int choice = -1;
+    do {
+        cout << "\n+---------------------------------------------+" << endl;
+        cout << "|   EMERGENCY VEHICLES                        |" << endl;
+        cout << "+---------------------------------------------+" << endl;
+        cout << "  [1] Register Emergency Vehicle" << endl;
+        cout << "  [2] Dispatch Vehicle to Stop" << endl;
+        cout << "  [3] Show Active Emergencies" << endl;
+        cout << "  [4] Complete Emergency" << endl;
+        cout << "  [5] Dispatch Nearest Idle Vehicle by Type" << endl;
+        cout << "  [6] [DEMO] Nearest Dispatch vs Fleet Size" << endl;
+        cout << "  [0] <-- Back to Transport Menu" << endl;
+        cout << "+---------------------------------------------+" << endl;
+        cout << ">> Your choice: ";
+        cin >> choice;
+        
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            cout << "\n[ERROR] Invalid input! Please enter a number." << endl;
+            choice = -1;
+            continue;
+        }
+        
+        if (choice == 1) {
+            char vehicleID[20], type[50], location[50];
+            int priority;
+            cout << ">> Vehicle ID: ";
+            cin >> vehicleID;
+            cout << ">> Type (Ambulance / FireTruck / Police): ";
+            cin >> type;
+            cout << ">> Current stop (e.g., stop1): ";
+            cin >> location;
+            normalizeInput(location);
+            cout << ">> Priority (1-10, 10 is highest): ";
+            cin >> priority;
+            if (!cin.fail() && (priority < 1 || priority > 10)) {
+                cout << "[ERROR] Priority must be between 1 and 10!" << endl;
+            } else if (!cin.fail()) {
+                transportSystem->registerEmergencyVehicle(vehicleID, type, location, priority);
+            }
+        } else if (choice == 2) {
+            char vehicleID[20], destination[50];
+            cout << ">> Vehicle ID: ";
+            cin >> vehicleID;
+            cout << ">> Destination stop (e.g., stop4): ";
+            cin >> destination;
+            normalizeInput(destination);
+            transportSystem->dispatchEmergency(vehicleID, destination);
+        } else if (choice == 3) {
+            transportSystem->showActiveEmergencies();
+        } else if (choice == 4) {
+            char vehicleID[20];
+            cout << ">> Vehicle ID: ";
+            cin >> vehicleID;
+            if (transportSystem->completeEmergency(vehicleID)) {
+                cout << "[OK] Emergency closed, " << vehicleID << " is idle again." << endl;
+            } else {
+                cout << "[ERROR] " << vehicleID << " is not on an active emergency!" << endl;
+            }
+        } else if (choice == 5) {
+            char type[50], destination[50];
+            cout << ">> Vehicle type (e.g., Ambulance): ";
+            cin >> type;
+            cout << ">> Destination stop (e.g., stop4): ";
+            cin >> destination;
+            normalizeInput(destination);
+            transportSystem->dispatchNearest(type, destination);
+        } else if (choice == 6) {
+            transportSystem->benchmarkDispatchNearest();
         } else if (choice != 0) {
             cout << "[ERROR] Invalid choice!" << endl;
         }
+        
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            cout << "\n[ERROR] Invalid input!" << endl;
+            choice = -1;
+        }
     } while (choice != 0);
 }
 
@@ -506,6 +694,8 @@ void transportMenu() {
         cout << "  [1] Bus System        (Stops, Routes, Schedules)       " << endl;
         cout << "  [2] Airport System    (Airports, Flights)              " << endl;
         cout << "  [3] Railway System    (Stations, Trains)               " << endl;
+        cout << "  [4] Journey Planner   (Bus + Rail + Air in one route)  " << endl;
+        cout << "  [5] Emergency Vehicles (Register, Dispatch, Complete)  " << endl;
         cout << "  [0] <-- Back to Main Menu                              " << endl;
         cout << "+========================================================+" << endl;
         cout << ">> Your choice: ";
@@ -524,6 +714,10 @@ void transportMenu() {
             airportMenu();
         } else if (choice == 3) {
             railwayMenu();
+        } else if (choice == 4) {
+            journeyPlannerMenu();
+        } else if (choice == 5) {
+            emergencyMenu();
         } else if (choice != 0) {
             cout << "[ERROR] Invalid choice!" << endl;
         }
@@ -652,6 +846,7 @@ void medicalMenu() {
         cout << "  [15] Register Doctor" << endl;
         cout << "  [16] Display All Doctors" << endl;
         cout << "  [17] Display All Patients" << endl;
+        cout << "  [18] Update Hospital Emergency Beds" << endl;
         cout << "  [0] <-- Back to Main Menu" << endl;
         cout << "+--------------------------------------------+" << endl;
         cout << ">> Stats: " << medicalSystem->getHospitalCount() << " hospitals, "
@@ -719,6 +914,8 @@ void medicalMenu() {
             medicalSystem->displayAllDoctors();
         } else if (choice == 17) {
             medicalSystem->displayAllPatients();
+        } else if (choice == 18) {
+            medicalSystem->updateHospitalBedsManual();
         } else if (choice != 0) {
             cout << "[ERROR] Invalid choice!" << endl;
         }
@@ -937,6 +1134,8 @@ int main() {
     transportSystem = new TransportSystem();
     airportSystem = new AirportSystem();
     railwaySystem = new RailwaySystem();
+    multimodalNetwork = new MultimodalNetwork(transportSystem, railwaySystem, airportSystem);
+    transitRouter = new TransitRouter(multimodalNetwork, transportSystem, railwaySystem, airportSystem);
     medicalSystem = new MedicalSystem();
     commercialSystem = new CommercialSystem();
     publicFacilities = new PublicFacilitySystem();
@@ -1032,6 +1231,8 @@ int main() {
     
     // cleanup
     if (viz != nullptr) delete viz;
+    delete transitRouter;       // reads the network and the three transport systems
+    delete multimodalNetwork;   // reads the three transport systems, so it goes first
     delete transportSystem;
     delete educationSystem;
     delete medicalSystem;